@@ -5,7 +5,6 @@
 #include <array>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -125,6 +124,7 @@ class advanced_inventory_pane
         /** Only add offset to index, but wrap around! */
         void mod_index( int offset );
 
-        mutable std::map<std::string, std::function<bool( const item & )>> filtercache;
+        /** Built from @ref filter when it is first needed. */
+        mutable std::function<bool( const item & )> filter_fn;
 };
 #endif // CATA_SRC_ADVANCED_INV_PANE_H
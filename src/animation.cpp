@@ -18,6 +18,7 @@
 #include "output.h"
 #include "point.h"
 #include "popup.h"
+#include "session_replay.h"
 #include "translations.h"
 #include "type_id.h"
 #include "ui_manager.h"
@@ -51,8 +52,10 @@ namespace
 class basic_animation
 {
     public:
+        // Replays run without waiting for animations
         explicit basic_animation( const int scale ) :
-            delay( get_option<int>( "ANIMATION_DELAY" ) * scale * 1'000'000L ) {
+            delay( session_replay::is_replaying() ? 0 :
+                   get_option<int>( "ANIMATION_DELAY" ) * scale * 1'000'000L ) {
         }
 
         void draw() const {
@@ -546,10 +549,13 @@ void hit_animation( const avatar &u, const tripoint &center, nc_color cColor,
         g->add_draw_callback( hit_cb );
 
         ui_manager::redraw();
-        inp_mngr.set_timeout( get_option<int>( "ANIMATION_DELAY" ) );
-        // Skip input (if any), because holding down a key with sleep_for can get yourself killed
-        inp_mngr.get_input_event();
-        inp_mngr.reset_timeout();
+        // A replay must neither wait nor read live input here
+        if( !session_replay::is_replaying() ) {
+            inp_mngr.set_timeout( get_option<int>( "ANIMATION_DELAY" ) );
+            // Skip input (if any), because holding down a key with sleep_for can get yourself killed
+            inp_mngr.get_input_event();
+            inp_mngr.reset_timeout();
+        }
     }
 }
 
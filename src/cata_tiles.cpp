@@ -4,20 +4,29 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <iterator>
 #include <optional>
 #include <set>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <unordered_set>
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#include "mingw.thread.h"
+#endif
+
 #include "action.h"
 #include "avatar.h"
 #include "cached_options.h"
 #include "calendar.h"
 #include "cata_assert.h"
+#include "cata_scope_helpers.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "character.h"
@@ -33,6 +42,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_constants.h"
+#include "init.h"
 #include "int_id.h"
 #include "item.h"
 #include "item_factory.h"
@@ -52,6 +62,7 @@
 #include "overlay_ordering.h"
 #include "path_info.h"
 #include "pixel_minimap.h"
+#include "profiler.h"
 #include "rect_range.h"
 #include "scent_map.h"
 #include "sdl_utils.h"
@@ -239,6 +250,8 @@ void cata_tiles::on_options_changed()
     settings.scale_to_fit = get_option<bool>( "PIXEL_MINIMAP_SCALE_TO_FIT" );
 
     minimap->set_settings( settings );
+    batch_sprites = get_option<bool>( "BATCH_SPRITES" );
+    invalidate_render_list();
 }
 
 void tileset::clear()
@@ -257,6 +270,27 @@ void tileset::clear()
     field_layer_data.clear();
 }
 
+void tile_lookup_table::clear()
+{
+    handles.clear();
+    tiles.clear();
+}
+
+tile_lookup_table::handle tile_lookup_table::add( const std::string &id )
+{
+    const auto inserted = handles.emplace( id, static_cast<handle>( tiles.size() ) );
+    if( inserted.second ) {
+        tiles.emplace_back();
+    }
+    return inserted.first->second;
+}
+
+tile_lookup_table::handle tile_lookup_table::find( const std::string &id ) const
+{
+    const auto iter = handles.find( id );
+    return iter != handles.end() ? iter->second : no_handle;
+}
+
 const tile_type *tileset::find_tile_type( const std::string &id ) const
 {
     const auto iter = tile_ids.find( id );
@@ -324,6 +358,8 @@ void cata_tiles::load_tileset( const std::string &tileset_id, const bool prechec
                                const bool force, const bool pump_events )
 {
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
+        // The game data may have changed since, like when loading another world.
+        resolve_tile_lookups();
         return;
     }
     // TODO: move into clear or somewhere else.
@@ -333,6 +369,47 @@ void cata_tiles::load_tileset( const std::string &tileset_id, const bool prechec
     tileset_ptr = cache.load_tileset( tileset_id, renderer, precheck, force, pump_events );
 
     set_draw_scale( 16 );
+    resolve_tile_lookups();
+}
+
+void cata_tiles::resolve_tile_lookups()
+{
+    CATA_PROFILE_ZONE( "cata_tiles::resolve_tile_lookups" );
+    for( tile_lookup_table &table : tile_lookups ) {
+        table.clear();
+    }
+    if( !tileset_ptr || !DynamicDataLoader::get_instance().is_data_finalized() ) {
+        return;
+    }
+    const auto resolve = [this]( const TILE_CATEGORY category, const std::string & id ) {
+        tile_lookup_table &table = tile_lookups[static_cast<size_t>( category )];
+        const tile_lookup_table::handle h = table.add( id );
+        for( int i = 0; i < NUM_SEASONS; i++ ) {
+            const season_type season = static_cast<season_type>( i );
+            table.set( h, season, find_tile_looks_like_in_season( id, category, "", season,
+                       max_looks_like_jumps ) );
+        }
+    };
+    // The handles of these are their int ids, see draw_from_resolved_id.
+    for( size_t i = 0; i < ter_t::count(); i++ ) {
+        resolve( TILE_CATEGORY::TERRAIN, ter_id( i ).id().str() );
+    }
+    for( size_t i = 0; i < furn_t::count(); i++ ) {
+        resolve( TILE_CATEGORY::FURNITURE, furn_id( i ).id().str() );
+    }
+    for( size_t i = 0; i < field_type::count(); i++ ) {
+        resolve( TILE_CATEGORY::FIELD, field_type_id( i ).id().str() );
+    }
+    for( const mtype &mt : MonsterGenerator::generator().get_all_mtypes() ) {
+        resolve( TILE_CATEGORY::MONSTER, mt.id.str() );
+    }
+    for( const itype *it : item_controller->all() ) {
+        resolve( TILE_CATEGORY::ITEM, it->get_id().str() );
+    }
+    for( const std::pair<const vpart_id, vpart_info> &vp : vpart_info::all() ) {
+        // vehicle parts start with vp_ for their tiles, but not their IDs
+        resolve( TILE_CATEGORY::VEHICLE_PART, "vp_" + vp.first.str() );
+    }
 }
 
 void cata_tiles::reinit()
@@ -390,31 +467,107 @@ static void get_tile_information( const cata_path &config_path, std::string &jso
     }
 }
 
-template<typename PixelConverter>
-static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
-        PixelConverter pixel_converter )
+static SDL_Surface_Ptr copy_surface_32( const SDL_Surface_Ptr &original )
 {
     cata_assert( original );
     SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
     cata_assert( surf );
     throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
                   "SDL_BlitSurface failed" );
+    return surf;
+}
 
-    SDL_Color *pix = static_cast<SDL_Color *>( surf->pixels );
+// Splits the rows of surf between threads, filtering what is left on this thread when no
+// more threads can be started.
+static void apply_color_filter( const SDL_Surface_Ptr &surf, const color_pixel_filter &filter )
+{
+    cata_assert( surf );
+    if( surf->h <= 0 ) {
+        return;
+    }
+    const auto filter_rows = [&surf, &filter]( const int first_row, const int last_row ) {
+        for( int y = first_row; y < last_row; ++y ) {
+            Uint8 *const row = static_cast<Uint8 *>( surf->pixels ) + static_cast<size_t>( y ) * surf->pitch;
+            filter.apply( reinterpret_cast<SDL_Color *>( row ), surf->w );
+        }
+    };
+    const int bands = std::clamp( static_cast<int>( std::thread::hardware_concurrency() ), 1, surf->h );
+    const int band_height = divide_round_up( surf->h, bands );
+    std::vector<std::thread> threads;
+    threads.reserve( bands );
+    on_out_of_scope join_threads( [&threads]() {
+        for( std::thread &thread : threads ) {
+            thread.join();
+        }
+    } );
+    // The first band is filtered on this thread.
+    int row = band_height;
+    try {
+        for( ; row < surf->h; row += band_height ) {
+            threads.emplace_back( filter_rows, row, std::min( row + band_height, surf->h ) );
+        }
+    } catch( const std::system_error &err ) {
+        dbg( D_WARNING ) << "Could not start a thread to filter the tileset: " << err.what();
+    }
+    filter_rows( row, surf->h );
+    filter_rows( 0, std::min( band_height, surf->h ) );
+}
 
-    for( int y = 0, ey = surf->h; y < ey; ++y ) {
-        for( int x = 0, ex = surf->w; x < ex; ++x, ++pix ) {
-            if( pix->a == 0x00 ) {
-                // This check significantly improves the performance since
-                // vast majority of pixels in the tilesets are completely transparent.
-                continue;
+namespace
+{
+
+// Decodes an image on a thread of its own, to decode the next image of a tileset while the
+// current one is turned into textures.
+class image_decoder
+{
+    public:
+        // Decodes on this thread if no thread can be started.
+        explicit image_decoder( const cata_path &path ) :
+            path_str( path.get_unrelative_path().u8string() ) {
+            try {
+                thread = std::thread( [this]() {
+                    decode();
+                } );
+            } catch( const std::system_error &err ) {
+                dbg( D_WARNING ) << "Could not start a thread to decode " << path_str << ": " << err.what();
+                decode();
             }
-            *pix = pixel_converter( *pix );
         }
-    }
+        ~image_decoder() {
+            if( thread.joinable() ) {
+                thread.join();
+            }
+        }
+        image_decoder( const image_decoder & ) = delete;
+        image_decoder &operator=( const image_decoder & ) = delete;
 
-    return surf;
-}
+        /** Waits for the image, @throw std::exception If it could not be loaded. */
+        SDL_Surface_Ptr get() {
+            if( thread.joinable() ) {
+                thread.join();
+            }
+            if( error ) {
+                std::rethrow_exception( error );
+            }
+            return std::move( surface );
+        }
+
+    private:
+        void decode() {
+            try {
+                surface = load_image( path_str.c_str() );
+            } catch( ... ) {
+                error = std::current_exception();
+            }
+        }
+
+        std::string path_str;
+        SDL_Surface_Ptr surface;
+        std::exception_ptr error;
+        std::thread thread;
+};
+
+} // namespace
 
 static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
 {
@@ -464,16 +617,17 @@ void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_P
             { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
         }
     };
+    // One filter at a time, so only one copy of the atlas is kept besides the atlas itself.
     for( tiles_pixel_color_entry &entry : tile_values_data ) {
         std::vector<texture> *tile_values = std::get<0>( entry );
         color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
                 ( entry ) );
         if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
             copy_surface_to_texture( tile_atlas, offset, *tile_values );
         } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+            const SDL_Surface_Ptr filtered = copy_surface_32( tile_atlas );
+            apply_color_filter( filtered, color_pixel_filter( color_pixel_function ) );
+            copy_surface_to_texture( filtered, offset, *tile_values );
         }
     }
 }
@@ -484,11 +638,11 @@ static void extend_vector_by( std::vector<T> &vec, const size_t additional_size
     vec.resize( vec.size() + additional_size );
 }
 
-void tileset_cache::loader::load_tileset( const cata_path &img_path, const bool pump_events )
+void tileset_cache::loader::load_tileset( const SDL_Surface_Ptr &tile_atlas,
+        const bool pump_events )
 {
     cata_assert( sprite_width > 0 );
     cata_assert( sprite_height > 0 );
-    const SDL_Surface_Ptr tile_atlas = load_image( img_path.get_unrelative_path().u8string().c_str() );
     cata_assert( tile_atlas );
     tile_atlas_width = tile_atlas->w;
 
@@ -600,6 +754,7 @@ void cata_tiles::set_draw_scale( int scale )
 
     tile_ratiox = ( static_cast<float>( tile_width ) / static_cast<float>( fontwidth ) );
     tile_ratioy = ( static_cast<float>( tile_height ) / static_cast<float>( fontheight ) );
+    invalidate_render_list();
 }
 
 void tileset_cache::loader::load( const std::string &tileset_id, const bool precheck,
@@ -772,8 +927,23 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
         // new system, several entries
         // When loading multiple tileset images this defines where
         // the tiles from the most recently loaded image start from.
+        std::vector<cata_path> image_paths;
+        for( JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
+            tile_part_def.allow_omitted_members();
+            image_paths.push_back( tileset_root / tile_part_def.get_string( "file" ) );
+        }
+        // Each image is decoded while the previous one is processed.
+        std::unique_ptr<image_decoder> next_image;
+        if( !image_paths.empty() ) {
+            next_image = std::make_unique<image_decoder>( image_paths.front() );
+        }
+        size_t image_index = 0;
         for( const JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
             const cata_path tileset_image_path = tileset_root / tile_part_def.get_string( "file" );
+            std::unique_ptr<image_decoder> image = std::move( next_image );
+            if( ++image_index < image_paths.size() ) {
+                next_image = std::make_unique<image_decoder>( image_paths[image_index] );
+            }
             R = -1;
             G = -1;
             B = -1;
@@ -793,7 +963,7 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
             sprite_pixelscale = tile_part_def.get_float( "pixelscale", 1.0 );
             // First load the tileset image to get the number of available tiles.
             dbg( D_INFO ) << "Attempting to Load Tileset file " << tileset_image_path;
-            load_tileset( tileset_image_path, pump_events );
+            load_tileset( image->get(), pump_events );
             load_tilejson_from_file( tile_part_def );
             if( tile_part_def.has_member( "ascii" ) ) {
                 load_ascii( tile_part_def );
@@ -816,7 +986,8 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
         B = -1;
         // old system, no tile file path entry, only one array of tiles
         dbg( D_INFO ) << "Attempting to Load Tileset file " << img_path;
-        load_tileset( img_path, pump_events );
+        load_tileset( load_image( img_path.get_unrelative_path().u8string().c_str() ),
+                      pump_events );
         load_tilejson_from_file( config );
         offset = size;
     }
@@ -1238,6 +1409,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                        std::multimap<point, formatted_text> &overlay_strings,
                        color_block_overlay_container &color_blocks )
 {
+    CATA_PROFILE_ZONE( "cata_tiles::draw" );
     if( !g ) {
         return;
     }
@@ -1273,11 +1445,6 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     screentile_width = divide_round_up( width, tile_width );
     screentile_height = divide_round_up( height, tile_height );
 
-    const int min_col = 0;
-    const int max_col = s.x;
-    const int min_row = 0;
-    const int max_row = s.y;
-
     avatar &you = get_avatar();
     //limit the render area to maximum view range (121x121 square centered on player)
     const point min_visible( you.posx() % SEEX, you.posy() % SEEY );
@@ -1312,6 +1479,25 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     auto vision_cache = you.get_vision_modes();
     nv_goggles_activated = vision_cache[NV_GOGGLES];
 
+    render_list_key key;
+    key.tileset_ptr = tileset_ptr.get();
+    key.dest = dest;
+    key.center = center;
+    key.size = point( width, height );
+    key.tile_size = point( tile_width, tile_height );
+    key.map_origin = here.get_abs_sub();
+    key.player_pos = you.pos();
+    key.turn = calendar::turn;
+    key.player_moves = you.moves;
+    key.actions = g->get_moves_since_last_save();
+    key.map_appearance = map::appearance_generation();
+    key.creatures = Creature::appearance_generation();
+    key.nv_goggles = nv_goggles_activated;
+    key.show_zones = g->is_zones_manager_open();
+    key.zones = zone_manager::get_manager().get_revision();
+    const bool cache_render_list = !has_uncached_drawing();
+    const bool reuse_render_list = cache_render_list && can_reuse_render_list( key, ch );
+
     // check that the creature for which we'll draw the visibility map is still alive at that point
     if( g->display_overlay_state( ACTION_DISPLAY_VISIBILITY ) &&
         g->displaying_visibility_creature ) {
@@ -1323,8 +1509,6 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             g->displaying_visibility_creature = nullptr;
         }
     }
-    const point half_tile( tile_width / 2, 0 );
-    const point quarter_tile( tile_width / 4, tile_height / 4 );
     if( g->display_overlay_state( ACTION_DISPLAY_VEHICLE_AI ) ) {
         for( const wrapped_vehicle &elem : here.get_vehicles() ) {
             const vehicle &veh = *elem.v;
@@ -1339,12 +1523,117 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             }
         }
     }
-    const auto apply_visible = [&]( const tripoint & np, const level_cache & ch, map & here ) {
-        return np.y < min_visible.y || np.y > max_visible.y ||
-               np.x < min_visible.x || np.x > max_visible.x ||
-               would_apply_vision_effects( here.get_visibility( ch.visibility_cache[np.x][np.y],
-                                           cache ) );
-    };
+
+    batching_sprites = batch_sprites;
+    if( reuse_render_list ) {
+        draw_render_list();
+    } else {
+        start_render_list( cache_render_list );
+        draw_map_tiles( center, s, min_visible, max_visible, offscreen_type, overlay_strings,
+                        color_blocks );
+        // What is drawn off-screen below only memorizes tiles, it is not shown again
+        recording_render_list = false;
+    }
+    // tile overrides are already drawn in the previous code
+    void_radiation_override();
+    void_terrain_override();
+    void_furniture_override();
+    void_graffiti_override();
+    void_trap_override();
+    void_field_override();
+    void_item_override();
+    void_vpart_override();
+    void_draw_below_override();
+    void_monster_override();
+
+    if( !reuse_render_list ) {
+        memorize_tiles_out_of_view( center, s, min_visible, max_visible );
+        finish_render_list( key, ch, cache_render_list );
+    }
+    sprite_batch.flush( renderer );
+    batching_sprites = false;
+
+    in_animation = do_draw_explosion || do_draw_custom_explosion ||
+                   do_draw_bullet || do_draw_hit || do_draw_line ||
+                   do_draw_cursor || do_draw_highlight || do_draw_weather ||
+                   do_draw_sct || do_draw_zones;
+
+    draw_footsteps_frame( center );
+    if( in_animation ) {
+        if( do_draw_explosion ) {
+            draw_explosion_frame();
+        }
+        if( do_draw_custom_explosion ) {
+            draw_custom_explosion_frame();
+        }
+        if( do_draw_bullet ) {
+            draw_bullet_frame();
+        }
+        if( do_draw_hit ) {
+            draw_hit_frame();
+            void_hit();
+        }
+        if( do_draw_line ) {
+            draw_line();
+            void_line();
+        }
+        if( do_draw_weather ) {
+            draw_weather_frame();
+            void_weather();
+        }
+        if( do_draw_sct ) {
+            draw_sct_frame( overlay_strings );
+            void_sct();
+        }
+        if( do_draw_zones ) {
+            draw_zones_frame();
+            void_zones();
+        }
+        if( do_draw_cursor ) {
+            draw_cursor();
+            void_cursor();
+        }
+        if( do_draw_highlight ) {
+            draw_highlight();
+            void_highlight();
+        }
+    } else if( you.view_offset != tripoint_zero && !you.in_vehicle ) {
+        // check to see if player is located at ter
+        draw_from_id_string( "cursor", TILE_CATEGORY::NONE, empty_string,
+                             tripoint( g->ter_view_p.xy(), center.z ), 0, 0, lit_level::LIT,
+                             false );
+    }
+    if( you.controlling_vehicle ) {
+        std::optional<tripoint> indicator_offset = g->get_veh_dir_indicator_location( true );
+        if( indicator_offset ) {
+            draw_from_id_string( "cursor", TILE_CATEGORY::NONE, empty_string,
+                                 indicator_offset->xy() +
+                                 tripoint( you.posx(), you.posy(), center.z ),
+                                 0, 0, lit_level::LIT, false );
+        }
+    }
+
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+}
+
+void cata_tiles::draw_map_tiles( const tripoint &center, const point &s,
+                                 const point &min_visible, const point &max_visible,
+                                 const visibility_type offscreen_type,
+                                 std::multimap<point, formatted_text> &overlay_strings,
+                                 color_block_overlay_container &color_blocks )
+{
+    map &here = get_map();
+    const visibility_variables &cache = here.get_visibility_variables_cache();
+    const level_cache &ch = here.access_cache( center.z );
+    avatar &you = get_avatar();
+    const int min_col = 0;
+    const int max_col = s.x;
+    const int min_row = 0;
+    const int max_row = s.y;
+
+    const point half_tile( tile_width / 2, 0 );
+    const point quarter_tile( tile_width / 4, tile_height / 4 );
     std::map<tripoint, int> npc_attack_rating_map;
     int max_npc_effectiveness = 0;
     if( g->display_overlay_state( ACTION_DISPLAY_NPC_ATTACK_POTENTIAL ) ) {
@@ -1567,7 +1856,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             }
             for( int i = 0; i < 4; i++ ) {
                 const tripoint np = pos + neighborhood[i];
-                invisible[1 + i] = apply_visible( np, ch, here );
+                invisible[1 + i] = is_out_of_view( np, ch, here, min_visible, max_visible );
             }
 
             int height_3d = 0;
@@ -1614,18 +1903,18 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             }
         }
     }
-    // tile overrides are already drawn in the previous code
-    void_radiation_override();
-    void_terrain_override();
-    void_furniture_override();
-    void_graffiti_override();
-    void_trap_override();
-    void_field_override();
-    void_item_override();
-    void_vpart_override();
-    void_draw_below_override();
-    void_monster_override();
+}
 
+void cata_tiles::memorize_tiles_out_of_view( const tripoint &center, const point &s,
+        const point &min_visible, const point &max_visible )
+{
+    map &here = get_map();
+    const visibility_variables &cache = here.get_visibility_variables_cache();
+    const level_cache &ch = here.access_cache( center.z );
+    const int min_col = 0;
+    const int max_col = s.x;
+    const int min_row = 0;
+    const int max_row = s.y;
     //Memorize everything the character just saw even if it wasn't displayed.
     for( int mem_y = min_visible.y; mem_y <= max_visible.y; mem_y++ ) {
         for( int mem_x = min_visible.x; mem_x <= max_visible.x; mem_x++ ) {
@@ -1668,7 +1957,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             invisible[0] = false;
             for( int i = 0; i < 4; i++ ) {
                 const tripoint np = p + neighborhood[i];
-                invisible[1 + i] = apply_visible( np, ch, here );
+                invisible[1 + i] = is_out_of_view( np, ch, here, min_visible, max_visible );
             }
             //calling draw to memorize everything.
             //bypass cache check in case we learn something new about the terrain's connections
@@ -1683,69 +1972,99 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             }
         }
     }
+}
 
-    in_animation = do_draw_explosion || do_draw_custom_explosion ||
-                   do_draw_bullet || do_draw_hit || do_draw_line ||
-                   do_draw_cursor || do_draw_highlight || do_draw_weather ||
-                   do_draw_sct || do_draw_zones;
+bool cata_tiles::is_out_of_view( const tripoint &p, const level_cache &ch, const map &here,
+                                 const point &min_visible, const point &max_visible ) const
+{
+    return p.y < min_visible.y || p.y > max_visible.y ||
+           p.x < min_visible.x || p.x > max_visible.x ||
+           would_apply_vision_effects( here.get_visibility( ch.visibility_cache[p.x][p.y],
+                                       here.get_visibility_variables_cache() ) );
+}
 
-    draw_footsteps_frame( center );
-    if( in_animation ) {
-        if( do_draw_explosion ) {
-            draw_explosion_frame();
-        }
-        if( do_draw_custom_explosion ) {
-            draw_custom_explosion_frame();
-        }
-        if( do_draw_bullet ) {
-            draw_bullet_frame();
-        }
-        if( do_draw_hit ) {
-            draw_hit_frame();
-            void_hit();
-        }
-        if( do_draw_line ) {
-            draw_line();
-            void_line();
-        }
-        if( do_draw_weather ) {
-            draw_weather_frame();
-            void_weather();
-        }
-        if( do_draw_sct ) {
-            draw_sct_frame( overlay_strings );
-            void_sct();
-        }
-        if( do_draw_zones ) {
-            draw_zones_frame();
-            void_zones();
+bool render_list_key::operator==( const render_list_key &rhs ) const
+{
+    return tileset_ptr == rhs.tileset_ptr && dest == rhs.dest && center == rhs.center &&
+           size == rhs.size && tile_size == rhs.tile_size && map_origin == rhs.map_origin &&
+           player_pos == rhs.player_pos && turn == rhs.turn && player_moves == rhs.player_moves &&
+           actions == rhs.actions && map_appearance == rhs.map_appearance &&
+           creatures == rhs.creatures && nv_goggles == rhs.nv_goggles &&
+           show_zones == rhs.show_zones && zones == rhs.zones;
+}
+
+bool cata_tiles::can_reuse_render_list( const render_list_key &key, const level_cache &ch ) const
+{
+    if( !render_list_valid || !( key == render_key ) ) {
+        return false;
+    }
+    auto lighting = render_list_lighting.begin();
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( *lighting++ != ch.visibility_cache[x][y] ) {
+                return false;
+            }
         }
-        if( do_draw_cursor ) {
-            draw_cursor();
-            void_cursor();
+    }
+    return true;
+}
+
+bool cata_tiles::has_uncached_drawing() const
+{
+    // The debug overlays add overlay strings and color blocks while the tiles are drawn.
+    static const std::array<action_id, 9> tile_overlays = {{
+            ACTION_DISPLAY_SCENT, ACTION_DISPLAY_SCENT_TYPE, ACTION_DISPLAY_RADIATION,
+            ACTION_DISPLAY_NPC_ATTACK_POTENTIAL, ACTION_DISPLAY_TEMPERATURE,
+            ACTION_DISPLAY_VISIBILITY, ACTION_DISPLAY_LIGHTING, ACTION_DISPLAY_TRANSPARENCY,
+            ACTION_DISPLAY_REACHABILITY_ZONES
         }
-        if( do_draw_highlight ) {
-            draw_highlight();
-            void_highlight();
+    };
+    if( has_any_draw_override() ) {
+        return true;
+    }
+    return std::any_of( tile_overlays.begin(), tile_overlays.end(), []( const action_id action ) {
+        return g->display_overlay_state( action );
+    } );
+}
+
+void cata_tiles::start_render_list( const bool record )
+{
+    render_list.clear();
+    render_list_valid = false;
+    render_list_animated = false;
+    recording_render_list = record;
+}
+
+void cata_tiles::finish_render_list( const render_list_key &key, const level_cache &ch,
+                                     const bool recorded )
+{
+    render_list_valid = recorded && !render_list_animated;
+    if( render_list_valid ) {
+        render_key = key;
+        render_list_lighting.clear();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                render_list_lighting.push_back( ch.visibility_cache[x][y] );
+            }
         }
-    } else if( you.view_offset != tripoint_zero && !you.in_vehicle ) {
-        // check to see if player is located at ter
-        draw_from_id_string( "cursor", TILE_CATEGORY::NONE, empty_string,
-                             tripoint( g->ter_view_p.xy(), center.z ), 0, 0, lit_level::LIT,
-                             false );
     }
-    if( you.controlling_vehicle ) {
-        std::optional<tripoint> indicator_offset = g->get_veh_dir_indicator_location( true );
-        if( indicator_offset ) {
-            draw_from_id_string( "cursor", TILE_CATEGORY::NONE, empty_string,
-                                 indicator_offset->xy() +
-                                 tripoint( you.posx(), you.posy(), center.z ),
-                                 0, 0, lit_level::LIT, false );
+}
+
+void cata_tiles::draw_render_list()
+{
+    for( const tile_draw_call &call : render_list ) {
+        if( call.tex == nullptr ) {
+            render_rect( call.dest, call.color );
+        } else {
+            render_sprite( *call.tex, call.dest, call.angle, call.flip );
         }
     }
+}
 
-    printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
-                  "SDL_RenderSetClipRect failed" );
+void cata_tiles::invalidate_render_list()
+{
+    render_list.clear();
+    render_list_valid = false;
 }
 
 void cata_tiles::draw_minimap( const point &dest, const tripoint &center, int width, int height )
@@ -1849,6 +2168,18 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
             ll, -1, apply_night_vision_goggles, height_3d, intensity_level,
             variant, offset );
 }
+
+bool cata_tiles::draw_from_resolved_id( const std::string &id,
+                                        const tile_lookup_table::handle resolved,
+                                        TILE_CATEGORY category, const tripoint &pos, int subtile,
+                                        int rota, lit_level ll, bool apply_night_vision_goggles,
+                                        int &height_3d, int intensity_level )
+{
+    return draw_from_id_string_internal( id, category, empty_string, pos, subtile, rota, ll, -1,
+                                         apply_night_vision_goggles, height_3d, intensity_level,
+                                         "", point(), resolved );
+}
+
 bool cata_tiles::draw_from_id_string_internal( const std::string &id, const tripoint &pos,
         int subtile,
         int rota,
@@ -1871,20 +2202,39 @@ cata_tiles::find_tile_with_season( const std::string &id ) const
 template<typename T>
 std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEGORY category,
-        const int looks_like_jumps_limit ) const
+        const season_type season, const int looks_like_jumps_limit ) const
 {
     const string_id<T> s_id( id );
     if( !s_id.is_valid() ) {
         return std::nullopt;
     }
     const T &obj = s_id.obj();
-    return find_tile_looks_like( obj.looks_like, category, "", looks_like_jumps_limit - 1 );
+    return find_tile_looks_like_in_season( obj.looks_like, category, "", season,
+                                           looks_like_jumps_limit - 1 );
 }
 
 std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                                   const std::string &variant,
                                   const int looks_like_jumps_limit ) const
+{
+    const season_type season = season_of_year( calendar::turn );
+    if( variant.empty() && looks_like_jumps_limit == max_looks_like_jumps &&
+        category < TILE_CATEGORY::last ) {
+        const tile_lookup_table &table = tile_lookups[static_cast<size_t>( category )];
+        const tile_lookup_table::handle h = table.find( id );
+        if( h != tile_lookup_table::no_handle ) {
+            return table.get( h, season );
+        }
+    }
+    return find_tile_looks_like_in_season( id, category, variant, season,
+                                           looks_like_jumps_limit );
+}
+
+std::optional<tile_lookup_res>
+cata_tiles::find_tile_looks_like_in_season( const std::string &id, TILE_CATEGORY category,
+        const std::string &variant, const season_type season,
+        const int looks_like_jumps_limit ) const
 {
     if( id.empty() || looks_like_jumps_limit <= 0 ) {
         return std::nullopt;
@@ -1896,23 +2246,24 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     *  that are valid when this method returns. Ideally they should have the lifetime
     *  that is equal or exceeds lifetime of `this` or `this::tileset_ptr`.
     *  For example, `id` argument may have shorter lifetime and thus should not be returned!
-    *  The result of `find_tile_with_season` is OK to be returned, because it's guaranteed to
+    *  The result of `find_tile_type_by_season` is OK to be returned, because it's guaranteed to
     *  return pointers to the keys and values that are stored inside the `tileset_ptr`.
     */
     // Try the variant first
     if( !variant.empty() ) {
-        auto tile_variant_with_season = find_tile_with_season( id + "_var_" + variant );
+        auto tile_variant_with_season = tileset_ptr->find_tile_type_by_season(
+                                            id + "_var_" + variant, season );
         if( tile_variant_with_season ) {
             return tile_variant_with_season;
         } else {
             // Then try the non-variant
-            auto tile_with_season = find_tile_with_season( id );
+            auto tile_with_season = tileset_ptr->find_tile_type_by_season( id, season );
             if( tile_with_season ) {
                 return tile_with_season;
             }
         }
     } else {
-        auto tile_with_season = find_tile_with_season( id );
+        auto tile_with_season = tileset_ptr->find_tile_type_by_season( id, season );
         if( tile_with_season ) {
             return tile_with_season;
         }
@@ -1921,15 +2272,17 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     // Then do looks_like
     switch( category ) {
         case TILE_CATEGORY::FURNITURE:
-            return find_tile_looks_like_by_string_id<furn_t>( id, category,
+            return find_tile_looks_like_by_string_id<furn_t>( id, category, season,
                     looks_like_jumps_limit );
         case TILE_CATEGORY::TERRAIN:
-            return find_tile_looks_like_by_string_id<ter_t>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<ter_t>( id, category, season,
+                    looks_like_jumps_limit );
         case TILE_CATEGORY::FIELD:
-            return find_tile_looks_like_by_string_id<field_type>( id, category,
+            return find_tile_looks_like_by_string_id<field_type>( id, category, season,
                     looks_like_jumps_limit );
         case TILE_CATEGORY::MONSTER:
-            return find_tile_looks_like_by_string_id<mtype>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<mtype>( id, category, season,
+                    looks_like_jumps_limit );
         case TILE_CATEGORY::OVERMAP_TERRAIN: {
             std::optional<tile_lookup_res> ret;
             const oter_type_str_id type_tmp( id );
@@ -1940,7 +2293,8 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
             int jump_limit = looks_like_jumps_limit;
             for( const std::string &looks_like : type_tmp.obj().looks_like ) {
 
-                ret = find_tile_looks_like( looks_like, category, "", jump_limit - 1 );
+                ret = find_tile_looks_like_in_season( looks_like, category, "", season,
+                                                      jump_limit - 1 );
                 if( ret.has_value() ) {
                     return ret;
                 }
@@ -1963,16 +2317,17 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
             std::string variant_id;
             std::tie( base_vpid, variant_id ) = get_vpart_id_variant( new_vpid );
             if( base_vpid.is_valid() ) {
-                ret = find_tile_looks_like( "vp_" + base_vpid.str(), category, "",
-                                            looks_like_jumps_limit - 1 );
+                ret = find_tile_looks_like_in_season( "vp_" + base_vpid.str(), category, "", season,
+                                                      looks_like_jumps_limit - 1 );
             }
             if( !ret.has_value() ) {
                 if( new_vpid.is_valid() ) {
                     const vpart_info &new_vpi = new_vpid.obj();
-                    ret = find_tile_looks_like( "vp_" + new_vpi.looks_like, category, "",
-                                                looks_like_jumps_limit - 1 );
+                    ret = find_tile_looks_like_in_season( "vp_" + new_vpi.looks_like, category, "",
+                                                          season, looks_like_jumps_limit - 1 );
                     if( !ret.has_value() ) {
-                        ret = find_tile_looks_like( new_vpi.looks_like, category, "", looks_like_jumps_limit - 1 );
+                        ret = find_tile_looks_like_in_season( new_vpi.looks_like, category, "",
+                                                              season, looks_like_jumps_limit - 1 );
                     }
                 }
             }
@@ -1982,15 +2337,15 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
         case TILE_CATEGORY::ITEM: {
             if( !item::type_is_defined( itype_id( id ) ) ) {
                 if( string_starts_with( id, "corpse_" ) ) {
-                    return find_tile_looks_like(
-                               "corpse", category, "", looks_like_jumps_limit - 1
+                    return find_tile_looks_like_in_season(
+                               "corpse", category, "", season, looks_like_jumps_limit - 1
                            );
                 }
                 return std::nullopt;
             }
             const itype *new_it = item::find_type( itype_id( id ) );
-            return find_tile_looks_like( new_it->looks_like.str(), category, "",
-                                         looks_like_jumps_limit - 1 );
+            return find_tile_looks_like_in_season( new_it->looks_like.str(), category, "", season,
+                                                   looks_like_jumps_limit - 1 );
         }
 
         default:
@@ -2069,7 +2424,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int subtile, int rota, lit_level ll, int retract,
         bool apply_night_vision_goggles, int &height_3d,
         int intensity_level, const std::string &variant,
-        const point &offset )
+        const point &offset, const tile_lookup_table::handle resolved )
 {
     bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
     // If the ID string does not produce a drawable tile
@@ -2127,7 +2482,13 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
     }
     // if a tile with intensity hasn't already been found then fall back to a base tile
     if( !res ) {
-        res = find_tile_looks_like( id, category, variant );
+        if( resolved != tile_lookup_table::no_handle && variant.empty() &&
+            resolved < tile_lookups[static_cast<size_t>( category )].size() ) {
+            res = tile_lookups[static_cast<size_t>( category )].get( resolved,
+                    season_of_year( calendar::turn ) );
+        } else {
+            res = find_tile_looks_like( id, category, variant );
+        }
         if( res ) {
             tt = &res -> tile();
         }
@@ -2477,6 +2838,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
 
         // idle tile animations:
         if( display_tile.animated ) {
+            render_list_animated = true;
             // idle animations run during the user's turn, and the animation speed
             // needs to be defined by the tileset to look good, so we use system clock:
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -2507,6 +2869,30 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
     return true;
 }
 
+int cata_tiles::render_sprite( const texture &tex, const SDL_Rect &dest, const double angle,
+                               const SDL_RendererFlip flip )
+{
+    if( recording_render_list ) {
+        render_list.push_back( { &tex, dest, SDL_Color(), angle, flip } );
+    }
+    if( batching_sprites ) {
+        tex.render_batched( sprite_batch, renderer, dest, angle, flip );
+        return 0;
+    }
+    return tex.render_copy_ex( renderer, &dest, angle, nullptr, flip );
+}
+
+void cata_tiles::render_rect( const SDL_Rect &rect, const SDL_Color &color )
+{
+    if( recording_render_list ) {
+        render_list.push_back( { nullptr, rect, color, 0.0, SDL_FLIP_NONE } );
+    }
+    if( batching_sprites ) {
+        sprite_batch.flush( renderer );
+    }
+    geometry->rect( renderer, rect, color );
+}
+
 bool cata_tiles::draw_sprite_at(
     const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
     const point &p, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -2585,19 +2971,17 @@ bool cata_tiles::draw_sprite_at(
     destination.w = width * tile_width * tile.pixelscale / tileset_ptr->get_tile_width();
     destination.h = height * tile_height * tile.pixelscale / tileset_ptr->get_tile_height();
 
+    double angle = 0;
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
     if( rotate_sprite ) {
         if( rota == -1 ) {
             // flip horizontally
-            ret = sprite_tex->render_copy_ex(
-                      renderer, &destination, 0, nullptr,
-                      static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
+            flip = SDL_FLIP_HORIZONTAL;
         } else {
             switch( rota % 4 ) {
                 default:
                 case 0:
                     // unrotated (and 180, with just two sprites)
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
                     break;
                 case 1:
                     // 90 degrees (and 270, with just two sprites)
@@ -2610,23 +2994,15 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, -90, nullptr,
-                                                          SDL_FLIP_NONE );
-                    } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        angle = -90;
                     }
                     break;
                 case 2:
                     // 180 degrees, implemented with flips instead of rotation
                     if( !is_isometric() ) {
                         // never flip isometric tiles vertically
-                        ret = sprite_tex->render_copy_ex(
-                                  renderer, &destination, 0, nullptr,
-                                  static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
-                    } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        flip = static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL |
+                                                              SDL_FLIP_VERTICAL );
                     }
                     break;
                 case 3:
@@ -2640,19 +3016,13 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 90, nullptr,
-                                                          SDL_FLIP_NONE );
-                    } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        angle = 90;
                     }
                     break;
             }
         }
-    } else {
-        // don't rotate, same as case 0 above
-        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr, SDL_FLIP_NONE );
     }
+    ret = render_sprite( *sprite_tex, destination, angle, flip );
 
     printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
     // this reference passes all the way back up the call chain back to
@@ -2776,7 +3146,7 @@ bool cata_tiles::draw_terrain_below( const tripoint &p, const lit_level, int &,
     if( is_isometric() ) {
         belowRect.y += tile_height / 8;
     }
-    geometry->rect( renderer, belowRect, tercol );
+    render_rect( belowRect, tercol );
 
     return true;
 }
@@ -2818,8 +3188,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         }
         // draw the actual terrain if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
-                                        rotation, ll, nv_goggles_activated, height_3d );
+            return draw_from_resolved_id( tname, t.to_i(), TILE_CATEGORY::TERRAIN, p, subtile,
+                                          rotation, ll, nv_goggles_activated, height_3d, 0 );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2843,14 +3213,14 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
-                                        rotation, lit, nv, height_3d );
+            return draw_from_resolved_id( tname, t2.to_i(), TILE_CATEGORY::TERRAIN, p, subtile,
+                                          rotation, lit, nv, height_3d, 0 );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const memorized_terrain_tile &t = get_terrain_memory_at( p );
         return draw_from_id_string(
-                   t.tile, TILE_CATEGORY::TERRAIN, empty_string, p, t.subtile, t.rotation,
+                   t.tile(), TILE_CATEGORY::TERRAIN, empty_string, p, t.subtile, t.rotation,
                    lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -2861,7 +3231,7 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        return !t.tile.empty();
+        return !t.tile().empty();
     }
     return false;
 }
@@ -2871,7 +3241,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "t_" ) ) {
+        if( string_starts_with( t.tile(), "t_" ) ) {
             return true;
         }
     }
@@ -2883,7 +3253,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "f_" ) ) {
+        if( string_starts_with( t.tile(), "f_" ) ) {
             return true;
         }
     }
@@ -2895,7 +3265,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "tr_" ) ) {
+        if( string_starts_with( t.tile(), "tr_" ) ) {
             return true;
         }
     }
@@ -2907,7 +3277,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "vp_" ) ) {
+        if( string_starts_with( t.tile(), "vp_" ) ) {
             return true;
         }
     }
@@ -2919,7 +3289,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "t_" ) ) {
+        if( string_starts_with( t.tile(), "t_" ) ) {
             return t;
         }
     }
@@ -2931,7 +3301,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "f_" ) ) {
+        if( string_starts_with( t.tile(), "f_" ) ) {
             return t;
         }
     }
@@ -2943,7 +3313,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "tr_" ) ) {
+        if( string_starts_with( t.tile(), "tr_" ) ) {
             return t;
         }
     }
@@ -2955,7 +3325,7 @@ memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) cons
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
         memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "vp_" ) ) {
+        if( string_starts_with( t.tile(), "vp_" ) ) {
             return t;
         }
     }
@@ -3005,8 +3375,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
-                                        rotation, ll, nv_goggles_activated, height_3d );
+            return draw_from_resolved_id( fname, f.to_i(), TILE_CATEGORY::FURNITURE, p, subtile,
+                                          rotation, ll, nv_goggles_activated, height_3d, 0 );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -3042,14 +3412,14 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
-                                        rotation, lit, nv, height_3d );
+            return draw_from_resolved_id( fname, f2.to_i(), TILE_CATEGORY::FURNITURE, p, subtile,
+                                          rotation, lit, nv, height_3d, 0 );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const memorized_terrain_tile &t = get_furniture_memory_at( p );
         return draw_from_id_string(
-                   t.tile, TILE_CATEGORY::FURNITURE, empty_string, p, t.subtile, t.rotation,
+                   t.tile(), TILE_CATEGORY::FURNITURE, empty_string, p, t.subtile, t.rotation,
                    lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -3127,7 +3497,7 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         // try drawing memory if invisible and not overridden
         const memorized_terrain_tile &t = get_trap_memory_at( p );
         return draw_from_id_string(
-                   t.tile, TILE_CATEGORY::TRAP, empty_string, p, t.subtile, t.rotation,
+                   t.tile(), TILE_CATEGORY::TRAP, empty_string, p, t.subtile, t.rotation,
                    lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -3315,8 +3685,9 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             //get field intensity
             int intensity = fld_overridden ? 0 : here.field_at( p ).displayed_intensity();
             int nullint = 0;
-            ret_draw_field = draw_from_id_string( fld.id().str(), TILE_CATEGORY::FIELD, empty_string,
-                                                  p, subtile, rotation, lit, nv, nullint, intensity );
+            ret_draw_field = draw_from_resolved_id( fld.id().str(), fld.to_i(),
+                                                    TILE_CATEGORY::FIELD, p, subtile, rotation,
+                                                    lit, nv, nullint, intensity );
         }
     }
 
@@ -3573,7 +3944,7 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
         const memorized_terrain_tile &t = get_vpart_memory_at( p );
         int height_3d_temp = 0;
         return draw_from_id_string(
-                   t.tile, TILE_CATEGORY::VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
+                   t.tile(), TILE_CATEGORY::VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
                    lit_level::MEMORIZED, nv_goggles_activated, height_3d_temp );
     }
     return false;
@@ -3629,7 +4000,7 @@ bool cata_tiles::draw_critter_at_below( const tripoint &p, const lit_level, int
         belowRect.y += tile_height / 8;
     }
 
-    geometry->rect( renderer, belowRect, tercol );
+    render_rect( belowRect, tercol );
 
     return true;
 }
@@ -3850,12 +4221,20 @@ bool cata_tiles::draw_item_highlight( const tripoint &pos )
 std::shared_ptr<const tileset> tileset_cache::load_tileset( const std::string &tileset_id,
         const SDL_Renderer_Ptr &renderer, const bool precheck, const bool force, const bool pump_events )
 {
+    const auto load_timed = [&]( tileset & ts ) {
+        CATA_PROFILE_ZONE( "tileset_cache::load_tileset" );
+        const auto start = std::chrono::steady_clock::now();
+        loader loader( ts, renderer );
+        loader.load( tileset_id, precheck, pump_events );
+        DebugLog( D_INFO, DC_ALL ) << "Loaded tileset " << tileset_id << " in "
+                                   << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - start ).count() << " ms";
+    };
     const auto get_or_create_tileset = [&]() {
         const auto it = tilesets_.find( tileset_id );
         if( it == tilesets_.end() || it->second.expired() ) {
             std::shared_ptr<tileset> new_ts = std::make_shared<tileset>();
-            loader loader( *new_ts, renderer );
-            loader.load( tileset_id, precheck, pump_events );
+            load_timed( *new_ts );
             tilesets_.emplace( tileset_id, new_ts );
             return new_ts;
         }
@@ -3865,8 +4244,7 @@ std::shared_ptr<const tileset> tileset_cache::load_tileset( const std::string &t
     std::shared_ptr<tileset> ts = get_or_create_tileset();
 
     if( force || ( ts->get_tileset_id().empty() && !precheck ) ) {
-        loader loader( *ts, renderer );
-        loader.load( tileset_id, precheck, pump_events );
+        load_timed( *ts );
     }
     return ts;
 }
@@ -4106,6 +4484,15 @@ bool cata_tiles::has_draw_override( const tripoint &p ) const
            monster_override.find( p ) != monster_override.end();
 }
 
+bool cata_tiles::has_any_draw_override() const
+{
+    return !radiation_override.empty() || !terrain_override.empty() ||
+           !furniture_override.empty() || !graffiti_override.empty() ||
+           !trap_override.empty() || !field_override.empty() || !item_override.empty() ||
+           !vpart_override.empty() || !draw_below_override.empty() ||
+           !monster_override.empty();
+}
+
 /* -- Animation Renders */
 void cata_tiles::draw_explosion_frame()
 {
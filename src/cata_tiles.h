@@ -2,9 +2,13 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -12,7 +16,9 @@
 #include <vector>
 
 #include "animation.h"
+#include "calendar.h"
 #include "cata_type_traits.h"
+#include "coordinates.h"
 #include "creature.h"
 #include "enums.h"
 #include "lightmap.h"
@@ -31,6 +37,7 @@
 class Character;
 class JsonObject;
 class pixel_minimap;
+struct level_cache;
 
 extern void set_displaybuffer_rendertarget();
 
@@ -92,6 +99,38 @@ class tile_lookup_res
         }
 };
 
+/**
+ * The tiles of all ids of a category, resolved once for each season, with the season variants
+ * and the looks_like fallbacks already applied. Ids are mapped to dense handles indexing the
+ * resolved tiles, so finding the tile of an id is a single lookup. Terrain, furniture and
+ * fields are added in the order of their int ids, so their int ids are their handles.
+ */
+class tile_lookup_table
+{
+    public:
+        using handle = uint32_t;
+        static constexpr handle no_handle = std::numeric_limits<handle>::max();
+
+        void clear();
+        /** Adds @p id without any tile, returns its handle. */
+        handle add( const std::string &id );
+        /** Handle of @p id, @ref no_handle if it was not added. */
+        handle find( const std::string &id ) const;
+        void set( handle h, season_type season, const std::optional<tile_lookup_res> &tile ) {
+            tiles[h][season] = tile;
+        }
+        const std::optional<tile_lookup_res> &get( handle h, season_type season ) const {
+            return tiles[h][season];
+        }
+        size_t size() const {
+            return tiles.size();
+        }
+
+    private:
+        std::unordered_map<std::string, handle> handles;
+        std::vector<std::array<std::optional<tile_lookup_res>, NUM_SEASONS>> tiles;
+};
+
 class texture
 {
     private:
@@ -117,6 +156,13 @@ class texture
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
+        /// Like @ref render_copy_ex, rotated around the center of @p dstrect, but drawn when
+        /// @p batch is flushed.
+        void render_batched( SpriteBatch &batch, const SDL_Renderer_Ptr &renderer,
+                             const SDL_Rect &dstrect, const double angle,
+                             const SDL_RendererFlip flip ) const {
+            batch.add( renderer, sdl_texture_ptr.get(), srcrect, dstrect, angle, flip );
+        }
 };
 
 class layer_variant
@@ -304,9 +350,9 @@ class tileset_cache::loader
          * @param pump_events Handle window events and refresh the screen when necessary.
          *        Please ensure that the tileset is not accessed when this method is
          *        executing if you set it to true.
-         * @throw std::exception If the image can not be loaded.
+         * @throw std::exception On any error.
          */
-        void load_tileset( const cata_path &path, bool pump_events );
+        void load_tileset( const SDL_Surface_Ptr &tile_atlas, bool pump_events );
         /**
          * Load tiles from json data.This expects a "tiles" array in
          * <B>config</B>. That array should contain all the tile definition that
@@ -375,6 +421,40 @@ struct formatted_text {
  */
 using color_block_overlay_container = std::pair<SDL_BlendMode, std::multimap<point, SDL_Color>>;
 
+/** A sprite or a filled rectangle drawn on the map, as kept in the render list of cata_tiles. */
+struct tile_draw_call {
+    // nullptr for a rectangle filled with color
+    const texture *tex;
+    SDL_Rect dest;
+    SDL_Color color;
+    double angle;
+    SDL_RendererFlip flip;
+};
+
+/**
+ * Everything the tiles drawn on the map depend on, apart from the lighting (which is
+ * compared separately). When none of it changed, the map looks the same as last time.
+ */
+struct render_list_key {
+    const tileset *tileset_ptr = nullptr;
+    point dest;
+    tripoint center;
+    point size;
+    point tile_size;
+    tripoint_abs_sm map_origin;
+    tripoint player_pos;
+    time_point turn;
+    int player_moves = 0;
+    int actions = 0;
+    int64_t map_appearance = 0;
+    int64_t creatures = 0;
+    bool nv_goggles = false;
+    bool show_zones = false;
+    int64_t zones = 0;
+
+    bool operator==( const render_list_key &rhs ) const;
+};
+
 class cata_tiles
 {
         friend class cata_tiles_test_helper;
@@ -412,15 +492,22 @@ class cata_tiles
 
         std::optional<tile_lookup_res> find_tile_with_season( const std::string &id ) const;
 
+        static constexpr int max_looks_like_jumps = 10;
+
+        /** Uses the resolved tiles of @ref tile_lookups when it can. */
         std::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
-                              int looks_like_jumps_limit = 10 ) const;
+                              int looks_like_jumps_limit = max_looks_like_jumps ) const;
+        std::optional<tile_lookup_res>
+        find_tile_looks_like_in_season( const std::string &id, TILE_CATEGORY category,
+                                        const std::string &variant, season_type season,
+                                        int looks_like_jumps_limit ) const;
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
         std::optional<tile_lookup_res>
         find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEGORY category,
-                                           int looks_like_jumps_limit ) const;
+                                           season_type season, int looks_like_jumps_limit ) const;
 
         bool find_overlay_looks_like( bool male, const std::string &overlay, const std::string &variant,
                                       std::string &draw_id );
@@ -451,10 +538,20 @@ class cata_tiles
         bool draw_from_id_string_internal( const std::string &id, const tripoint &pos, int subtile,
                                            int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles );
+        /**
+         * Like @ref draw_from_id_string, for terrain, furniture and fields: @p resolved is the
+         * int id of @p id, which indexes their resolved tiles in @ref tile_lookups.
+         */
+        bool draw_from_resolved_id( const std::string &id, tile_lookup_table::handle resolved,
+                                    TILE_CATEGORY category, const tripoint &pos, int subtile,
+                                    int rota, lit_level ll, bool apply_night_vision_goggles,
+                                    int &height_3d, int intensity_level );
         bool draw_from_id_string_internal( const std::string &id, TILE_CATEGORY category,
                                            const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
-                                           const std::string &variant, const point &offset );
+                                           const std::string &variant, const point &offset,
+                                           tile_lookup_table::handle resolved =
+                                               tile_lookup_table::no_handle );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -462,6 +559,42 @@ class cata_tiles
         bool draw_tile_at( const tile_type &tile, const point &, unsigned int loc_rand, int rota,
                            lit_level ll, bool apply_night_vision_goggles, int retract, int &height_3d,
                            const point &offset );
+        /**
+         * Draws a sprite of the map, and adds it to the render list when recording it. While
+         * the map is drawn, the sprites are collected into @ref sprite_batch.
+         */
+        int render_sprite( const texture &tex, const SDL_Rect &dest, double angle,
+                           SDL_RendererFlip flip );
+        /** Draws a rectangle on the map, and adds it to the render list when recording it. */
+        void render_rect( const SDL_Rect &rect, const SDL_Color &color );
+
+        /**
+         * The map tiles are drawn from the render list of the last frame if it is still valid,
+         * see @ref render_list_key. Otherwise they are drawn again and the render list is
+         * recorded if it can be reused.
+         */
+        bool can_reuse_render_list( const render_list_key &key, const level_cache &ch ) const;
+        /** Whether the map is drawn with something that is not kept in the render list. */
+        bool has_uncached_drawing() const;
+        /** Replays the render list of the last frame. */
+        void draw_render_list();
+        /** Clears the render list, and starts recording it if @p record is set. */
+        void start_render_list( bool record );
+        /** Keeps the render list for the next frame if it was recorded without animated tiles. */
+        void finish_render_list( const render_list_key &key, const level_cache &ch, bool recorded );
+        /** Draws the tiles of the map shown on screen, recording them when requested. */
+        void draw_map_tiles( const tripoint &center, const point &s, const point &min_visible,
+                             const point &max_visible, visibility_type offscreen_type,
+                             std::multimap<point, formatted_text> &overlay_strings,
+                             color_block_overlay_container &color_blocks );
+        /** Memorizes what the character sees around them but is not shown on screen. */
+        void memorize_tiles_out_of_view( const tripoint &center, const point &s,
+                                         const point &min_visible, const point &max_visible );
+        /** Whether @p p is outside of the view range, or can't be seen by the character. */
+        bool is_out_of_view( const tripoint &p, const level_cache &ch, const map &here,
+                             const point &min_visible, const point &max_visible ) const;
+        /** Drops the render list, the map is drawn again next frame. */
+        void invalidate_render_list();
 
         /* Tile Picking */
         void get_tile_values( int t, const std::array<int, 4> &tn, int &subtile, int &rotation,
@@ -617,6 +750,7 @@ class cata_tiles
         void void_monster_override();
 
         bool has_draw_override( const tripoint &p ) const;
+        bool has_any_draw_override() const;
 
         /**
          * Initialize the current tileset (load tile images, load mapping), using the current
@@ -631,6 +765,12 @@ class cata_tiles
          */
         void load_tileset( const std::string &tileset_id, bool precheck = false,
                            bool force = false, bool pump_events = false );
+        /**
+         * Resolves the tiles of all terrain, furniture, fields, monsters, items and vehicle parts
+         * with the current tileset and game data. Nothing is resolved before the game data is
+         * finalized, the tiles are then looked up one by one.
+         */
+        void resolve_tile_lookups();
         /**
          * Reinitializes the current tileset, like @ref init, but using the original screen information.
          * @throw std::exception On any error.
@@ -766,6 +906,24 @@ class cata_tiles
          */
         bool nv_goggles_activated = false;
 
+        /** Sprites and rectangles of the map drawn by the last frame, in the order drawn. */
+        std::vector<tile_draw_call> render_list;
+        render_list_key render_key;
+        /** Lighting the render list was drawn with. */
+        std::vector<lit_level> render_list_lighting;
+        bool render_list_valid = false;
+        bool recording_render_list = false;
+        /** Animated tiles change every frame, the render list can't be reused with any drawn. */
+        bool render_list_animated = false;
+
+        /** Resolved tiles of the ids of each category, see @ref resolve_tile_lookups. */
+        std::array<tile_lookup_table, static_cast<size_t>( TILE_CATEGORY::last )> tile_lookups;
+
+        SpriteBatch sprite_batch;
+        /** Whether the map is drawn with batched sprites, from the BATCH_SPRITES option. */
+        bool batch_sprites = true;
+        bool batching_sprites = false;
+
         pimpl<pixel_minimap> minimap;
 
     public:
@@ -79,24 +79,34 @@ bool isBetween( int test, int down, int up )
     return test > down && test < up;
 }
 
+std::u32string lcmatch_query( const std::string &qry )
+{
+    std::u32string u32_qry = utf8_to_utf32( qry );
+    std::for_each( u32_qry.begin(), u32_qry.end(), u32_to_lowercase );
+    return u32_qry;
+}
+
 bool lcmatch( const std::string &str, const std::string &qry )
+{
+    return lcmatch( str, lcmatch_query( qry ) );
+}
+
+bool lcmatch( const std::string &str, const std::u32string &lc_qry )
 {
     std::u32string u32_str = utf8_to_utf32( str );
-    std::u32string u32_qry = utf8_to_utf32( qry );
     std::for_each( u32_str.begin(), u32_str.end(), u32_to_lowercase );
-    std::for_each( u32_qry.begin(), u32_qry.end(), u32_to_lowercase );
     // First try match their lowercase forms
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( lc_qry ) != std::u32string::npos ) {
         return true;
     }
     // Then try removing accents from str ONLY
     std::for_each( u32_str.begin(), u32_str.end(), remove_accent );
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( lc_qry ) != std::u32string::npos ) {
         return true;
     }
     if( use_pinyin_search ) {
         // Finally, try to convert the string to pinyin and compare
-        return pinyin::pinyin_match( u32_str, u32_qry );
+        return pinyin::pinyin_match( u32_str, lc_qry );
     }
     return false;
 }
@@ -106,6 +116,22 @@ bool lcmatch( const translation &str, const std::string &qry )
     return lcmatch( str.translated(), qry );
 }
 
+lcmatch_key::lcmatch_key( const std::string &str ) : lowercase( utf8_to_utf32( str ) )
+{
+    std::for_each( lowercase.begin(), lowercase.end(), u32_to_lowercase );
+    unaccented = lowercase;
+    std::for_each( unaccented.begin(), unaccented.end(), remove_accent );
+}
+
+bool lcmatch_key::matches( const std::u32string &lc_qry ) const
+{
+    if( lowercase.find( lc_qry ) != std::u32string::npos ||
+        unaccented.find( lc_qry ) != std::u32string::npos ) {
+        return true;
+    }
+    return use_pinyin_search && pinyin::pinyin_match( unaccented, lc_qry );
+}
+
 bool match_include_exclude( const std::string &text, std::string filter )
 {
     size_t iPos;
@@ -113,6 +113,28 @@ bool isBetween( int test, int down, int up );
 bool lcmatch( const std::string &str, const std::string &qry );
 bool lcmatch( const translation &str, const std::string &qry );
 
+/** @ref lcmatch with a query already prepared by @ref lcmatch_query. */
+bool lcmatch( const std::string &str, const std::u32string &lc_qry );
+/** The lowercase UTF-32 form of @p qry, to match many strings against it. */
+std::u32string lcmatch_query( const std::string &qry );
+
+/**
+ * The lowercase and unaccented forms of a string, computed once so the string can be
+ * matched against many queries (such as each key typed into a filter) like @ref lcmatch does.
+ */
+class lcmatch_key
+{
+    public:
+        lcmatch_key() = default;
+        explicit lcmatch_key( const std::string &str );
+        /** Whether @p lc_qry, from @ref lcmatch_query, matches the string. */
+        bool matches( const std::u32string &lc_qry ) const;
+
+    private:
+        std::u32string lowercase;
+        std::u32string unaccented;
+};
+
 /**
  * Matches text case insensitive with the include/exclude rules of the filter
  *
@@ -94,6 +94,7 @@
 #include "pathfinding.h"
 #include "profession.h"
 #include "proficiency.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "ret_val.h"
 #include "rng.h"
@@ -2040,6 +2041,7 @@ void Character::expose_to_disease( const diseasetype_id &dis_type )
 
 void Character::process_turn()
 {
+    CATA_PROFILE_ZONE( "Character::process_turn" );
     // Has to happen before reset_stats
     clear_miss_reasons();
     migrate_items_to_storage( false );
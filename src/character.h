@@ -3616,7 +3616,16 @@ class Character : public Creature, public visitable
             int moves;
             tripoint position;
             int radius;
+            bool clear_path;
             pimpl<inventory> crafting_inventory;
+            // Items found on the map around map_position, without the pseudo tools whose
+            // charges can change every turn. Kept until map::contents_generation changes.
+            int64_t map_generation = -1;
+            tripoint map_position;
+            int map_radius;
+            bool map_clear_path;
+            std::vector<tripoint> map_points;
+            pimpl<inventory> map_inventory;
         };
         mutable crafting_cache_type crafting_cache;
 
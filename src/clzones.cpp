@@ -141,6 +141,7 @@ void zone_manager::clear()
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
     vzone_cache.clear();
+    revision++;
 }
 
 std::string zone_type::name() const
@@ -687,6 +688,7 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
 
 void zone_manager::cache_data( bool update_avatar )
 {
+    revision++;
     area_cache.clear();
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.get_location();
@@ -742,6 +744,7 @@ void zone_manager::cache_avatar_location()
 
 void zone_manager::cache_vzones( map *pmap )
 {
+    revision++;
     vzone_cache.clear();
     map &here = pmap == nullptr ? get_map() : *pmap;
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
@@ -1203,6 +1206,7 @@ bool zone_manager::remove( zone_data &zone )
                 num_personal_zones--;
             }
             zones.erase( it );
+            revision++;
             return true;
         }
     }
@@ -1247,6 +1251,7 @@ void zone_manager::swap( zone_data &a, zone_data &b )
         return;
     }
     std::swap( a, b );
+    revision++;
 }
 
 namespace
@@ -1356,6 +1361,7 @@ void zone_manager::serialize( JsonOut &json ) const
 
 void zone_manager::deserialize( const JsonValue &jv )
 {
+    revision++;
     jv.read( zones );
     for( auto it = zones.begin(); it != zones.end(); ) {
         // need to keep track of number of personal zones on reload
@@ -1520,6 +1526,7 @@ void zone_manager::load_world_zones( std::string const &suffix )
 
 void zone_manager::zone_edited( zone_data &zone )
 {
+    revision++;
     if( zone.get_is_vehicle() ) {
         //Check if this zone has already been stored
         for( auto &changed_vzone : changed_vzones ) {
@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -466,6 +467,9 @@ class zone_manager
         // a count of the number of personal zones the character has
         int num_personal_zones = 0; // NOLINT(cata-serialize)
 
+        // bumped whenever a zone is added, removed, moved or edited
+        int64_t revision = 0; // NOLINT(cata-serialize)
+
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
@@ -489,6 +493,11 @@ class zone_manager
 
         void clear();
 
+        /** Changes whenever zones are added, removed, moved or edited. */
+        int64_t get_revision() const {
+            return revision;
+        }
+
         void add( const std::string &name, const zone_type_id &type, const faction_id &faction,
                   bool invert, bool enabled,
                   const tripoint &start, const tripoint &end,
@@ -583,13 +583,38 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     }
     if( moves == crafting_cache.moves
         && radius == crafting_cache.radius
+        && clear_path == crafting_cache.clear_path
         && calendar::turn == crafting_cache.time
         && inv_pos == crafting_cache.position ) {
         return *crafting_cache.crafting_inventory;
     }
-    crafting_cache.crafting_inventory->clear();
     if( radius >= 0 ) {
-        crafting_cache.crafting_inventory->form_from_map( inv_pos, radius, this, false, clear_path );
+        map &here = get_map();
+        // Scanning and stacking the items on the map is by far the most expensive part, only
+        // do it again when something on the map changed or we are looking somewhere else.
+        std::vector<tripoint> &map_points = crafting_cache.map_points;
+        if( map::contents_generation() != crafting_cache.map_generation
+            || radius != crafting_cache.map_radius
+            || clear_path != crafting_cache.map_clear_path
+            || inv_pos != crafting_cache.map_position ) {
+            map_points.clear();
+            if( clear_path ) {
+                here.reachable_flood_steps( map_points, inv_pos, radius, 1, 100 );
+            } else {
+                for( const tripoint &p : here.points_in_radius( inv_pos, radius ) ) {
+                    map_points.emplace_back( p );
+                }
+            }
+            crafting_cache.map_inventory->form_from_map_items( here, map_points, this, false );
+            crafting_cache.map_generation = map::contents_generation();
+            crafting_cache.map_radius = radius;
+            crafting_cache.map_clear_path = clear_path;
+            crafting_cache.map_position = inv_pos;
+        }
+        *crafting_cache.crafting_inventory = *crafting_cache.map_inventory;
+        crafting_cache.crafting_inventory->add_volatile_map_tools( here, map_points );
+    } else {
+        crafting_cache.crafting_inventory->clear();
     }
 
     std::map<itype_id, int> tmp_liq_list;
@@ -626,12 +651,15 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     crafting_cache.time = calendar::turn;
     crafting_cache.position = inv_pos;
     crafting_cache.radius = radius;
+    crafting_cache.clear_path = clear_path;
     return *crafting_cache.crafting_inventory;
 }
 
 void Character::invalidate_crafting_inventory()
 {
     crafting_cache.time = calendar::before_time_starts;
+    // callers may have changed items in place, which the map does not notice
+    crafting_cache.map_generation = -1;
 }
 
 void Character::make_craft( const recipe_id &id_to_make, int batch_size,
@@ -143,12 +143,31 @@ Creature::Creature()
     fake = false;
 }
 
+static int64_t next_creature_serial = 0;
+static int64_t creature_appearance_generation = 0;
+
+Creature::serial_number::serial_number() noexcept : value( ++next_creature_serial ) {}
+
+Creature::serial_number &Creature::serial_number::operator=( const serial_number & ) noexcept
+{
+    value = ++next_creature_serial;
+    return *this;
+}
+
 Creature::Creature( const Creature & ) = default;
 Creature::Creature( Creature && ) noexcept( map_is_noexcept &&list_is_noexcept ) = default;
 Creature &Creature::operator=( const Creature & ) = default;
 Creature &Creature::operator=( Creature && ) noexcept = default;
 
-Creature::~Creature() = default;
+Creature::~Creature()
+{
+    creature_appearance_generation++;
+}
+
+int64_t Creature::appearance_generation()
+{
+    return creature_appearance_generation;
+}
 
 tripoint Creature::pos() const
 {
@@ -177,11 +196,13 @@ void Creature::move_to( const tripoint_abs_ms &loc )
 void Creature::set_pos_only( const tripoint &p )
 {
     location = get_map().getglobal( p );
+    creature_appearance_generation++;
 }
 
 void Creature::set_location( const tripoint_abs_ms &loc )
 {
     location = loc;
+    creature_appearance_generation++;
 }
 
 void Creature::on_move( const tripoint_abs_ms & ) {}
@@ -1414,6 +1435,8 @@ void Creature::add_effect( const effect_source &source, const efftype_id &eff_id
             }
             if( e.get_intensity() != prev_int ) {
                 on_effect_int_change( eff_id, e.get_intensity(), bp );
+                get_creature_tracker().visibility().forget( *this );
+                creature_appearance_generation++;
             }
         }
     }
@@ -1460,6 +1483,9 @@ void Creature::add_effect( const effect_source &source, const efftype_id &eff_id
             }
         }
         on_effect_int_change( eff_id, e.get_intensity(), bp );
+        // effects such as blindness or invisibility change what was seen this turn
+        get_creature_tracker().visibility().forget( *this );
+        creature_appearance_generation++;
         // Perform any effect addition effects.
         // only when not deferred
         if( !deferred ) {
@@ -1526,6 +1552,8 @@ void Creature::clear_effects()
         }
     }
     effects->clear();
+    get_creature_tracker().visibility().forget( *this );
+    creature_appearance_generation++;
 }
 bool Creature::remove_effect( const efftype_id &eff_id, const bodypart_id &bp )
 {
@@ -1558,6 +1586,8 @@ bool Creature::remove_effect( const efftype_id &eff_id, const bodypart_id &bp )
             effects->erase( eff_id );
         }
     }
+    get_creature_tracker().visibility().forget( *this );
+    creature_appearance_generation++;
     return true;
 }
 bool Creature::remove_effect( const efftype_id &eff_id )
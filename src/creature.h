@@ -4,6 +4,7 @@
 
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <set>
@@ -720,6 +721,14 @@ class Creature : public viewer
     private:
         /** The creature's position in absolute coordinates */
         tripoint_abs_ms location;
+        struct serial_number {
+            int64_t value;
+            serial_number() noexcept;
+            serial_number( const serial_number & ) noexcept : serial_number() {}
+            serial_number &operator=( const serial_number & ) noexcept;
+        };
+        /** See @ref get_serial */
+        serial_number serial;
     protected:
         // Sets the creature's position without any side-effects.
         void set_pos_only( const tripoint &p );
@@ -1288,6 +1297,19 @@ class Creature : public viewer
          * Returns the location of the creature in global overmap terrain coordinates.
          */
         tripoint_abs_omt global_omt_location() const;
+        /**
+         * Number that tells creature objects apart for this session, unlike their address it
+         * is never reused. A copied or assigned creature gets a new one. Not saved.
+         */
+        int64_t get_serial() const {
+            return serial.value;
+        }
+        /**
+         * Counter that changes whenever a creature is placed, moves, is destroyed or gains or
+         * loses an effect. Things drawn from the creatures on the map (like the render list of
+         * the tiles) can compare it to see if they are still up to date.
+         */
+        static int64_t appearance_generation();
     protected:
         /**
          * These two functions are responsible for storing and loading the members
@@ -8,6 +8,7 @@
 #include "cata_assert.h"
 #include "debug.h"
 #include "map.h"
+#include "monfaction.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -91,6 +92,7 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.get_location()] = critter_ptr;
+    monster_index.add( critter, critter.get_location() );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -113,6 +115,90 @@ size_t creature_tracker::size() const
     return monsters_list.size();
 }
 
+bool creature_tracker::character_within( const inclusive_cuboid<tripoint_abs_ms> &bounds,
+        bool ignore_in_vehicle ) const
+{
+    const avatar &you = get_avatar();
+    if( bounds.contains( you.get_location() ) && !( ignore_in_vehicle && you.in_vehicle ) ) {
+        return true;
+    }
+    for( const shared_ptr_fast<npc> &cur_npc : active_npc ) {
+        if( bounds.contains( cur_npc->get_location() ) && !cur_npc->is_dead() &&
+            !( ignore_in_vehicle && cur_npc->in_vehicle ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void creature_tracker::reset_visibility()
+{
+    std::vector<const Creature *> creatures;
+    creatures.reserve( 1 + active_npc.size() + monsters_list.size() );
+    creatures.push_back( &get_avatar() );
+    for( const shared_ptr_fast<npc> &cur_npc : active_npc ) {
+        if( !cur_npc->is_dead() ) {
+            creatures.push_back( cur_npc.get() );
+        }
+    }
+    for( const shared_ptr_fast<monster> &critter : monsters_list ) {
+        if( !critter->is_dead() ) {
+            creatures.push_back( critter.get() );
+        }
+    }
+    visibility_.reset( creatures );
+}
+
+std::vector<monster *> creature_tracker::monsters_near( const tripoint_abs_ms &center, int radius,
+        const std::bitset<OVERMAP_LAYERS> &levels ) const
+{
+    std::vector<monster *> result;
+    monster_index.collect( center, radius, levels, result );
+    result.erase( std::remove_if( result.begin(), result.end(), []( const monster * critter ) {
+        return critter->is_dead();
+    } ), result.end() );
+    return result;
+}
+
+std::vector<monster *> creature_tracker::hostile_monsters_near( const mfaction_id &faction,
+        const tripoint_abs_ms &center, int radius, const std::bitset<OVERMAP_LAYERS> &levels ) const
+{
+    const auto is_hostile = [&faction]( const mfaction_id & other ) {
+        const mf_attitude faction_att = faction.obj().attitude( other );
+        return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+    };
+    std::vector<monster *> result;
+    if( radius < 0 ) {
+        // Only look at the monsters of hostile factions, a horde of the same faction
+        // does not need to be looked at.
+        for( const std::pair<const mfaction_id, std::vector<monster *>> &members :
+             monster_index.by_faction() ) {
+            if( !is_hostile( members.first ) ) {
+                continue;
+            }
+            for( monster *critter : members.second ) {
+                const int z = critter->get_location().z();
+                if( z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT && levels.test( z + OVERMAP_DEPTH ) ) {
+                    result.push_back( critter );
+                }
+            }
+        }
+    } else {
+        monster_index.collect( center, radius, levels, result );
+    }
+    result.erase( std::remove_if( result.begin(), result.end(), [&]( const monster * critter ) {
+        return critter->is_dead() || !is_hostile( monster_spatial_index::faction_of( *critter ) );
+    } ), result.end() );
+    return result;
+}
+
+void creature_tracker::refresh_monster_factions()
+{
+    for( const shared_ptr_fast<monster> &critter : monsters_list ) {
+        monster_index.refresh_faction( *critter );
+    }
+}
+
 bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms &old_pos,
                                    const tripoint_abs_ms &new_pos )
 {
@@ -141,6 +227,7 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( old_pos );
         monsters_by_location[new_pos] = *iter;
+        monster_index.move( **iter, old_pos, new_pos );
         return true;
     } else {
         // We're changing the x/y/z coordinates of a zombie that hasn't been added
@@ -155,6 +242,8 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
 
 void creature_tracker::remove_from_location_map( const monster &critter )
 {
+    monster_index.remove( critter, critter.get_location() );
+
     const auto pos_iter = monsters_by_location.find( critter.get_location() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
         monsters_by_location.erase( pos_iter );
@@ -202,6 +291,7 @@ void creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monster_index.clear();
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -209,9 +299,11 @@ void creature_tracker::clear()
 void creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monster_index.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
         monsters_by_location[mon_ptr->get_location()] = mon_ptr;
+        monster_index.add( *mon_ptr, mon_ptr->get_location() );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -247,9 +339,11 @@ void creature_tracker::swap_positions( monster &first, monster &second )
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
         monsters_by_location[first.get_location()] = first_ptr;
+        monster_index.move( first, second.get_location(), first.get_location() );
     }
     if( second_ptr ) {
         monsters_by_location[second.get_location()] = second_ptr;
+        monster_index.move( second, first.get_location(), second.get_location() );
     }
 }
 
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CREATURE_TRACKER_H
 #define CATA_SRC_CREATURE_TRACKER_H
 
+#include <bitset>
 #include <cstddef>
 #include <list>
 #include <map>
@@ -11,9 +12,13 @@
 #include <vector>
 
 #include "coordinates.h"
+#include "cuboid_rectangle.h"
+#include "game_constants.h"
 #include "memory_fast.h"
+#include "monster_spatial_index.h"
 #include "point.h"
 #include "type_id.h"
+#include "visibility_matrix.h"
 
 class Creature;
 class game;
@@ -34,7 +39,7 @@ class creature_tracker
             public:
                 bool operator()( const weak_ptr_fast<monster> &lhs,
                                  const weak_ptr_fast<monster> &rhs ) const {
-                    return lhs.lock().get() < rhs.lock().get();
+                    return lhs.owner_before( rhs );
                 }
         };
 
@@ -111,10 +116,50 @@ class creature_tracker
         template<typename T = Creature>
         const T * creature_at( const tripoint_abs_ms &p, bool allow_hallucination = false ) const;
 
+        /**
+         * Returns whether the avatar or an active NPC is within the given bounds.
+         * @param ignore_in_vehicle Whether to ignore characters that are inside a vehicle.
+         */
+        bool character_within( const inclusive_cuboid<tripoint_abs_ms> &bounds,
+                               bool ignore_in_vehicle ) const;
+
+        /**
+         * Returns the living monsters that are at most @p radius tiles away from @p center in
+         * x and y direction and on one of the given z-levels. A negative @p radius means any
+         * distance. The order of the monsters is unspecified.
+         */
+        std::vector<monster *> monsters_near( const tripoint_abs_ms &center, int radius,
+                                              const std::bitset<OVERMAP_LAYERS> &levels ) const;
+        /**
+         * Like @ref monsters_near, but only returns monsters of factions that @p faction is
+         * hostile to (its attitude is neither neutral nor friendly). Friendly monsters count
+         * as members of the player faction. Without a radius only the monsters of hostile
+         * factions are looked at, which misses monsters that joined such a faction since
+         * @ref refresh_monster_factions was called.
+         */
+        std::vector<monster *> hostile_monsters_near( const mfaction_id &faction,
+                const tripoint_abs_ms &center, int radius,
+                const std::bitset<OVERMAP_LAYERS> &levels ) const;
+        /**
+         * Lists monsters whose faction or friendliness changed under their new faction for
+         * @ref hostile_monsters_near. Call once per turn, before the monsters plan.
+         */
+        void refresh_monster_factions();
+
         const std::vector<shared_ptr_fast<monster>> &get_monsters_list() const {
             return monsters_list;
         }
 
+        /** Which creatures see which others this turn, see @ref reset_visibility. */
+        visibility_matrix &visibility() {
+            return visibility_;
+        }
+        /**
+         * Indexes the avatar, the active NPCs and the monsters for @ref visibility.
+         * Call once per turn, after the map caches were built.
+         */
+        void reset_visibility();
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
@@ -128,8 +173,11 @@ class creature_tracker
         void rebuild_cache();
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        /** Monsters by location, for range queries. Kept in sync with @ref monsters_by_location */
+        monster_spatial_index monster_index; // NOLINT(cata-serialize)
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        visibility_matrix visibility_; // NOLINT(cata-serialize)
 };
 
 creature_tracker &get_creature_tracker();
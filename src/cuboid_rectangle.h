@@ -113,6 +113,16 @@ struct inclusive_cuboid : cuboid<Tripoint> {
                Traits::y( p ) >= Traits::y( p_min ) && Traits::y( p ) <= Traits::y( p_max ) &&
                Traits::z( p ) >= Traits::z( p_min ) && Traits::z( p ) <= Traits::z( p_max );
     }
+
+    constexpr bool overlaps( const cuboid<Tripoint> &c ) const {
+        using Traits = point_traits<Tripoint>;
+        return !( Traits::x( c.p_min ) > Traits::x( p_max ) ||
+                  Traits::y( c.p_min ) > Traits::y( p_max ) ||
+                  Traits::z( c.p_min ) > Traits::z( p_max ) ||
+                  Traits::x( p_min ) > Traits::x( c.p_max ) ||
+                  Traits::y( p_min ) > Traits::y( c.p_max ) ||
+                  Traits::z( p_min ) > Traits::z( c.p_max ) );
+    }
 };
 
 // Clamp p to the rectangle r.
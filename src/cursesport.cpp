@@ -89,7 +89,7 @@ catacurses::window catacurses::newwin( int nlines, int ncols, const point &begin
 
     for( int j = 0; j < nlines; j++ ) {
         newwindow->line[j].chars.resize( ncols );
-        newwindow->line[j].touched = true; //Touch them all !?
+        newwindow->line[j].touch(); //Touch them all !?
     }
     return catacurses::window( std::shared_ptr<void>( newwindow, []( void *const w ) {
         delete static_cast<cata_cursesport::WINDOW *>( w );
@@ -106,12 +106,18 @@ static int newline( cata_cursesport::WINDOW *win )
     return 0;
 }
 
+// mark a single cell as changed, so it is drawn on the next refresh
+static void touch_cell( cata_cursesport::WINDOW *win, const point &p )
+{
+    win->line[p.y].touch( p.x, p.x + 1 );
+}
+
 // move the cursor a single cell, jumps to the next line if the
-// end of a line has been reached, also sets the touched flag.
+// end of a line has been reached, also marks the cell it leaves as changed.
 static void addedchar( cata_cursesport::WINDOW *win )
 {
+    touch_cell( win, win->cursor );
     win->cursor.x++;
-    win->line[win->cursor.y].touched = true;
     if( win->cursor.x >= win->width ) {
         newline( win );
     }
@@ -290,6 +296,7 @@ static void printstring( cata_cursesport::WINDOW *win, const std::string &text )
     if( win->cursor.x > 0 && win->line[win->cursor.y].chars[win->cursor.x].ch.empty() ) {
         // start inside a wide character, erase it for good
         win->line[win->cursor.y].chars[win->cursor.x - 1].ch.assign( " " );
+        touch_cell( win, win->cursor + point_west );
     }
     while( len > 0 ) {
         if( *fmt == '\n' ) {
@@ -316,6 +323,7 @@ static void printstring( cata_cursesport::WINDOW *win, const std::string &text )
             cursecell *seccell = cur_cell( win );
             if( seccell && seccell->ch.empty() ) {
                 seccell->ch.assign( ' ', 1 );
+                touch_cell( win, win->cursor );
             }
         } else if( dlen == 2 ) {
             // the second cell, per definition must be empty
@@ -343,6 +351,7 @@ static void printstring( cata_cursesport::WINDOW *win, const std::string &text )
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
                     thicell->ch.erase();
+                    touch_cell( win, win->cursor );
                 }
             }
         }
@@ -389,7 +398,7 @@ void catacurses::werase( const window &win_ )
 
     for( int j = 0; j < win->height; j++ ) {
         win->line[j].chars.assign( win->width, cata_cursesport::cursecell() );
-        win->line[j].touched = true;
+        win->line[j].touch();
     }
     win->draw = true;
     wmove( win_, point_zero );
@@ -445,7 +454,7 @@ void catacurses::wclear( const window &win_ )
     }
 
     for( int i = 0; i < win->pos.y && i < stdscr.get<cata_cursesport::WINDOW>()->height; i++ ) {
-        stdscr.get<cata_cursesport::WINDOW>()->line[i].touched = true;
+        stdscr.get<cata_cursesport::WINDOW>()->line[i].touch();
     }
 }
 
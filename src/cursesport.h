@@ -5,6 +5,7 @@
 #include <utility>
 #if defined(TILES) || defined(_WIN32)
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -48,8 +49,30 @@ struct cursecell {
 };
 
 struct curseline {
-    bool touched;
     std::vector<cursecell> chars;
+    // Columns [dirty_begin, dirty_end) have changed since the line was last drawn
+    int dirty_begin = 0;
+    int dirty_end = 0;
+
+    bool touched() const {
+        return dirty_begin < dirty_end;
+    }
+    void touch( int begin, int end ) {
+        if( !touched() ) {
+            dirty_begin = begin;
+            dirty_end = end;
+        } else {
+            dirty_begin = std::min( dirty_begin, begin );
+            dirty_end = std::max( dirty_end, end );
+        }
+    }
+    void touch() {
+        touch( 0, static_cast<int>( chars.size() ) );
+    }
+    void untouch() {
+        dirty_begin = 0;
+        dirty_end = 0;
+    }
 };
 
 // The curses window struct
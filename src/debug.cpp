@@ -40,6 +40,7 @@
 #include "output.h"
 #include "path_info.h"
 #include "point.h"
+#include "session_replay.h"
 #include "translations.h"
 #include "type_id.h"
 #include "ui_manager.h"
@@ -373,7 +374,15 @@ static void debug_error_prompt(
 #endif
     for( bool stop = false; !stop; ) {
         ui_manager::redraw();
-        switch( inp_mngr.get_input_event().get_first_input() ) {
+        input_event evt;
+        try {
+            evt = session_replay::get_input_event( keyboard_mode::keycode );
+        } catch( const session_replay::replay_finished & ) {
+            // Debug messages can come from anywhere, even destructors, so the replay only
+            // ends at the next input outside of this prompt.
+            break;
+        }
+        switch( evt.get_first_input() ) {
 #if defined(TILES)
             case 'c':
             case 'C':
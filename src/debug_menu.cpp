@@ -92,6 +92,7 @@
 #include "pimpl.h"
 #include "point.h"
 #include "popup.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "relic.h"
 #include "rng.h"
@@ -212,6 +213,7 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::SAVE_SCREENSHOT: return "SAVE_SCREENSHOT";
         case debug_menu::debug_menu_index::GAME_REPORT: return "GAME_REPORT";
         case debug_menu::debug_menu_index::GAME_MIN_ARCHIVE: return "GAME_MIN_ARCHIVE";
+        case debug_menu::debug_menu_index::EXPORT_PROFILE: return "EXPORT_PROFILE";
         case debug_menu::debug_menu_index::DISPLAY_SCENTS_LOCAL: return "DISPLAY_SCENTS_LOCAL";
         case debug_menu::debug_menu_index::DISPLAY_SCENTS_TYPE_LOCAL: return "DISPLAY_SCENTS_TYPE_LOCAL";
         case debug_menu::debug_menu_index::DISPLAY_TEMP: return "DISPLAY_TEMP";
@@ -440,6 +442,7 @@ static int info_uilist( bool display_all_entries = true )
         { uilist_entry( debug_menu_index::SAVE_SCREENSHOT, true, 'H', _( "Take screenshot" ) ) },
         { uilist_entry( debug_menu_index::GAME_REPORT, true, 'r', _( "Generate game report" ) ) },
         { uilist_entry( debug_menu_index::GAME_MIN_ARCHIVE, true, '!', _( "Generate minimized save archive" ) ) },
+        { uilist_entry( debug_menu_index::EXPORT_PROFILE, profiler::compiled_in(), 'P', _( "Export profiler trace" ) ) },
     };
 
     if( display_all_entries ) {
@@ -2627,6 +2630,7 @@ void debug()
         debug_menu_index::SAVE_SCREENSHOT,
         debug_menu_index::GAME_REPORT,
         debug_menu_index::GAME_MIN_ARCHIVE,
+        debug_menu_index::EXPORT_PROFILE,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::UNLOCK_ALL,
         debug_menu_index::BENCHMARK,
@@ -3291,6 +3295,14 @@ void debug()
             write_min_archive();
             break;
         }
+        case debug_menu_index::EXPORT_PROFILE: {
+            const std::string path = PATH_INFO::user_dir() + "profile.json";
+            const size_t zones = profiler::recorded_zones();
+            if( profiler::export_chrome_trace( path ) ) {
+                popup( _( "%d profiled zones written to %s" ), zones, path );
+            }
+            break;
+        }
         case debug_menu_index::CHANGE_SPELLS:
             change_spells( player_character );
             break;
@@ -79,6 +79,7 @@ enum class debug_menu_index : int {
     SAVE_SCREENSHOT,
     GAME_REPORT,
     GAME_MIN_ARCHIVE,
+    EXPORT_PROFILE,
     DISPLAY_SCENTS_LOCAL,
     DISPLAY_SCENTS_TYPE_LOCAL,
     DISPLAY_TEMP,
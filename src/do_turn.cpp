@@ -22,12 +22,15 @@
 #include "mtype.h"
 #include "music.h"
 #include "npc.h"
+#include "npc_ai_blackboard.h"
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "popup.h"
+#include "profiler.h"
 #include "scent_map.h"
 #include "sdlsound.h"
+#include "session_replay.h"
 #include "string_input_popup.h"
 #include "stats_tracker.h"
 #include "timed_event.h"
@@ -221,6 +224,7 @@ namespace
 {
 void monmove()
 {
+    CATA_PROFILE_ZONE( "monmove" );
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
@@ -306,7 +310,13 @@ void monmove()
     }
 
     // Now, do active NPCs.
+    npc_ai_blackboard &blackboard = get_npc_ai_blackboard();
+    // The player and the monsters have moved, forget what the NPCs saw last time.
+    blackboard.invalidate();
+    blackboard.start_ai_turn( std::chrono::microseconds( get_option<int>( "NPC_AI_BUDGET" ) ) );
     for( npc &guy : g->all_npcs() ) {
+        const auto ai_start = std::chrono::steady_clock::now();
+        bool deferred = false;
         int turns = 0;
         int real_count = 0;
         const int count_limit = std::max( 10, guy.moves / 64 );
@@ -321,7 +331,12 @@ void monmove()
                guy.moves > 0 && turns < 10 ) {
             const int moves = guy.moves;
             const bool has_destination = guy.has_destination_activity();
-            guy.move();
+            // Over budget, NPCs that don't need to think right now keep doing what they did.
+            if( blackboard.ai_over_budget() && !guy.ai_is_urgent() && guy.reuse_last_plan() ) {
+                deferred = true;
+            } else {
+                guy.move();
+            }
             if( moves == guy.moves ) {
                 // Count every time we exit npc::move() without spending any moves.
                 real_count++;
@@ -355,12 +370,19 @@ void monmove()
         if( !guy.is_dead() ) {
             guy.npc_update_body();
         }
+        if( deferred ) {
+            blackboard.record_deferred_ai( guy );
+        }
+        blackboard.record_ai_time( guy, std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - ai_start ) );
     }
+    blackboard.report_ai_time();
     g->cleanup_dead();
 }
 
 void overmap_npc_move()
 {
+    CATA_PROFILE_ZONE( "overmap_npc_move" );
     avatar &u = get_avatar();
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
@@ -606,9 +628,18 @@ bool do_turn()
     m.build_floor_caches();
 
     m.process_falling();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
+    {
+        session_replay::stage_timer timer( session_replay::turn_stage::vehmove );
+        m.vehmove();
+    }
+    {
+        session_replay::stage_timer timer( session_replay::turn_stage::process_fields );
+        m.process_fields();
+    }
+    {
+        session_replay::stage_timer timer( session_replay::turn_stage::process_items );
+        m.process_items();
+    }
     explosion_handler::process_explosions();
     m.creature_in_field( u );
 
@@ -617,8 +648,16 @@ bool do_turn()
     const int levz = m.get_abs_sub().z();
     // Update vision caches for monsters. If this turns out to be expensive,
     // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
-    monmove();
+    {
+        session_replay::stage_timer timer( session_replay::turn_stage::build_map_cache );
+        m.build_map_cache( levz, true );
+    }
+    get_creature_tracker().reset_visibility();
+    get_creature_tracker().refresh_monster_factions();
+    {
+        session_replay::stage_timer timer( session_replay::turn_stage::monmove );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
         overmap_npc_move();
     }
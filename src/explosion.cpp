@@ -5,14 +5,13 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
-#include <queue>
 #include <random>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -49,6 +48,7 @@
 #include "npc.h"
 #include "options.h"
 #include "point.h"
+#include "profiler.h"
 #include "projectile.h"
 #include "rng.h"
 #include "shadowcasting.h"
@@ -156,6 +156,180 @@ static float gurney_spherical( const double charge, const double mass )
                                          -0.5 ) * TYPICAL_GURNEY_CONSTANT );
 }
 
+namespace
+{
+
+// What do_blast knows about a single tile of the reality bubble.
+struct blast_cell {
+    // The blast this cell belongs to, cells of older blasts count as untouched.
+    uint32_t generation = 0;
+    // Shortest known distance from the center of the blast.
+    float dist = 0.0f;
+    bool closed = false;
+    bool bashed = false;
+
+    // The batch of explosions the fields below belong to, see blast_cache::hit.
+    uint32_t batch = 0;
+    // Summed force of the blasts of the batch that reached the tile, with and without fire.
+    float force = 0.0f;
+    float fire_force = 0.0f;
+    // Force and source of the strongest of those blasts, which gets the blame.
+    float strongest = 0.0f;
+    const Creature *source = nullptr;
+};
+
+struct blast_layer {
+    std::array<blast_cell, MAPSIZE_X *MAPSIZE_Y> cells;
+};
+
+/**
+ * Scratch space of do_blast, kept around between explosions so that chained explosions
+ * don't allocate.
+ * Instead of clearing the cells at the start of each blast, each blast gets a new generation
+ * and cells stamped with an older generation are treated as untouched.
+ * The open tiles are kept in buckets of one tile of distance. All neighbors of a tile are at
+ * least one tile farther away, so a bucket is only sorted once, when the blast reaches it.
+ *
+ * Explosions that go off together form a batch. Each blast of a batch spreads on its own, but
+ * the force reaching a tile is summed up over the batch and applied once, see apply_blasts.
+ */
+class blast_cache
+{
+    public:
+        using entry = std::pair<float, tripoint>;
+
+        void start_batch() {
+            batch++;
+            if( batch == 0 ) {
+                // Wrapped around, cells of ancient batches would look current.
+                for_each_cell( []( blast_cell & cell ) {
+                    cell.batch = 0;
+                } );
+                batch = 1;
+            }
+            hit_points.clear();
+        }
+
+        void start() {
+            generation++;
+            if( generation == 0 ) {
+                for_each_cell( []( blast_cell & cell ) {
+                    cell.generation = 0;
+                } );
+                generation = 1;
+            }
+            for( std::vector<entry> &bucket : buckets ) {
+                bucket.clear();
+            }
+            current = 0;
+            current_sorted = false;
+            closed_points.clear();
+        }
+
+        // p must be inbounds
+        blast_cell &cell( const tripoint &p ) {
+            blast_cell &ret = raw_cell( p );
+            if( ret.generation != generation ) {
+                ret.generation = generation;
+                ret.dist = std::numeric_limits<float>::max();
+                ret.closed = false;
+                ret.bashed = false;
+            }
+            return ret;
+        }
+
+        // The force that reached p during the current batch, p must be inbounds
+        blast_cell &hit( const tripoint &p ) {
+            blast_cell &ret = raw_cell( p );
+            if( ret.batch != batch ) {
+                ret.batch = batch;
+                ret.force = 0.0f;
+                ret.fire_force = 0.0f;
+                ret.strongest = 0.0f;
+                ret.source = nullptr;
+                hit_points.push_back( p );
+            }
+            return ret;
+        }
+
+        void push( const float dist, const tripoint &p ) {
+            const size_t index = std::max( static_cast<size_t>( dist ), current );
+            if( index >= buckets.size() ) {
+                buckets.resize( index + 1 );
+            }
+            std::vector<entry> &bucket = buckets[index];
+            if( index == current && current_sorted ) {
+                // Shouldn't happen, but keep the bucket that is being emptied sorted.
+                const entry e( dist, p );
+                bucket.insert( std::upper_bound( bucket.begin(), bucket.end(), e,
+                                                 pair_greater_cmp_first() ), e );
+            } else {
+                bucket.emplace_back( dist, p );
+            }
+        }
+
+        // Takes the open tile that is closest to the center.
+        bool pop( entry &next ) {
+            while( current < buckets.size() ) {
+                std::vector<entry> &bucket = buckets[current];
+                if( !bucket.empty() ) {
+                    if( !current_sorted ) {
+                        // Farthest first, so the closest can be popped from the back.
+                        std::sort( bucket.begin(), bucket.end(), pair_greater_cmp_first() );
+                        current_sorted = true;
+                    }
+                    next = bucket.back();
+                    bucket.pop_back();
+                    return true;
+                }
+                current++;
+                current_sorted = false;
+            }
+            return false;
+        }
+
+        // Tiles closed by the current blast, in the order they were closed.
+        std::vector<tripoint> closed_points;
+        // Tiles reached by any blast of the current batch.
+        std::vector<tripoint> hit_points;
+
+    private:
+        blast_cell &raw_cell( const tripoint &p ) {
+            std::unique_ptr<blast_layer> &layer = layers[p.z + OVERMAP_DEPTH];
+            if( !layer ) {
+                layer = std::make_unique<blast_layer>();
+            }
+            return layer->cells[p.x * MAPSIZE_Y + p.y];
+        }
+
+        template<typename F>
+        void for_each_cell( F f ) {
+            for( std::unique_ptr<blast_layer> &layer : layers ) {
+                if( layer ) {
+                    for( blast_cell &cell : layer->cells ) {
+                        f( cell );
+                    }
+                }
+            }
+        }
+
+        uint32_t generation = 0;
+        uint32_t batch = 0;
+        std::array<std::unique_ptr<blast_layer>, OVERMAP_LAYERS> layers;
+        std::vector<std::vector<entry>> buckets;
+        size_t current = 0;
+        bool current_sorted = false;
+};
+
+// do_blast is not reentrant, explosions caused by the blast are queued.
+blast_cache &get_blast_cache()
+{
+    static blast_cache blast;
+    return blast;
+}
+
+} // namespace
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
 static void do_blast( const Creature *source, const tripoint &p, const float power,
                       const float distance_factor, const bool fire )
@@ -175,25 +349,32 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
 
     here.bash( p, fire ? power : ( 2 * power ), true, false, false );
 
-    std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::set<tripoint> closed;
-    std::set<tripoint> bashed{ p };
-    std::map<tripoint, float> dist_map;
-    open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
+    if( !here.inbounds( p ) ) {
+        return;
+    }
+
+    blast_cache &blast = get_blast_cache();
+    blast.start();
+    const auto is_closed = [&]( const tripoint & pt ) {
+        return here.inbounds( pt ) && blast.cell( pt ).closed;
+    };
+    blast.cell( p ).bashed = true;
+    blast.cell( p ).dist = 0.0f;
+    blast.push( 0.0f, p );
+    blast_cache::entry next;
     // Find all points to blast
-    while( !open.empty() ) {
+    while( blast.pop( next ) ) {
         // Add some random factor to effective distance to make it look cooler
-        const float distance = open.top().first * rng_float( 1.0f, 1.2f );
-        const tripoint pt = open.top().second;
-        open.pop();
+        const float distance = next.first * rng_float( 1.0f, 1.2f );
+        const tripoint pt = next.second;
 
-        if( closed.count( pt ) != 0 ) {
+        blast_cell &pt_cell = blast.cell( pt );
+        if( pt_cell.closed ) {
             continue;
         }
 
-        closed.insert( pt );
+        pt_cell.closed = true;
+        blast.closed_points.push_back( pt );
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -210,7 +391,7 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
         int empty_neighbors = 0;
         for( size_t i = 0; i < 8; i++ ) {
             tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) == 0 && here.valid_move( pt, dest, false, true ) ) {
+            if( !is_closed( dest ) && here.valid_move( pt, dest, false, true ) ) {
                 empty_neighbors++;
             }
         }
@@ -219,12 +400,16 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
         // Iterate over all neighbors. Bash all of them, propagate to some
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !here.inbounds( dest ) ) {
+            if( !here.inbounds( dest ) ) {
+                continue;
+            }
+            blast_cell &dest_cell = blast.cell( dest );
+            if( dest_cell.closed ) {
                 continue;
             }
 
-            if( bashed.count( dest ) == 0 ) {
-                bashed.insert( dest );
+            if( !dest_cell.bashed ) {
+                dest_cell.bashed = true;
                 // Up to 200% bonus for shaped charge
                 // But not if the explosion is fiery, then only half the force and no bonus
                 const float bash_force = !fire ?
@@ -253,21 +438,46 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
-                open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+            if( dest_cell.dist > next_dist ) {
+                blast.push( next_dist, dest );
+                dest_cell.dist = next_dist;
             }
         }
     }
 
+    // The damage is done once all blasts of the batch are known, see apply_blasts.
+    for( const tripoint &pt : blast.closed_points ) {
+        const float force = power * std::pow( distance_factor, blast.cell( pt ).dist );
+        blast_cell &hit = blast.hit( pt );
+        ( fire ? hit.fire_force : hit.force ) += force;
+        if( force > hit.strongest ) {
+            hit.strongest = force;
+            hit.source = source;
+        }
+    }
+}
+
+// Draws and applies the summed force of the blasts of the current batch.
+static void apply_blasts()
+{
+    map &here = get_map();
+    blast_cache &blast = get_blast_cache();
+    // Same order as the std::set of closed tiles a single blast used to have
+    std::vector<tripoint> &hit_points = blast.hit_points;
+    if( hit_points.empty() ) {
+        return;
+    }
+    std::sort( hit_points.begin(), hit_points.end() );
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( const tripoint &pt : closed ) {
+    for( const tripoint &pt : hit_points ) {
         if( here.impassable( pt ) ) {
             continue;
         }
 
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const blast_cell &hit = blast.hit( pt );
+        const float force = hit.force + hit.fire_force;
         nc_color col = c_red;
         if( force < 10 ) {
             col = c_white;
@@ -281,9 +491,9 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
     draw_custom_explosion( get_player_character().pos(), explosion_colors );
 
     creature_tracker &creatures = get_creature_tracker();
-    Creature *mutable_source = source == nullptr ? nullptr : creatures.creature_at( source->pos() );
-    for( const tripoint &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+    for( const tripoint &pt : hit_points ) {
+        const blast_cell &hit = blast.hit( pt );
+        const float force = hit.force + hit.fire_force;
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -293,18 +503,27 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
             here.smash_items( pt, force, _( "force of the explosion" ) );
         }
 
-        if( fire ) {
-            int intensity = ( force > 50.0f ) + ( force > 100.0f );
-            if( force > 10.0f || x_in_y( force, 10.0f ) ) {
+        if( hit.fire_force >= 1.0f ) {
+            const float fire_force = hit.fire_force;
+            int intensity = ( fire_force > 50.0f ) + ( fire_force > 100.0f );
+            if( fire_force > 10.0f || x_in_y( fire_force, 10.0f ) ) {
                 intensity++;
             }
             here.add_field( pt, fd_fire, intensity );
         }
 
-        if( const optional_vpart_position vp = here.veh_at( pt ) ) {
-            // TODO: Make this weird unit used by vehicle::damage more sensible
-            vp->vehicle().damage( here, vp->part_index(), force,
-                                  fire ? damage_type::HEAT : damage_type::BASH, false );
+        for( const std::pair<float, damage_type> &veh_dmg : {
+                 std::make_pair( hit.force, damage_type::BASH ),
+                 std::make_pair( hit.fire_force, damage_type::HEAT )
+             } ) {
+            if( veh_dmg.first <= 0.0f ) {
+                continue;
+            }
+            if( const optional_vpart_position vp = here.veh_at( pt ) ) {
+                // TODO: Make this weird unit used by vehicle::damage more sensible
+                vp->vehicle().damage( here, vp->part_index(), veh_dmg.first, veh_dmg.second,
+                                      false );
+            }
         }
 
         Creature *critter = creatures.creature_at( pt, true );
@@ -315,6 +534,8 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
         add_msg_debug( debugmode::DF_EXPLOSION, "Blast hits %s with force %.1f", critter->disp_name(),
                        force );
 
+        Creature *mutable_source = hit.source == nullptr ? nullptr :
+                                   creatures.creature_at( hit.source->pos() );
         Character *pl = critter->as_character();
         if( pl == nullptr ) {
             const double dmg = std::max( force - critter->get_armor_bash( bodypart_id( "torso" ) ) / 2.0, 0.0 );
@@ -365,8 +586,34 @@ static void do_blast( const Creature *source, const tripoint &p, const float pow
     }
 }
 
+// How far the fragments of an explosive can fly, even with nothing but air in their way.
+// Also sets fragment_mass and fragment_area, which shrapnel_calc depends on.
+static int shrapnel_range( int power, int casing_mass, float per_fragment_mass )
+{
+    const float fragment_velocity = gurney_spherical( power, casing_mass );
+    fragment_mass = per_fragment_mass;
+    fragment_area = mass_to_area( fragment_mass );
+    const int fragment_count = casing_mass / fragment_mass;
+    // At most all fragments make it past the origin, see shrapnel().
+    const fragment_cloud initial( fragment_velocity, fragment_count );
+    // Past the first tile the fragments have been slowed down by at least air
+    // and none have been added, see accumulate_fragment_cloud.
+    const fragment_cloud clear_path( FRAGMENT_AIR_DRAG, 1.0f );
+    int range = 1;
+    // Fragments only get slower and sparser, so the first tile they can't reach ends it.
+    while( range < SHADOWCASTING_MAX_DISTANCE &&
+           shrapnel_check( clear_path, shrapnel_calc( initial, clear_path, range + 1 ) ) ) {
+        range++;
+    }
+    return range;
+}
+
+// obstacle_cache has to be built for the z-level of src, at least within range of it,
+// see map::build_obstacle_cache and shrapnel_range.
 static std::vector<tripoint> shrapnel( const Creature *source, const tripoint &src, int power,
-                                       int casing_mass, float per_fragment_mass, int range = -1 )
+                                       int casing_mass, float per_fragment_mass,
+                                       const cata::mdarray<fragment_cloud, point_bub_ms>
+                                       &obstacle_cache, int range )
 {
     // The gurney equation wants the total mass of the casing.
     const float fragment_velocity = gurney_spherical( power, casing_mass );
@@ -382,22 +629,16 @@ static std::vector<tripoint> shrapnel( const Creature *source, const tripoint &s
     proj.range = range;
     proj.proj_effects.insert( "NULL_SOURCE" );
 
-    struct local_caches {
-        cata::mdarray<fragment_cloud, point_bub_ms> obstacle_cache;
-        cata::mdarray<fragment_cloud, point_bub_ms> visited_cache;
-    };
-
-    std::unique_ptr<local_caches> caches = std::make_unique<local_caches>();
-    cata::mdarray<fragment_cloud, point_bub_ms> &obstacle_cache = caches->obstacle_cache;
-    cata::mdarray<fragment_cloud, point_bub_ms> &visited_cache = caches->visited_cache;
+    // Kept between explosions, shadowcasting only touches the tiles in range, which are reset.
+    static std::unique_ptr<cata::mdarray<fragment_cloud, point_bub_ms>> visited_cache_ptr =
+                std::make_unique<cata::mdarray<fragment_cloud, point_bub_ms>>();
+    cata::mdarray<fragment_cloud, point_bub_ms> &visited_cache = *visited_cache_ptr;
 
     map &here = get_map();
-    // TODO: Calculate range based on max effective range for projectiles.
-    // Basically bisect between 0 and map diameter using shrapnel_calc().
-    // Need to update shadowcasting to support limiting range without adjusting initial distance.
-    const tripoint_range<tripoint> area = here.points_on_zlevel( src.z );
-
-    here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east, obstacle_cache );
+    const tripoint_range<tripoint> area = here.points_in_radius( src, range );
+    for( const tripoint &target : area ) {
+        visited_cache[target.x][target.y] = fragment_cloud();
+    }
 
     // Shadowcasting normally ignores the origin square,
     // so apply it manually to catch monsters standing on the explosive.
@@ -408,7 +649,7 @@ static std::vector<tripoint> shrapnel( const Creature *source, const tripoint &s
 
     castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
                  update_fragment_cloud, accumulate_fragment_cloud>
-                 ( visited_cache, obstacle_cache, src.xy(), 0, initial_cloud );
+                 ( visited_cache, obstacle_cache, src.xy(), 0, initial_cloud, range );
 
     creature_tracker &creatures = get_creature_tracker();
     Creature *mutable_source = source == nullptr ? nullptr : creatures.creature_at( source->pos() );
@@ -486,7 +727,7 @@ void explosion( const Creature *source, const tripoint &p, const explosion_data
     _explosions.emplace_back( source, get_map().getglobal( p ), ex );
 }
 
-void _make_explosion( const Creature *source, const tripoint &p, const explosion_data &ex )
+static void explosion_sound( const tripoint &p, const explosion_data &ex )
 {
     int noise = ex.power * ( ex.fire ? 2 : 10 );
     noise = ( noise > ex.max_noise ) ? ex.max_noise : noise;
@@ -499,44 +740,125 @@ void _make_explosion( const Creature *source, const tripoint &p, const explosion
     } else if( noise > 0 ) {
         sounds::sound( p, 3, sounds::sound_t::combat, _( "a loud pop!" ), false, "explosion", "small" );
     }
+}
 
-    if( ex.distance_factor >= 1.0f ) {
-        debugmsg( "called game::explosion with factor >= 1.0 (infinite size)" );
-    } else if( ex.distance_factor > 0.0f && ex.power > 0.0f ) {
-        // Power rescaled to mean grams of TNT equivalent, this scales it roughly back to where
-        // it was before until we re-do blasting power to be based on TNT-equivalent directly.
-        do_blast( source, p, ex.power / 15.0, ex.distance_factor, ex.fire );
+static void drop_shrapnel( const shrapnel_data &shr,
+                           const std::vector<tripoint> &shrapnel_locations )
+{
+    map &here = get_map();
+    // Extract only passable tiles affected by shrapnel
+    std::vector<tripoint> tiles;
+    for( const tripoint &e : shrapnel_locations ) {
+        if( here.passable( e ) ) {
+            tiles.push_back( e );
+        }
+    }
+    const itype *fragment_drop = item_controller->find_template( shr.drop );
+    int qty = shr.casing_mass * std::min( 1.0, shr.recovery / 100.0 ) /
+              to_gram( fragment_drop->weight );
+    // Truncate to a random selection
+    std::shuffle( tiles.begin(), tiles.end(), rng_get_engine() );
+    tiles.resize( std::min( static_cast<int>( tiles.size() ), qty ) );
+
+    for( const tripoint &e : tiles ) {
+        here.add_item_or_charges( e, item( shr.drop, calendar::turn, item::solitary_tag{} ) );
     }
+}
 
+/**
+ * Resolves explosions that go off at the same time together.
+ * The blasts spread one after another, but the damage of all of them is applied once per tile,
+ * with their forces summed up. Then the shrapnel flies, with the obstacles of each z-level
+ * looked up once for all explosions on it.
+ */
+static void make_explosions( const std::vector<queued_explosion> &batch )
+{
     map &here = get_map();
-    const shrapnel_data &shr = ex.shrapnel;
-    if( shr.casing_mass > 0 ) {
-        auto shrapnel_locations = shrapnel( source, p, ex.power, shr.casing_mass, shr.fragment_mass );
+    std::vector<std::pair<tripoint, const queued_explosion *>> explosions;
+    explosions.reserve( batch.size() );
+    for( const queued_explosion &ex : batch ) {
+        const tripoint p = here.getlocal( ex.pos );
+        if( p.x < 0 || p.x >= MAPSIZE_X || p.y < 0 || p.y >= MAPSIZE_Y ) {
+            debugmsg( "Explosion origin (%d, %d, %d) is out-of-bounds", p.x, p.y, p.z );
+            continue;
+        }
+        explosions.emplace_back( p, &ex );
+    }
 
-        // If explosion drops shrapnel...
-        if( shr.recovery > 0 && !shr.drop.is_null() ) {
+    get_blast_cache().start_batch();
+    for( const std::pair<tripoint, const queued_explosion *> &explosion : explosions ) {
+        const tripoint &p = explosion.first;
+        const explosion_data &ex = explosion.second->data;
+        explosion_sound( p, ex );
+        if( ex.distance_factor >= 1.0f ) {
+            debugmsg( "called game::explosion with factor >= 1.0 (infinite size)" );
+        } else if( ex.distance_factor > 0.0f && ex.power > 0.0f ) {
+            // Power rescaled to mean grams of TNT equivalent, this scales it roughly back to where
+            // it was before until we re-do blasting power to be based on TNT-equivalent directly.
+            do_blast( explosion.second->source, p, ex.power / 15.0, ex.distance_factor, ex.fire );
+        }
+    }
+    apply_blasts();
 
-            // Extract only passable tiles affected by shrapnel
-            std::vector<tripoint> tiles;
-            for( const tripoint &e : shrapnel_locations ) {
-                if( here.passable( e ) ) {
-                    tiles.push_back( e );
-                }
-            }
-            const itype *fragment_drop = item_controller->find_template( shr.drop );
-            int qty = shr.casing_mass * std::min( 1.0, shr.recovery / 100.0 ) /
-                      to_gram( fragment_drop->weight );
-            // Truncate to a random selection
-            std::shuffle( tiles.begin(), tiles.end(), rng_get_engine() );
-            tiles.resize( std::min( static_cast<int>( tiles.size() ), qty ) );
+    // The obstacles of each z-level are only needed within range of the explosions on it.
+    struct shrapnel_level {
+        std::optional<std::pair<tripoint, tripoint>> bounds;
+        std::unique_ptr<cata::mdarray<fragment_cloud, point_bub_ms>> obstacle_cache;
+    };
+    // indexed by z-level + OVERMAP_DEPTH
+    std::array<shrapnel_level, OVERMAP_LAYERS> levels;
+    std::vector<int> ranges( explosions.size(), 0 );
+    for( size_t i = 0; i < explosions.size(); i++ ) {
+        const tripoint &p = explosions[i].first;
+        const shrapnel_data &shr = explosions[i].second->data.shrapnel;
+        if( shr.casing_mass <= 0 || !here.inbounds_z( p.z ) ) {
+            continue;
+        }
+        ranges[i] = shrapnel_range( explosions[i].second->data.power, shr.casing_mass,
+                                    shr.fragment_mass );
+        const tripoint_range<tripoint> area = here.points_in_radius( p, ranges[i] );
+        std::optional<std::pair<tripoint, tripoint>> &bounds = levels[p.z + OVERMAP_DEPTH].bounds;
+        if( !bounds ) {
+            bounds.emplace( area.min(), area.max() );
+        } else {
+            bounds->first.x = std::min( bounds->first.x, area.min().x );
+            bounds->first.y = std::min( bounds->first.y, area.min().y );
+            bounds->second.x = std::max( bounds->second.x, area.max().x );
+            bounds->second.y = std::max( bounds->second.y, area.max().y );
+        }
+    }
+    for( shrapnel_level &level : levels ) {
+        if( level.bounds ) {
+            level.obstacle_cache = std::make_unique<cata::mdarray<fragment_cloud, point_bub_ms>>();
+            here.build_obstacle_cache( level.bounds->first,
+                                       level.bounds->second + tripoint_south_east,
+                                       *level.obstacle_cache );
+        }
+    }
 
-            for( const tripoint &e : tiles ) {
-                here.add_item_or_charges( e, item( shr.drop, calendar::turn, item::solitary_tag{} ) );
-            }
+    for( size_t i = 0; i < explosions.size(); i++ ) {
+        const tripoint &p = explosions[i].first;
+        const explosion_data &ex = explosions[i].second->data;
+        const shrapnel_data &shr = ex.shrapnel;
+        if( shr.casing_mass <= 0 || !here.inbounds_z( p.z ) ) {
+            continue;
+        }
+        const std::vector<tripoint> shrapnel_locations = shrapnel( explosions[i].second->source, p,
+                ex.power, shr.casing_mass, shr.fragment_mass,
+                *levels[p.z + OVERMAP_DEPTH].obstacle_cache, ranges[i] );
+
+        // If explosion drops shrapnel...
+        if( shr.recovery > 0 && !shr.drop.is_null() ) {
+            drop_shrapnel( shr, shrapnel_locations );
         }
     }
 }
 
+void _make_explosion( const Creature *source, const tripoint &p, const explosion_data &ex )
+{
+    make_explosions( { queued_explosion( source, get_map().getglobal( p ), ex ) } );
+}
+
 void flashbang( const tripoint &p, bool player_immune )
 {
     draw_explosion( p, 8, c_white );
@@ -888,15 +1210,20 @@ void resonance_cascade( const tripoint &p )
 
 void process_explosions()
 {
-    for( const queued_explosion &ex : _explosions ) {
-        const tripoint p = get_map().getlocal( ex.pos );
-        if( p.x < 0 || p.x >= MAPSIZE_X || p.y < 0 || p.y >= MAPSIZE_Y ) {
-            debugmsg( "Explosion origin (%d, %d, %d) is out-of-bounds", p.x, p.y, p.z );
-            continue;
-        }
-        _make_explosion( ex.source, p, ex.data );
+    CATA_PROFILE_ZONE( "explosion_handler::process_explosions" );
+    // Explosions set off by a batch, like fuel tanks caught in the blast, are queued and go
+    // off as the next batch. Explosions setting each other off forever are cut short.
+    constexpr int max_chained_batches = 100;
+    for( int i = 0; i < max_chained_batches && !_explosions.empty(); i++ ) {
+        std::vector<queued_explosion> batch;
+        batch.swap( _explosions );
+        make_explosions( batch );
+    }
+    if( !_explosions.empty() ) {
+        debugmsg( "%d explosions are still set off by each other after %d batches, dropping them",
+                  _explosions.size(), max_chained_batches );
+        _explosions.clear();
     }
-    _explosions.clear();
 }
 
 } // namespace explosion_handler
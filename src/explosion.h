@@ -101,6 +101,7 @@ void draw_explosion( const tripoint &p, int radius, const nc_color &col );
 void draw_custom_explosion( const tripoint &p, const std::map<tripoint, nc_color> &area,
                             const std::optional<std::string> &tile_id = std::nullopt );
 
+/** Sets off all queued explosions at once, then those they set off in turn. */
 void process_explosions();
 } // namespace explosion_handler
 
@@ -1,6 +1,7 @@
 #include "flag.h"
 
 #include "debug.h"
+#include "flag_bitset.h"
 #include "generic_factory.h"
 #include "json.h"
 #include "type_id.h"
@@ -367,6 +368,8 @@ const flag_id flag_NULL = json_flag_null; // intentionally invalid flag
 namespace
 {
 generic_factory<json_flag> json_flags_all( "json_flags" );
+// dense flag indices are only handed out after the flags were finalized
+bool json_flags_finalized = false;
 } // namespace
 
 /** @relates string_id */
@@ -415,6 +418,7 @@ void json_flag::check_consistency()
 
 void json_flag::reset()
 {
+    json_flags_finalized = false;
     json_flags_all.reset();
 }
 
@@ -436,6 +440,29 @@ void json_flag::check() const
 void json_flag::finalize_all()
 {
     json_flags_all.finalize();
+    // the dense index of a flag is its position in the factory, which is fixed from now on
+    json_flags_finalized = true;
+}
+
+int flag_dense_index( const flag_id &flag )
+{
+    if( !json_flags_finalized ) {
+        return -1;
+    }
+    const int index = json_flags_all.convert( flag, int_id<json_flag>( -1 ), false ).to_i();
+    return index < max_dense_flags ? index : -1;
+}
+
+flag_bitset dense_flag_bits( const std::set<flag_id> &flags )
+{
+    flag_bitset ret;
+    for( const flag_id &f : flags ) {
+        const int index = flag_dense_index( f );
+        if( index >= 0 ) {
+            ret.set( index );
+        }
+    }
+    return ret;
 }
 
 bool json_flag::is_ready()
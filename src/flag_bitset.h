@@ -0,0 +1,30 @@
+#pragma once
+#ifndef CATA_SRC_FLAG_BITSET_H
+#define CATA_SRC_FLAG_BITSET_H
+
+#include <bitset>
+#include <set>
+
+#include "type_id.h"
+
+/**
+ * Number of flags that get a dense index, see @ref flag_dense_index.
+ * Flags beyond this (only possible with lots of mods) are stored in the sets of flag ids only.
+ */
+constexpr int max_dense_flags = 512;
+
+/** Set of item flags by their dense index, allows checking flags with a few word operations. */
+using flag_bitset = std::bitset<max_dense_flags>;
+
+/**
+ * Returns the dense index of the flag, or -1 if it does not have one.
+ * Indices are assigned when the flags are finalized (@ref json_flag::finalize_all), before that
+ * and for invalid flags this always returns -1. Callers must fall back to the set of flag ids
+ * in that case.
+ */
+int flag_dense_index( const flag_id &flag );
+
+/** Returns the bits of all flags in @p flags that have a dense index. */
+flag_bitset dense_flag_bits( const std::set<flag_id> &flags );
+
+#endif // CATA_SRC_FLAG_BITSET_H
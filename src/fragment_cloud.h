@@ -3,6 +3,11 @@
 #define CATA_SRC_FRAGMENT_CLOUD_H
 
 enum class quadrant : int;
+
+// Drag of a tile of open air, the least any tile slows down fragments.
+// See map::build_obstacle_cache.
+constexpr float FRAGMENT_AIR_DRAG = 1.2f;
+
 /*
  * fragment_cloud represents the density and velocity of fragments passing through a square.
  */
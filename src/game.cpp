@@ -133,6 +133,7 @@
 #include "move_mode.h"
 #include "mtype.h"
 #include "npc.h"
+#include "npc_ai_blackboard.h"
 #include "npctrade.h"
 #include "npc_class.h"
 #include "omdata.h"
@@ -149,6 +150,7 @@
 #include "player_activity.h"
 #include "popup.h"
 #include "profession.h"
+#include "profiler.h"
 #include "recipe.h"
 #include "recipe_dictionary.h"
 #include "ret_val.h"
@@ -760,6 +762,7 @@ void game::setup()
     achievements_tracker_ptr->clear();
     // reset follower list
     follower_ids.clear();
+    npc_ai_blackboard_ptr->invalidate();
     scent.reset();
     effect_on_conditions::clear( u );
     u.character_mood_face( true );
@@ -1661,12 +1664,14 @@ void game::add_npc_follower( const character_id &id )
 {
     follower_ids.insert( id );
     u.follower_ids.insert( id );
+    npc_ai_blackboard_ptr->invalidate();
 }
 
 void game::remove_npc_follower( const character_id &id )
 {
     follower_ids.erase( id );
     u.follower_ids.erase( id );
+    npc_ai_blackboard_ptr->invalidate();
 }
 
 static void update_faction_api( npc *guy )
@@ -2976,6 +2981,7 @@ bool game::load( const std::string &world )
 
 bool game::load( const save_t &name )
 {
+    CATA_PROFILE_ZONE( "game::load" );
     background_pane background;
     static_popup popup;
     popup.message( "%s", _( "Please wait…\nLoading the save…" ) );
@@ -3698,6 +3704,7 @@ static shared_ptr_fast<game::draw_callback_t> create_trail_callback(
 
 void game::draw( ui_adaptor &ui )
 {
+    CATA_PROFILE_ZONE( "game::draw" );
     if( test_mode ) {
         return;
     }
@@ -3731,6 +3738,7 @@ void game::draw( ui_adaptor &ui )
 
 void game::draw_panels( bool force_draw )
 {
+    CATA_PROFILE_ZONE( "game::draw_panels" );
     static int previous_turn = -1;
     const int current_turn = to_turns<int>( calendar::turn - calendar::turn_zero );
     const bool draw_this_turn = current_turn > previous_turn || force_draw;
@@ -3855,6 +3863,7 @@ void game::draw_ter( const bool draw_sounds )
 
 void game::draw_ter( const tripoint &center, const bool looking, const bool draw_sounds )
 {
+    CATA_PROFILE_ZONE( "game::draw_ter" );
     ter_view_p = center;
 
     m.draw( w_terrain, center );
@@ -4315,6 +4324,7 @@ std::vector<monster *> game::get_fishable_monsters( std::unordered_set<tripoint>
 
 void game::mon_info_update( )
 {
+    CATA_PROFILE_ZONE( "game::mon_info_update" );
     int newseen = 0;
     const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
     const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
@@ -7009,6 +7019,7 @@ void game::zones_manager()
                         }
                         break;
                     case 3:
+                        mgr.zone_edited( zone );
                         if( zone.get_options().query() ) {
                             stuff_changed = true;
                         }
@@ -12418,6 +12429,7 @@ void game::quickload()
 
 void game::autosave()
 {
+    CATA_PROFILE_ZONE( "game::autosave" );
     //Don't autosave if the min-autosave interval has not passed since the last autosave/quicksave.
     if( std::time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
         return;
@@ -12881,6 +12893,11 @@ creature_tracker &get_creature_tracker()
     return *g->critter_tracker;
 }
 
+npc_ai_blackboard &get_npc_ai_blackboard()
+{
+    return *g->npc_ai_blackboard_ptr;
+}
+
 event_bus &get_event_bus()
 {
     return g->events();
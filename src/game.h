@@ -90,6 +90,7 @@ class map;
 class map_item_stack;
 class memorial_logger;
 class npc;
+class npc_ai_blackboard;
 class save_t;
 class scenario;
 class stats_tracker;
@@ -155,6 +156,7 @@ class game
         friend event_bus &get_event_bus();
         friend map &get_map();
         friend creature_tracker &get_creature_tracker();
+        friend npc_ai_blackboard &get_npc_ai_blackboard();
         friend Character &get_player_character();
         friend avatar &get_avatar();
         friend viewer &get_player_view();
@@ -1069,6 +1071,7 @@ class game
         spell_events &spell_events_subscriber();
 
         pimpl<creature_tracker> critter_tracker;
+        pimpl<npc_ai_blackboard> npc_ai_blackboard_ptr; // NOLINT(cata-serialize)
         pimpl<faction_manager> faction_manager_ptr; // NOLINT(cata-serialize)
 
         /** Used in main.cpp to determine what type of quit is being performed. */
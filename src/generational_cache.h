@@ -0,0 +1,106 @@
+#pragma once
+#ifndef CATA_SRC_GENERATIONAL_CACHE_H
+#define CATA_SRC_GENERATIONAL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Fixed capacity cache using open addressing.
+ *
+ * Every entry is stamped with the generation it was inserted in. Clearing the cache bumps the
+ * current generation, which invalidates all entries at once without touching them. The table
+ * is allocated on the first insert and never grows: when all slots a key can be stored in are
+ * taken, the slot the key hashes to is overwritten. This makes inserting and looking up a few
+ * array accesses, and the cache never allocates after the first insert.
+ *
+ * Key must be hashable with std::hash and comparable with ==.
+ */
+template<typename Key, typename Value>
+class generational_cache
+{
+    public:
+        /** @param capacity_log2 log2 of the number of slots, the capacity is a power of two. */
+        explicit generational_cache( int capacity_log2 ) : capacity_log2( capacity_log2 ) {}
+
+        /** Returns the value cached for @p key, or @p default_ if there is none. */
+        Value get( const Key &key, const Value &default_ ) const {
+            if( slots.empty() ) {
+                return default_;
+            }
+            const size_t home = slot_of( key );
+            for( size_t i = 0; i < max_probes; i++ ) {
+                const slot &s = slots[( home + i ) & mask()];
+                if( s.generation != generation ) {
+                    // nothing is ever inserted after a free slot
+                    break;
+                }
+                if( s.key == key ) {
+                    return s.value;
+                }
+            }
+            return default_;
+        }
+
+        /** Caches @p value for @p key, possibly evicting another key. */
+        void insert( const Key &key, const Value &value ) {
+            if( slots.empty() ) {
+                slots.resize( static_cast<size_t>( 1 ) << capacity_log2 );
+            }
+            const size_t home = slot_of( key );
+            for( size_t i = 0; i < max_probes; i++ ) {
+                slot &s = slots[( home + i ) & mask()];
+                if( s.generation != generation || s.key == key ) {
+                    s = slot{ key, value, generation };
+                    return;
+                }
+            }
+            slots[home] = slot{ key, value, generation };
+        }
+
+        /** Removes all entries in constant time. */
+        void clear() {
+            generation++;
+            if( generation == 0 ) {
+                // wrapped around, entries of the first generation would come back to life
+                for( slot &s : slots ) {
+                    s.generation = 0;
+                }
+                generation = 1;
+            }
+        }
+
+        /** Number of keys the cache can hold at most. */
+        size_t capacity() const {
+            return static_cast<size_t>( 1 ) << capacity_log2;
+        }
+
+    private:
+        struct slot {
+            Key key;
+            Value value;
+            // 0 is never the current generation, so default constructed slots are free
+            uint32_t generation = 0;
+        };
+
+        // how many slots after the one a key hashes to are tried
+        static constexpr size_t max_probes = 8;
+
+        size_t mask() const {
+            return slots.size() - 1;
+        }
+        size_t slot_of( const Key &key ) const {
+            // spread the bits of the hash, std::hash is often close to identity
+            const uint64_t hash = std::hash<Key>()( key );
+            const uint64_t h = hash * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>( h >> ( 64 - capacity_log2 ) );
+        }
+
+        int capacity_log2;
+        uint32_t generation = 1;
+        std::vector<slot> slots;
+};
+
+#endif // CATA_SRC_GENERATIONAL_CACHE_H
@@ -78,6 +78,7 @@
 #include "path_info.h"
 #include "profession.h"
 #include "proficiency.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
 #include "regional_settings.h"
@@ -485,6 +486,7 @@ void DynamicDataLoader::initialize()
 void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::string &src,
         loading_ui &ui )
 {
+    CATA_PROFILE_ZONE( "DynamicDataLoader::load_data_from_path" );
     cata_assert( !finalized &&
                  "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -659,6 +661,7 @@ void DynamicDataLoader::finalize_loaded_data()
 
 void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 {
+    CATA_PROFILE_ZONE( "DynamicDataLoader::finalize_loaded_data" );
     cata_assert( !finalized && "Can't finalize the data twice." );
     cata_assert( !stream_cache && "Expected stream cache to be null before finalization" );
 
@@ -743,6 +746,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 
     ui.show();
     for( const named_entry &e : entries ) {
+        CATA_PROFILE_ZONE( e.first );
         e.second();
         ui.proceed();
     }
@@ -753,6 +757,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 
 void DynamicDataLoader::check_consistency( loading_ui &ui )
 {
+    CATA_PROFILE_ZONE( "DynamicDataLoader::check_consistency" );
     ui.new_context( _( "Verifying" ) );
 
     using named_entry = std::pair<std::string, std::function<void()>>;
@@ -845,6 +850,7 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
 
     ui.show();
     for( const named_entry &e : entries ) {
+        CATA_PROFILE_ZONE( e.first );
         e.second();
         ui.proceed();
     }
@@ -514,72 +514,104 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
     provisioned_pseudo_tools.clear();
 
     for( const tripoint &p : pts ) {
-        // a temporary hack while trees are terrain
-        if( m.ter( p )->has_flag( ter_furn_flag::TFLAG_TREE ) ) {
-            provide_pseudo_item( itype_butchery_tree_pseudo );
-        }
-        const furn_t &f = m.furn( p ).obj();
-        if( item *furn_item = provide_pseudo_item( f.crafting_pseudo_item ) ) {
-            const itype *ammo = f.crafting_ammo_item_type();
-            if( furn_item->has_pocket_type( item_pocket::pocket_type::MAGAZINE ) ) {
-                // NOTE: This only works if the pseudo item has a MAGAZINE pocket, not a MAGAZINE_WELL!
-                const bool using_ammotype = f.has_flag( ter_furn_flag::TFLAG_AMMOTYPE_RELOAD );
-                int amount = 0;
-                itype_id ammo_id = ammo->get_id();
-                // Some furniture can consume more than one item type.
-                if( using_ammotype ) {
-                    amount = count_charges_in_list( &ammo->ammo->type, m.i_at( p ), ammo_id );
-                } else {
-                    amount = count_charges_in_list( ammo, m.i_at( p ) );
-                }
-                item furn_ammo( ammo_id, calendar::turn, amount );
-                furn_item->put_in( furn_ammo, item_pocket::pocket_type::MAGAZINE );
+        add_map_items( m, p, pl, assign_invlet );
+        add_volatile_map_tools( m, p );
+    }
+    pts.clear();
+}
+
+void inventory::form_from_map_items( map &m, const std::vector<tripoint> &pts,
+                                     const Character *pl, bool assign_invlet )
+{
+    items.clear();
+    provisioned_pseudo_tools.clear();
+
+    for( const tripoint &p : pts ) {
+        add_map_items( m, p, pl, assign_invlet );
+    }
+}
+
+void inventory::add_volatile_map_tools( map &m, const std::vector<tripoint> &pts )
+{
+    for( const tripoint &p : pts ) {
+        add_volatile_map_tools( m, p );
+    }
+}
+
+void inventory::add_map_items( map &m, const tripoint &p, const Character *pl,
+                               bool assign_invlet )
+{
+    // a temporary hack while trees are terrain
+    if( m.ter( p )->has_flag( ter_furn_flag::TFLAG_TREE ) ) {
+        provide_pseudo_item( itype_butchery_tree_pseudo );
+    }
+    const furn_t &f = m.furn( p ).obj();
+    if( item *furn_item = provide_pseudo_item( f.crafting_pseudo_item ) ) {
+        const itype *ammo = f.crafting_ammo_item_type();
+        if( furn_item->has_pocket_type( item_pocket::pocket_type::MAGAZINE ) ) {
+            // NOTE: This only works if the pseudo item has a MAGAZINE pocket, not a MAGAZINE_WELL!
+            const bool using_ammotype = f.has_flag( ter_furn_flag::TFLAG_AMMOTYPE_RELOAD );
+            int amount = 0;
+            itype_id ammo_id = ammo->get_id();
+            // Some furniture can consume more than one item type.
+            if( using_ammotype ) {
+                amount = count_charges_in_list( &ammo->ammo->type, m.i_at( p ), ammo_id );
+            } else {
+                amount = count_charges_in_list( ammo, m.i_at( p ) );
             }
+            item furn_ammo( ammo_id, calendar::turn, amount );
+            furn_item->put_in( furn_ammo, item_pocket::pocket_type::MAGAZINE );
         }
-        if( m.accessible_items( p ) ) {
-            for( item &i : m.i_at( p ) ) {
-                // if it's *the* player requesting this from from map inventory
-                // then don't allow items owned by another faction to be factored into recipe components etc.
-                if( pl && !i.is_owned_by( *pl, true ) ) {
-                    continue;
-                }
-                if( !i.made_of( phase_id::LIQUID ) ) {
-                    if( i.empty_container() && i.is_watertight_container() ) {
-                        const int count = i.count_by_charges() ? i.charges : 1;
-                        update_liq_container_count( i.typeId(), count );
-                    }
-                    add_item( i, false, assign_invlet );
-                }
+    }
+    if( m.accessible_items( p ) ) {
+        for( item &i : m.i_at( p ) ) {
+            // if it's *the* player requesting this from from map inventory
+            // then don't allow items owned by another faction to be factored into recipe components etc.
+            if( pl && !i.is_owned_by( *pl, true ) ) {
+                continue;
             }
-        }
-        // Kludges for now!
-        if( m.has_nearby_fire( p, 0 ) ) {
-            if( item *fire = provide_pseudo_item( itype_fire ) ) {
-                fire->charges = 1;
+            if( !i.made_of( phase_id::LIQUID ) ) {
+                if( i.empty_container() && i.is_watertight_container() ) {
+                    const int count = i.count_by_charges() ? i.charges : 1;
+                    update_liq_container_count( i.typeId(), count );
+                }
+                add_item( i, false, assign_invlet );
             }
         }
-        // Handle any water from map sources.
-        item water = m.water_from( p );
-        if( !water.is_null() ) {
-            add_item( water );
-        }
+    }
+    // Handle any water from map sources.
+    item water = m.water_from( p );
+    if( !water.is_null() ) {
+        add_item( water );
+    }
 
-        // keg-kludge
-        if( m.furn( p )->has_examine( iexamine::keg ) ) {
-            map_stack liq_contained = m.i_at( p );
-            for( item &i : liq_contained ) {
-                if( i.made_of( phase_id::LIQUID ) ) {
-                    add_item( i );
-                }
+    // keg-kludge
+    if( m.furn( p )->has_examine( iexamine::keg ) ) {
+        map_stack liq_contained = m.i_at( p );
+        for( item &i : liq_contained ) {
+            if( i.made_of( phase_id::LIQUID ) ) {
+                add_item( i );
             }
         }
+    }
+
+    // form from vehicle
+    if( optional_vpart_position vp = m.veh_at( p ) ) {
+        vp->form_cargo_inventory( *this );
+    }
+}
 
-        // form from vehicle
-        if( optional_vpart_position vp = m.veh_at( p ) ) {
-            vp->form_inventory( *this );
+void inventory::add_volatile_map_tools( map &m, const tripoint &p )
+{
+    // Kludges for now!
+    if( m.has_nearby_fire( p, 0 ) ) {
+        if( item *fire = provide_pseudo_item( itype_fire ) ) {
+            fire->charges = 1;
         }
     }
-    pts.clear();
+    if( optional_vpart_position vp = m.veh_at( p ) ) {
+        vp->form_tool_inventory( *this );
+    }
 }
 
 std::list<item> inventory::reduce_stack( const int position, const int quantity )
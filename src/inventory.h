@@ -163,6 +163,15 @@ class inventory : public visitable
                             bool clear_path = true );
         void form_from_map( map &m, std::vector<tripoint> pts, const Character *pl,
                             bool assign_invlet = true );
+        /**
+         * Like form_from_map, but leaves out the pseudo tools of fires and vehicle parts,
+         * whose charges can change every turn without the map noticing.
+         * Add them with @ref add_volatile_map_tools.
+         */
+        void form_from_map_items( map &m, const std::vector<tripoint> &pts, const Character *pl,
+                                  bool assign_invlet = true );
+        /** Adds the pseudo tools of fires and vehicle parts at the given points. */
+        void add_volatile_map_tools( map &m, const std::vector<tripoint> &pts );
         /**
          * Remove a specific item from the inventory. The item is compared
          * by pointer. Contents of the item are removed as well.
@@ -275,6 +284,9 @@ class inventory : public visitable
     private:
         invlet_favorites invlet_cache;
         char find_usable_cached_invlet( const itype_id &item_type );
+        // the parts of form_from_map for a single point
+        void add_map_items( map &m, const tripoint &p, const Character *pl, bool assign_invlet );
+        void add_volatile_map_tools( map &m, const tripoint &p );
 
         invstack items;
 
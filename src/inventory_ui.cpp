@@ -95,6 +95,42 @@ item_name_t &get_cached_name( item const *it )
     return iter->second;
 }
 
+// Names and categories of items prepared for the filter, which matches each of them again
+// with every key typed into it.
+struct item_search_keys {
+    std::optional<lcmatch_key> name;
+    std::optional<lcmatch_key> category;
+};
+std::unordered_map<item const *, item_search_keys> item_search_cache;
+
+bool search_name_matches( item const *it, const std::u32string &lc_qry )
+{
+    // Only kept while a selector is open, the items may be gone after that
+    if( item_name_cache_users <= 0 ) {
+        return lcmatch( remove_color_tags( it->tname() ), lc_qry );
+    }
+    std::optional<lcmatch_key> &key = item_search_cache[it].name;
+    if( !key ) {
+        key.emplace( remove_color_tags( it->tname() ) );
+    }
+    return key->matches( lc_qry );
+}
+
+bool search_category_matches( item const *it, const std::u32string &lc_qry )
+{
+    if( item_name_cache_users <= 0 ) {
+        return lcmatch( it->get_category_of_contents().name(), lc_qry );
+    }
+    std::optional<lcmatch_key> &key = item_search_cache[it].category;
+    if( !key ) {
+        key.emplace( it->get_category_of_contents().name() );
+    }
+    return key->matches( lc_qry );
+}
+
+// Filter epochs are unique across columns, as entries move between them
+size_t last_filter_epoch = 0;
+
 // get topmost visible parent in an unbroken chain
 item_location get_topmost_parent( item_location const &topmost, item_location const &loc,
                                   inventory_selector_preset const &preset )
@@ -657,7 +693,7 @@ bool inventory_selector_preset::sort_compare( const inventory_entry &lhs,
         const inventory_entry &rhs ) const
 {
     auto const sort_key = []( inventory_entry const & e ) {
-        return std::make_tuple( *e.cached_name, *e.cached_name_full, e.generation );
+        return std::tie( *e.cached_name, *e.cached_name_full, e.generation );
     };
     return localized_compare( sort_key( lhs ), sort_key( rhs ) );
 }
@@ -676,6 +712,18 @@ nc_color inventory_selector_preset::get_color( const inventory_entry &entry ) co
 std::function<bool( const inventory_entry & )> inventory_selector_preset::get_filter(
     const std::string &filter ) const
 {
+    const std::pair<char, std::string> query = split_basic_item_filter( filter );
+    if( query.first == '\0' || query.first == 'c' ) {
+        const std::u32string lc_qry = lcmatch_query( query.second );
+        if( query.first == 'c' ) {
+            return [lc_qry]( const inventory_entry & e ) {
+                return search_category_matches( e.any_item().get_item(), lc_qry );
+            };
+        }
+        return [lc_qry]( const inventory_entry & e ) {
+            return search_name_matches( e.any_item().get_item(), lc_qry );
+        };
+    }
     auto item_filter = basic_item_filter( filter );
 
     return [item_filter]( const inventory_entry & e ) {
@@ -861,6 +909,9 @@ void inventory_column::highlight( size_t new_index, scroll_direction dir )
         highlighted_index = new_index;
         page_offset = ( new_index == static_cast<size_t>( -1 ) ) ?
                       0 : highlighted_index - highlighted_index % entries_per_page;
+        if( paging_is_valid ) {
+            measure_page();
+        }
     }
 }
 
@@ -1078,9 +1129,30 @@ void inventory_column::reset_width( const std::vector<inventory_column *> & )
         elem = cell_t();
     }
     reserved_width = 0;
+    // Entries are only measured once their page is shown, there may be thousands of them
     for( inventory_entry &elem : entries ) {
-        expand_to_fit( elem );
+        if( elem.width_measured ) {
+            expand_to_fit( elem );
+        }
+    }
+    if( paging_is_valid ) {
+        measure_page();
     }
+    page_widened = false;
+}
+
+void inventory_column::measure_page()
+{
+    const size_t old_width = get_width();
+    for( size_t index = page_offset; index < entries.size() &&
+         index < page_offset + entries_per_page; ++index ) {
+        inventory_entry &entry = entries[index];
+        if( !entry.width_measured ) {
+            expand_to_fit( entry );
+            entry.width_measured = true;
+        }
+    }
+    page_widened = page_widened || get_width() != old_width;
 }
 
 size_t inventory_column::page_of( size_t index ) const
@@ -1203,6 +1275,7 @@ void inventory_column::set_collapsed( inventory_entry &entry, const bool collaps
     if( collapsed ) {
         entry.collapsed = collapse;
         paging_is_valid = false;
+        stack_index_valid = false;
         entry.make_entry_cell_cache( preset );
     }
 }
@@ -1240,6 +1313,8 @@ void inventory_column::on_input( const inventory_input &input )
         // if that column contains an item that contains the favorited item. So
         // we invalidate every column on TOGGLE_FAVORITE action.
         paging_is_valid = false;
+        paged_filter.clear();
+        item_search_cache.clear();
     }
 }
 
@@ -1248,43 +1323,66 @@ void inventory_column::on_change( const inventory_entry &/* entry */ )
     // stub
 }
 
+inventory_column::stack_key inventory_column::get_stack_key( const inventory_entry &entry,
+        const bool hidden ) const
+{
+    const item_location &loc = entry.locations.front();
+    return stack_key( hidden, entry.get_category_ptr(), static_cast<int>( loc.where() ),
+                      loc.position(), loc.parent_item().get_item(), loc->is_collapsed() );
+}
+
+void inventory_column::index_stacks()
+{
+    stack_index.clear();
+    for( const bool hidden : {
+             false, true
+         } ) {
+        const entries_t &dest = hidden ? entries_hidden : entries;
+        for( size_t i = 0; i < dest.size(); ++i ) {
+            if( dest[i].is_item() ) {
+                stack_index[get_stack_key( dest[i], hidden )].push_back( i );
+            }
+        }
+    }
+    stack_index_valid = true;
+}
+
 inventory_entry *inventory_column::add_entry( const inventory_entry &entry )
 {
-    entries_t &dest = entry.is_hidden( hide_entries_override ) ? entries_hidden : entries;
-    if( std::find( dest.begin(), dest.end(), entry ) != dest.end() ) {
+    const bool hidden = entry.is_hidden( hide_entries_override );
+    entries_t &dest = hidden ? entries_hidden : entries;
+    if( !stack_index_valid ) {
+        index_stacks();
+    }
+    // A duplicate has the same key, and so do the entries the item can stack with
+    std::vector<size_t> *stacks = entry.is_item() ? &stack_index[get_stack_key( entry,
+                                  hidden )] : nullptr;
+    const bool duplicate = stacks != nullptr ?
+    std::any_of( stacks->begin(), stacks->end(), [&dest, &entry]( const size_t i ) {
+        return dest[i] == entry;
+    } ) : std::find( dest.begin(), dest.end(), entry ) != dest.end();
+    if( duplicate ) {
         debugmsg( "Tried to add a duplicate entry." );
         return nullptr;
     }
     paging_is_valid = false;
-    if( entry.is_item() ) {
-        item_location entry_item = entry.locations.front();
-
-        auto entry_with_loc = std::find_if( dest.begin(),
-        dest.end(), [&entry, &entry_item, this]( const inventory_entry & e ) {
-            if( !e.is_item() ) {
-                return false;
+    if( stacks != nullptr ) {
+        const item_location &entry_item = entry.locations.front();
+        for( const size_t i : *stacks ) {
+            inventory_entry &e = dest[i];
+            if( !e.is_collated() &&
+                entry_item->display_stacked_with( *e.locations.front(),
+                                                  preset.get_checking_components() ) ) {
+                std::move( entry.locations.begin(), entry.locations.end(),
+                           std::back_inserter( e.locations ) );
+                return &e;
             }
-            item_location found_entry_item = e.locations.front();
-            return !e.is_collated() &&
-                   e.get_category_ptr() == entry.get_category_ptr() &&
-                   entry_item.where() == found_entry_item.where() &&
-                   entry_item.position() == found_entry_item.position() &&
-                   entry_item.parent_item() == found_entry_item.parent_item() &&
-                   entry_item->is_collapsed() == found_entry_item->is_collapsed() &&
-                   entry_item->display_stacked_with( *found_entry_item, preset.get_checking_components() );
-        } );
-        if( entry_with_loc != dest.end() ) {
-            std::vector<item_location> &locations = entry_with_loc->locations;
-            std::move( entry.locations.begin(), entry.locations.end(), std::back_inserter( locations ) );
-            return &*entry_with_loc;
         }
+        stacks->push_back( dest.size() );
     }
 
     dest.emplace_back( entry );
-    inventory_entry &newent = dest.back();
-    newent.update_cache();
-
-    return &newent;
+    return &dest.back();
 }
 
 void inventory_column::move_entries_to( inventory_column &dest )
@@ -1293,6 +1391,7 @@ void inventory_column::move_entries_to( inventory_column &dest )
     std::move( entries_hidden.begin(), entries_hidden.end(),
                std::back_inserter( dest.entries_hidden ) );
     dest.paging_is_valid = false;
+    dest.stack_index_valid = false;
     clear();
 }
 
@@ -1379,39 +1478,68 @@ bool inventory_column::collated_sort_compare( inventory_entry const &lhs,
 
 void inventory_column::collate()
 {
-    for( auto outer = entries.begin(); outer != entries.end(); ++outer ) {
-        if( !outer->is_item() || outer->is_collated() || outer->chevron ) {
+    // An entry collates into the first entry before it of the same type, category, favorite
+    // state and parent (when indented) that is the same relic.
+    using collate_key = std::tuple<const item_category *, bool, itype_id, const item *>;
+    std::unordered_map<collate_key, std::vector<size_t>, cata::tuple_hash> outers;
+    // Indices of the entries collating into each entry
+    std::vector<std::vector<size_t>> collated( entries.size() );
+    std::vector<bool> removed( entries.size(), false );
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        const inventory_entry &e = entries[i];
+        if( !e.is_item() ) {
             continue;
         }
-        for( auto e = std::next( outer ); e != entries.end(); ) {
-            if( e->is_item() && e->get_category_ptr() == outer->get_category_ptr() &&
-                e->any_item()->is_favorite == outer->any_item()->is_favorite &&
-                e->any_item()->typeId() == outer->any_item()->typeId() &&
-                ( !indent_entries() ||
-                  e->any_item().parent_item() == outer->any_item().parent_item() ) &&
-                ( e->is_collation_header() || !e->chevron ) &&
-                e->any_item()->is_same_relic( *outer->any_item() ) ) {
-
-                if( !outer->is_collated() ) {
-                    outer->collation_meta = std::make_shared<collation_meta_t>(
-                                                collation_meta_t{ outer->any_item(), true, outer->is_selectable() } );
-
-                    entries_hidden.emplace_back( *outer );
+        const item_location &loc = e.any_item();
+        const item *parent = indent_entries() ? loc.parent_item().get_item() : nullptr;
+        const collate_key key( e.get_category_ptr(), loc->is_favorite, loc->typeId(), parent );
+        std::vector<size_t> &candidates = outers[key];
+        if( e.is_collation_header() || !e.chevron ) {
+            const auto outer = std::find_if( candidates.begin(), candidates.end(),
+            [this, &loc]( const size_t o ) {
+                return loc->is_same_relic( *entries[o].any_item() );
+            } );
+            if( outer != candidates.end() ) {
+                collated[*outer].push_back( i );
+                removed[i] = true;
+                continue;
+            }
+        }
+        if( !e.is_collated() && !e.chevron ) {
+            candidates.push_back( i );
+        }
+    }
 
-                    outer->chevron = true;
-                    set_collapsed( *outer, true );
-                    outer->reset_entry_cell_cache(); // needed when switching UI modes
-                }
-                e->collation_meta = outer->collation_meta;
-                std::copy( e->locations.begin(), e->locations.end(),
-                           std::back_inserter( outer->locations ) );
-                entries_hidden.emplace_back( std::move( *e ) );
-                e = entries.erase( e );
-            } else {
-                ++e;
+    for( size_t o = 0; o < entries.size(); ++o ) {
+        if( collated[o].empty() ) {
+            continue;
+        }
+        inventory_entry &outer = entries[o];
+        outer.collation_meta = std::make_shared<collation_meta_t>( collation_meta_t{
+            outer.any_item(), true, outer.is_selectable() } );
+        entries_hidden.emplace_back( outer );
+        outer.chevron = true;
+        set_collapsed( outer, true );
+        outer.reset_entry_cell_cache(); // needed when switching UI modes
+        for( const size_t i : collated[o] ) {
+            inventory_entry &e = entries[i];
+            e.collation_meta = outer.collation_meta;
+            std::copy( e.locations.begin(), e.locations.end(),
+                       std::back_inserter( outer.locations ) );
+            entries_hidden.emplace_back( std::move( e ) );
+        }
+    }
+    size_t kept = 0;
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        if( !removed[i] ) {
+            if( kept != i ) {
+                entries[kept] = std::move( entries[i] );
             }
+            kept++;
         }
     }
+    entries.erase( entries.begin() + kept, entries.end() );
+    stack_index_valid = false;
     _collated = true;
 }
 
@@ -1433,6 +1561,7 @@ void inventory_column::uncollate()
         _reset_collation( entries );
         _reset_collation( entries_hidden );
         _collated = false;
+        stack_index_valid = false;
     }
 }
 
@@ -1441,16 +1570,30 @@ void inventory_column::prepare_paging( const std::string &filter )
     if( paging_is_valid ) {
         return;
     }
+    // Entries are moved around and categories inserted between them
+    stack_index_valid = false;
 
     const auto filter_fn = filter_from_string<inventory_entry>(
     filter, [this]( const std::string & filter ) {
         return preset.get_filter( filter );
     } );
 
+    // While the filter is only narrowed down, entries that failed it before still fail it
+    if( !filter_narrows( paged_filter, filter ) ) {
+        filter_epoch = ++last_filter_epoch;
+    }
+    paged_filter = filter;
+
     const auto is_visible = [&filter_fn, &filter, this]( inventory_entry const & it ) {
-        return it.is_item() &&
-               ( filter_fn( it ) &&
-                 ( ( !filter.empty() && !it.is_collation_entry() ) || !it.is_hidden( hide_entries_override ) ) );
+        if( !it.is_item() || it.filtered_out_epoch == filter_epoch ) {
+            return false;
+        }
+        if( !filter_fn( it ) ) {
+            it.filtered_out_epoch = filter_epoch;
+            return false;
+        }
+        return ( !filter.empty() && !it.is_collation_entry() ) ||
+               !it.is_hidden( hide_entries_override );
     };
     const auto is_not_visible = [&is_visible, this]( inventory_entry const & it ) {
         it.cache_denial( preset ); // do it here since we're looping over all visible entries anyway
@@ -1462,6 +1605,13 @@ void inventory_column::prepare_paging( const std::string &filter )
     // remove entries hidden by SHOW_HIDE_CONTENTS
     move_if( entries, entries_hidden, is_not_visible );
 
+    // Only the shown entries are sorted, so only their names are needed
+    for( inventory_entry &entry : entries ) {
+        if( entry.is_item() && entry.cached_name == nullptr ) {
+            entry.update_cache();
+        }
+    }
+
     // Then sort them with respect to categories
     std::stable_sort( entries.begin(), entries.end(),
     [this]( const inventory_entry & lhs, const inventory_entry & rhs ) {
@@ -1520,6 +1670,7 @@ void inventory_column::clear()
     entries.clear();
     entries_hidden.clear();
     paging_is_valid = false;
+    stack_index_valid = false;
 }
 
 bool inventory_column::highlight( const item_location &loc, bool front_only )
@@ -1766,7 +1917,7 @@ void selection_column::reset_width( const std::vector<inventory_column *> &all_c
     for( const inventory_column *const col : all_columns ) {
         if( col && !dynamic_cast<const selection_column *>( col ) ) {
             for( inventory_entry *const ent : col->get_entries( always_yes ) ) {
-                if( ent ) {
+                if( ent && ent->width_measured ) {
                     expand_to_fit( *ent, false );
                 }
             }
@@ -1813,7 +1964,7 @@ void selection_column::on_change( const inventory_entry &entry )
         } else {
             iter = entries.erase( iter );
         }
-        paging_is_valid = false;
+        invalidate_paging();
         if( iter != entries.end() ) {
             last_changed = *iter;
         }
@@ -2796,6 +2947,7 @@ inventory_selector::~inventory_selector()
     item_name_cache_users--;
     if( item_name_cache_users <= 0 ) {
         item_name_cache.clear();
+        item_search_cache.clear();
     }
     if( preset.save_state == nullptr ) {
         inventory_sel_default_state.uimode = _uimode;
@@ -2942,6 +3094,15 @@ void inventory_selector::on_input( const inventory_input &input )
             }
         }
     }
+    // Entries are measured when their page is first shown, a wider page needs a new layout
+    if( std::any_of( columns.begin(), columns.end(), []( const inventory_column * col ) {
+    return col->needs_layout();
+    } ) ) {
+        shared_ptr_fast<ui_adaptor> current_ui = ui.lock();
+        if( current_ui ) {
+            current_ui->mark_resize();
+        }
+    }
 }
 
 void inventory_selector::on_change( const inventory_entry &entry )
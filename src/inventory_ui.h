@@ -13,6 +13,8 @@
 #include <new>
 #include <optional>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -20,6 +22,7 @@
 #include "cuboid_rectangle.h"
 #include "cursesdef.h"
 #include "debug.h"
+#include "hash_utils.h"
 #include "input.h"
 #include "item_category.h"
 #include "item_location.h"
@@ -27,6 +30,7 @@
 #include "map.h"
 #include "memory_fast.h"
 #include "pimpl.h"
+#include "point.h"
 #include "translations.h"
 #include "units.h"
 #include "units_fwd.h"
@@ -77,6 +81,10 @@ class inventory_entry
         int custom_invlet = INT_MIN;
         std::string *cached_name = nullptr;
         std::string *cached_name_full = nullptr;
+        /** Filter epoch of the column in which the entry last failed the filter. */
+        mutable size_t filtered_out_epoch = 0;
+        /** Whether the column was widened to fit the entry, which happens once it is shown. */
+        bool width_measured = false;
 
         inventory_entry() = default;
 
@@ -436,6 +444,10 @@ class inventory_column
         void set_width( size_t new_width );
         void set_height( size_t new_height );
         size_t get_width() const;
+        /** Whether a page shown since the last @ref reset_width made the column wider. */
+        bool needs_layout() const {
+            return page_widened;
+        }
         size_t get_height() const;
         /** Expands the column to fit the new entry. */
         void expand_to_fit( inventory_entry &entry, bool with_denial = true );
@@ -490,6 +502,7 @@ class inventory_column
 
         void invalidate_paging() {
             paging_is_valid = false;
+            stack_index_valid = false;
         }
 
         /** Toggle being able to highlight unselectable entries*/
@@ -540,6 +553,9 @@ class inventory_column
         bool multiselect = false;
         bool paging_is_valid = false;
         bool visibility = true;
+        /** The filter the entries were last paged with, see @ref filter_narrows. */
+        std::string paged_filter;
+        size_t filter_epoch = 0;
 
         size_t highlighted_index = std::numeric_limits<size_t>::max();
         size_t page_offset = 0;
@@ -572,8 +588,22 @@ class inventory_column
         static void _move_entries_to( entries_t const &ent, inventory_column &dest );
         static void _reset_collation( entries_t &ent );
 
+        /** Widens the column to fit the entries of the current page. */
+        void measure_page();
+
+        // Entries that items can stack with share their category, where they are and whether
+        // they are collapsed, so adding an item only compares it with the entries that do.
+        using stack_key =
+            std::tuple<bool, const item_category *, int, tripoint, const item *, bool>;
+        stack_key get_stack_key( const inventory_entry &entry, bool hidden ) const;
+        void index_stacks();
+        // Indices in entries (or entries_hidden) of the item entries, by their stack_key
+        std::unordered_map<stack_key, std::vector<size_t>, cata::tuple_hash> stack_index;
+        bool stack_index_valid = false;
+
         bool skip_unselectable = false;
         bool _collated = false;
+        bool page_widened = false;
 };
 
 class selection_column : public inventory_column
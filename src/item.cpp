@@ -52,6 +52,7 @@
 #include "field_type.h"
 #include "fire.h"
 #include "flag.h"
+#include "flag_bitset.h"
 #include "game.h"
 #include "game_constants.h"
 #include "gun_mode.h"
@@ -6299,11 +6300,17 @@ void item::on_pickup( Character &p )
 void item::update_inherited_flags()
 {
     inherited_tags_cache.clear();
+    inherited_tag_bits.reset();
 
     auto const inehrit_flags = [this]( FlagsSetType const & Flags ) {
         for( flag_id const &f : Flags ) {
             if( f->inherit() ) {
-                inherited_tags_cache.emplace( f );
+                const int index = flag_dense_index( f );
+                if( index >= 0 ) {
+                    inherited_tag_bits.set( index );
+                } else {
+                    inherited_tags_cache.emplace( f );
+                }
             }
         }
     };
@@ -7380,6 +7387,7 @@ int item::current_reach_range( const Character &guy ) const
 void item::unset_flags()
 {
     item_tags.clear();
+    item_tag_bits.reset();
     requires_tags_processing = true;
 }
 
@@ -7400,11 +7408,21 @@ bool item::has_fault_flag( const std::string &searched_flag ) const
 
 bool item::has_own_flag( const flag_id &f ) const
 {
+    const int index = flag_dense_index( f );
+    if( index >= 0 ) {
+        return item_tag_bits.test( index );
+    }
     return item_tags.find( f ) != item_tags.end();
 }
 
 bool item::has_flag( const flag_id &f ) const
 {
+    const int index = flag_dense_index( f );
+    if( index >= 0 ) {
+        return inherited_tag_bits.test( index ) || type->get_flag_bits().test( index ) ||
+               item_tag_bits.test( index );
+    }
+
     bool ret = false;
     if( !f.is_valid() ) {
         debugmsg( "Attempted to check invalid flag_id %s", f.str() );
@@ -7427,10 +7445,19 @@ bool item::has_flag( const flag_id &f ) const
     return ret;
 }
 
+bool item::has_any_dense_flag( const flag_bitset &mask ) const
+{
+    return ( ( inherited_tag_bits | type->get_flag_bits() | item_tag_bits ) & mask ).any();
+}
+
 item &item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        const int index = flag_dense_index( flag );
+        if( index >= 0 ) {
+            item_tag_bits.set( index );
+        }
         requires_tags_processing = true;
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
@@ -7441,6 +7468,10 @@ item &item::set_flag( const flag_id &flag )
 item &item::unset_flag( const flag_id &flag )
 {
     item_tags.erase( flag );
+    const int index = flag_dense_index( flag );
+    if( index >= 0 ) {
+        item_tag_bits.reset( index );
+    }
     requires_tags_processing = true;
     return *this;
 }
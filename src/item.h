@@ -20,6 +20,7 @@
 #include "cata_utility.h"
 #include "compatibility.h"
 #include "enums.h"
+#include "flag_bitset.h"
 #include "gun_mode.h"
 #include "io_tags.h"
 #include "item_components.h"
@@ -1820,9 +1821,16 @@ class item : public visitable
 
         template<typename Container, typename T = std::decay_t<decltype( *std::declval<const Container &>().begin() )>>
         bool has_any_flag( const Container &flags ) const {
-            return std::any_of( flags.begin(), flags.end(), [&]( const T & flag ) {
-                return has_flag( flag );
-            } );
+            flag_bitset mask;
+            for( const T &flag : flags ) {
+                const int index = flag_dense_index( flag );
+                if( index >= 0 ) {
+                    mask.set( index );
+                } else if( has_flag( flag ) ) {
+                    return true;
+                }
+            }
+            return has_any_dense_flag( mask );
         }
 
         /**
@@ -2833,6 +2841,8 @@ class item : public visitable
         bool armor_full_protection_info( std::vector<iteminfo> &info, const iteminfo_query *parts ) const;
 
         void update_inherited_flags();
+        /** Whether the item, its type or its attached items have any of the flags in @p mask. */
+        bool has_any_dense_flag( const flag_bitset &mask ) const;
 
     public:
         enum class sizing : int {
@@ -2881,7 +2891,10 @@ class item : public visitable
          */
         bool requires_tags_processing = true;
         FlagsSetType item_tags; // generic item specific flags
+        flag_bitset item_tag_bits; // item_tags by dense flag index
+        // inherited flags that have a dense index are only stored in inherited_tag_bits
         FlagsSetType inherited_tags_cache;
+        flag_bitset inherited_tag_bits;
         safe_reference_anchor anchor;
         std::map<std::string, std::string> item_vars;
         const mtype *corpse = nullptr;
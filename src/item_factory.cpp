@@ -32,6 +32,7 @@
 #include "enums.h"
 #include "explosion.h"
 #include "flag.h"
+#include "flag_bitset.h"
 #include "flat_set.h"
 #include "game_constants.h"
 #include "generic_factory.h"
@@ -220,6 +221,7 @@ void Item_factory::finalize_pre( itype &obj )
     if( obj.damage_max() == obj.damage_min() ) {
         obj.item_tags.insert( flag_NO_REPAIR );
     }
+    obj.flag_bits = dense_flag_bits( obj.item_tags );
 
     if( obj.has_flag( flag_STAB ) || obj.has_flag( flag_SPEAR ) ) {
         std::swap( obj.melee[static_cast<int>( damage_type::CUT )],
@@ -667,6 +669,7 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    obj.flag_bits = dense_flag_bits( obj.item_tags );
 
     if( obj.gun && !obj.gunmod && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
         const quality_id qual_gun_skill( to_upper_case( obj.gun->skill_used.str() ) );
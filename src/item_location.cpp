@@ -276,6 +276,7 @@ class item_location::impl::item_on_map : public item_location::impl
 
         void on_contents_changed() override {
             target()->on_contents_changed();
+            map::contents_changed();
         }
 
         units::volume volume_capacity() const override {
@@ -553,6 +554,7 @@ class item_location::impl::item_on_vehicle : public item_location::impl
         void on_contents_changed() override {
             target()->on_contents_changed();
             cur.veh.invalidate_mass();
+            map::contents_changed();
         }
 
         void make_active( item_location &head ) {
@@ -1,6 +1,7 @@
 #include "item_search.h"
 
 #include <map>
+#include <tuple>
 #include <utility>
 
 #include "avatar.h"
@@ -14,28 +15,46 @@
 
 static std::pair<std::string, std::string> get_both( const std::string &a );
 
-std::function<bool( const item & )> basic_item_filter( std::string filter )
+std::pair<char, std::string> split_basic_item_filter( const std::string &filter )
+{
+    const size_t colon = filter.find( ':' );
+    if( colon != std::string::npos && colon >= 1 ) {
+        return { filter[colon - 1], filter.substr( colon + 1 ) };
+    }
+    return { '\0', filter };
+}
+
+bool filter_narrows( const std::string &from, const std::string &to )
 {
-    size_t colon;
-    char flag = '\0';
-    if( ( colon = filter.find( ':' ) ) != std::string::npos ) {
-        if( colon >= 1 ) {
-            flag = filter[colon - 1];
-            filter = filter.substr( colon + 1 );
-        }
+    if( from.empty() || to.compare( 0, from.size(), from ) != 0 || from[0] == '-' ||
+        to.find_first_of( ",{}" ) != std::string::npos ) {
+        return false;
+    }
+    // The flag has to be typed in completely, and 'b' splits the query in two
+    const size_t colon = to.find( ':' );
+    if( colon != from.find( ':' ) ) {
+        return false;
     }
+    return colon == std::string::npos || colon == 0 || to[colon - 1] != 'b';
+}
+
+std::function<bool( const item & )> basic_item_filter( std::string filter )
+{
+    char flag;
+    std::tie( flag, filter ) = split_basic_item_filter( filter );
+    const std::u32string lc_filter = lcmatch_query( filter );
     switch( flag ) {
         // category
         case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category_of_contents().name(), filter );
+            return [lc_filter]( const item & i ) {
+                return lcmatch( i.get_category_of_contents().name(), lc_filter );
             };
         // material
         case 'm':
-            return [filter]( const item & i ) {
+            return [lc_filter]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const std::pair<material_id, int> &mat ) {
-                    return lcmatch( mat.first->name(), filter );
+                [&lc_filter]( const std::pair<material_id, int> &mat ) {
+                    return lcmatch( mat.first->name(), lc_filter );
                 } );
             };
         // qualities
@@ -52,10 +71,10 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [lc_filter]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( const item_comp &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( lcmatch( component.to_string(), lc_filter ) ) {
                         return true;
                     }
                 }
@@ -63,22 +82,22 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [lc_filter]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && lcmatch( note, lc_filter );
             };
         // by book skill
         case 's':
-            return [filter]( const item & i ) {
+            return [lc_filter]( const item & i ) {
                 if( get_avatar().has_identified( i.typeId() ) ) {
-                    return lcmatch( i.get_book_skill(), filter );
+                    return lcmatch( i.get_book_skill(), lc_filter );
                 }
                 return false;
             };
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( remove_color_tags( a.tname() ), filter );
+            return [lc_filter]( const item & a ) {
+                return lcmatch( remove_color_tags( a.tname() ), lc_filter );
             };
     }
 }
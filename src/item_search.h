@@ -7,6 +7,7 @@
 #include <functional>
 #include <iosfwd>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "output.h"
@@ -97,4 +98,15 @@ std::function<bool( const item & )> item_filter_from_string( const std::string &
  */
 std::function<bool( const item & )> basic_item_filter( std::string filter );
 
+/**
+ * Split a basic query into its flag ('\0' if there is none) and the text it looks for.
+ */
+std::pair<char, std::string> split_basic_item_filter( const std::string &filter );
+
+/**
+ * Whether every item matching the query @p to also matches @p from, because @p to only adds
+ * text to the end of a query that looks for a substring.
+ */
+bool filter_narrows( const std::string &from, const std::string &to );
+
 #endif // CATA_SRC_ITEM_SEARCH_H
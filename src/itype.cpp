@@ -6,6 +6,7 @@
 #include "cata_utility.h"
 #include "character.h"
 #include "debug.h"
+#include "flag_bitset.h"
 #include "item.h"
 #include "make_static.h"
 #include "recipe.h"
@@ -147,7 +148,8 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
-    return item_tags.count( flag );
+    const int index = flag_dense_index( flag );
+    return index >= 0 ? flag_bits.test( index ) : item_tags.count( flag );
 }
 
 const itype::FlagsSetType &itype::get_flags() const
@@ -19,6 +19,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag_bitset.h"
 #include "game_constants.h"
 #include "item_pocket.h"
 #include "iuse.h" // use_function
@@ -1236,6 +1237,8 @@ struct itype {
         mtype_id source_monster = mtype_id::NULL_ID();
     private:
         FlagsSetType item_tags;
+        // item_tags by dense flag index, rebuilt by Item_factory whenever it changes item_tags
+        flag_bitset flag_bits;
 
     public:
         // How should the item explode
@@ -1405,6 +1408,10 @@ struct itype {
 
         // returns read-only set of all item tags/flags
         const FlagsSetType &get_flags() const;
+        // returns the item tags/flags that have a dense index, see flag_dense_index
+        const flag_bitset &get_flag_bits() const {
+            return flag_bits;
+        }
 
         bool can_use( const std::string &iuse_name ) const;
         const use_function *get_use( const std::string &iuse_name ) const;
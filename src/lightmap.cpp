@@ -1,4 +1,5 @@
 #include "lightmap.h" // IWYU pragma: associated
+#include "profiler.h"
 #include "shadowcasting.h" // IWYU pragma: associated
 
 #include <bitset>
@@ -87,6 +88,7 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_transparency_cache" );
     level_cache &map_cache = get_cache( zlev );
     auto &transparent_cache_wo_fields = map_cache.transparent_cache_wo_fields;
     auto &transparency_cache = map_cache.transparency_cache;
@@ -192,6 +194,7 @@ bool map::build_transparency_cache( const int zlev )
 
 bool map::build_vision_transparency_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_vision_transparency_cache" );
     level_cache &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
     auto &vision_transparency_cache = map_cache.vision_transparency_cache;
@@ -380,6 +383,7 @@ void map::build_sunlight_cache( int pzlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::generate_lightmap" );
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -832,7 +836,8 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
                 const point &offset, int offsetDistance,
                 T numerator = VISIBILITY_FULL,
                 int row = 1, float start = 1.0f, float end = 0.0f,
-                T cumulative_transparency = T( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+                T cumulative_transparency = T( LIGHT_TRANSPARENCY_OPEN_AIR ),
+                int max_distance = SHADOWCASTING_MAX_DISTANCE );
 
 template<int xx, int xy, int yx, int yy, typename T, typename Out,
          T( *calc )( const T &, const T &, const int & ),
@@ -842,11 +847,12 @@ template<int xx, int xy, int yx, int yy, typename T, typename Out,
 void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
                 const cata::mdarray<T, point_bub_ms> &input_array,
                 const point &offset, const int offsetDistance, const T numerator,
-                const int row, float start, const float end, T cumulative_transparency )
+                const int row, float start, const float end, T cumulative_transparency,
+                const int max_distance )
 {
     constexpr quadrant quad = quadrant_from_x_y( -xx - xy, -yx - yy );
     float newStart = 0.0f;
-    float radius = 60.0f - offsetDistance;
+    float radius = max_distance - offsetDistance;
     if( start < end ) {
         return;
     }
@@ -899,7 +905,8 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
                 castLight<xx, xy, yx, yy, T, Out, calc, check, update_output, accumulate>(
                     output_cache, input_array, offset, offsetDistance,
                     numerator, distance + 1, start, trailingEdge,
-                    accumulate( cumulative_transparency, current_transparency, distance ) );
+                    accumulate( cumulative_transparency, current_transparency, distance ),
+                    max_distance );
             }
             // The new span starts at the leading edge of the previous square if it is opaque,
             // and at the trailing edge of the current square if it is transparent.
@@ -931,34 +938,43 @@ template<typename T, typename Out, T( *calc )( const T &, const T &, const int &
          T( *accumulate )( const T &, const T &, const int & )>
 void castLightAll( cata::mdarray<Out, point_bub_ms> &output_cache,
                    const cata::mdarray<T, point_bub_ms> &input_array,
-                   const point &offset, int offsetDistance, T numerator )
+                   const point &offset, int offsetDistance, T numerator, int max_distance )
 {
     castLight<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate>(
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
     castLight<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate>(
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
 
     castLight < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
     castLight < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
 
     castLight < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
     castLight < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
 
     castLight < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
     castLight < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
-        output_cache, input_array, offset, offsetDistance, numerator );
+        output_cache, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+        T( LIGHT_TRANSPARENCY_OPEN_AIR ), max_distance );
 }
 
 template void castLightAll<float, four_quadrants, sight_calc, sight_check,
                            update_light_quadrants, accumulate_transparency>(
                                cata::mdarray<four_quadrants, point_bub_ms> &output_cache,
                                const cata::mdarray<float, point_bub_ms> &input_array,
-                               const point &offset, int offsetDistance, float numerator );
+                               const point &offset, int offsetDistance, float numerator,
+                               int max_distance );
 
 template void
 castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
@@ -966,7 +982,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
 (
     cata::mdarray<fragment_cloud, point_bub_ms> &output_cache,
     const cata::mdarray<fragment_cloud, point_bub_ms> &input_array,
-    const point &offset, int offsetDistance, fragment_cloud numerator );
+    const point &offset, int offsetDistance, fragment_cloud numerator, int max_distance );
 
 /**
  * Calculates the Field Of View for the provided map from the given x, y
@@ -983,6 +999,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
 void map::build_seen_cache( const tripoint &origin, const int target_z, int extension_range,
                             bool cumulative, bool camera, int penalty )
 {
+    CATA_PROFILE_ZONE( "map::build_seen_cache" );
     level_cache &map_cache = get_cache( target_z );
     using mdarray = cata::mdarray<float, point_bub_ms>;
     mdarray &transparency_cache = map_cache.vision_transparency_cache;
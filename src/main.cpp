@@ -50,6 +50,7 @@
 #include "ordered_static_globals.h"
 #include "path_info.h"
 #include "rng.h"
+#include "session_replay.h"
 #include "system_locale.h"
 #include "translations.h"
 #include "type_id.h"
@@ -279,6 +280,8 @@ struct cli_opts {
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string record; /** if set record the session into this file */
+    std::string replay; /** if set replay the session recorded in this file */
     bool disable_ascii_art = false;
 };
 
@@ -290,7 +293,7 @@ cli_opts parse_commandline( int argc, const char **argv )
     const char *section_map_sharing = "Map sharing";
     const char *section_user_directory = "User directories";
     const char *section_accessibility = "Accessibility";
-    const std::array<arg_handler, 13> first_pass_arguments = {{
+    const std::array<arg_handler, 15> first_pass_arguments = {{
             {
                 "--seed", "<string of letters and or numbers>",
                 "Sets the random number generator's seed value",
@@ -364,6 +367,26 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 1;
                 }
             },
+            {
+                "--record", "<file>",
+                "Saves the loaded game and records the session into the file, for --replay",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.record = params[0];
+                    return 1;
+                }
+            },
+            {
+                "--replay", "<file>",
+                "Replays a recorded session as fast as possible and writes the time of each turn",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.replay = params[0];
+                    return 1;
+                }
+            },
             {
                 "--basepath", "<path>",
                 "Base path for all game data subdirectories",
@@ -803,6 +826,12 @@ int main( int argc, const char *argv[] )
     }
 
     main_menu::queued_world_to_load = std::move( cli.world );
+    if( !cli.record.empty() ) {
+        session_replay::record_to( cli.record );
+    }
+    if( !cli.replay.empty() && !session_replay::replay_from( cli.replay ) ) {
+        exit_handler( -999 );
+    }
 
     get_help().load();
 
@@ -813,7 +842,19 @@ int main( int argc, const char *argv[] )
         }
 
         shared_ptr_fast<ui_adaptor> ui = g->create_or_get_main_ui_adaptor();
-        while( !do_turn() );
+        session_replay::begin_session();
+        const bool replaying = session_replay::is_replaying();
+        try {
+            while( !do_turn() ) {
+                session_replay::end_turn();
+            }
+        } catch( const session_replay::replay_finished & ) {
+            // All recorded input has been used, the turn in progress is abandoned.
+        }
+        session_replay::end_session();
+        if( replaying ) {
+            break;
+        }
     }
 
     exit_handler( -999 );
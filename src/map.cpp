@@ -10,6 +10,7 @@
 #include <ostream>
 #include <queue>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -81,6 +82,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "pathfinding.h"
+#include "profiler.h"
 #include "projectile.h"
 #include "relic.h"
 #include "ret_val.h"
@@ -471,6 +473,24 @@ void map::update_vehicle_list( const submap *const to, const int zlev )
     }
 }
 
+bool map::other_vehicle_within( const vehicle &veh, const inclusive_cuboid<tripoint> &bounds ) const
+{
+    const int minz = std::max( bounds.p_min.z, -OVERMAP_DEPTH );
+    const int maxz = std::min( bounds.p_max.z, OVERMAP_HEIGHT );
+    for( int zlev = minz; zlev <= maxz; ++zlev ) {
+        const level_cache *cache = get_cache_lazy( zlev );
+        if( !cache ) {
+            continue;
+        }
+        for( const vehicle *other : cache->vehicle_list ) {
+            if( other != &veh && bounds.overlaps( other->get_points_bounds() ) ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::set<tripoint_bub_ms> map::get_moving_vehicle_targets( const Creature &z, int max_range )
 {
     const tripoint_bub_ms zpos( z.pos() );
@@ -586,6 +606,7 @@ void map::on_vehicle_moved( const int smz )
 
 void map::vehmove()
 {
+    CATA_PROFILE_ZONE( "map::vehmove" );
     // give vehicles movement points
     VehicleList vehicle_list;
     int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
@@ -639,7 +660,7 @@ void map::vehmove()
         }
         for( vehicle *veh : cache->vehicle_list ) {
             vehs[veh] = true; // force on map vehicles to true
-            for( const std::pair<vehicle *const, float> &pair : veh->search_connected_vehicles() ) {
+            for( const std::pair<vehicle *, float> &pair : veh->power_grid().vehicles ) {
                 vehs.emplace( pair.first, false ); // add with 'false' if does not exist (off map)
             }
         }
@@ -1330,6 +1351,8 @@ void map::unboard_vehicle( const tripoint &p, bool dead_passenger )
 bool map::displace_vehicle( vehicle &veh, const tripoint &dp, const bool adjust_pos,
                             const std::set<int> &parts_to_move )
 {
+    // the vehicle's cargo and tools are going to be somewhere else
+    contents_changed();
     const tripoint_bub_ms src = veh.pos_bub();
     // handle vehicle ramps
     int ramp_offset = 0;
@@ -1655,6 +1678,7 @@ bool map::furn_set( const tripoint &p, const furn_id &new_furniture, const bool
     }
 
     current_submap->set_furn( l, new_target_furniture );
+    contents_changed();
 
     // Set the dirty flags
     const furn_t &old_f = old_id.obj();
@@ -1834,7 +1858,7 @@ uint8_t map::get_known_connections( const tripoint &p,
     if( use_tiles ) {
         is_memorized =
         [&]( const tripoint & q ) {
-            return !player_character.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !player_character.get_memorized_tile( getabs( q ) ).tile().empty();
         };
     } else {
 #endif
@@ -1919,7 +1943,7 @@ uint8_t map::get_known_connections_f( const tripoint &p,
 #ifdef TILES
     if( use_tiles ) {
         is_memorized = [&]( const tripoint & q ) {
-            return !player_character.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !player_character.get_memorized_tile( getabs( q ) ).tile().empty();
         };
     } else {
 #endif
@@ -2096,6 +2120,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain, bool avoid_crea
     }
 
     current_submap->set_ter( l, new_terrain );
+    contents_changed();
 
     // Set the dirty flags
     const ter_t &old_t = old_id.obj();
@@ -4706,6 +4731,30 @@ map_stack map::i_at( const tripoint_bub_ms &p )
     return i_at( p.raw() );
 }
 
+static int64_t map_contents_generation = 0;
+static int64_t map_appearance_generation = 0;
+
+int64_t map::contents_generation()
+{
+    return map_contents_generation;
+}
+
+void map::contents_changed()
+{
+    map_contents_generation++;
+    map_appearance_generation++;
+}
+
+int64_t map::appearance_generation()
+{
+    return map_appearance_generation;
+}
+
+void map::appearance_changed()
+{
+    map_appearance_generation++;
+}
+
 map_stack::iterator map::i_rem( const tripoint &p, const map_stack::const_iterator &it )
 {
     point l;
@@ -4717,6 +4766,7 @@ map_stack::iterator map::i_rem( const tripoint &p, const map_stack::const_iterat
     }
 
     current_submap->update_lum_rem( l, *it );
+    contents_changed();
 
     return current_submap->get_items( l ).erase( it );
 }
@@ -4746,6 +4796,7 @@ void map::i_clear( const tripoint &p )
 
     current_submap->set_lum( l, 0 );
     current_submap->get_items( l ).clear();
+    contents_changed();
 }
 
 std::vector<item *> map::spawn_items( const tripoint &p, const std::vector<item> &new_items )
@@ -4902,6 +4953,7 @@ std::pair<item *, tripoint> map::_add_item_or_charges( const tripoint &pos, item
         {
             for( item &e : i_at( tile ) ) {
                 if( e.merge_charges( obj ) ) {
+                    contents_changed();
                     return e;
                 }
             }
@@ -5048,6 +5100,7 @@ item &map::add_item( const tripoint &p, item new_item )
     invalidate_max_populated_zlev( p.z );
 
     current_submap->update_lum_add( l, new_item );
+    contents_changed();
 
     const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
     if( current_submap->active_items.add( *new_pos, l ) ) {
@@ -5183,10 +5236,18 @@ void map::update_lum( item_location &loc, bool add )
     }
 }
 
+// What crafting inventories collected from the map know about an item.
+static auto crafting_state( const item &it )
+{
+    return std::make_tuple( it.typeId(), it.charges, it.ammo_remaining(), it.rotten(),
+                            it.is_frozen_liquid(), it.damage() );
+}
+
 static bool process_map_items( map &here, item_stack &items, safe_reference<item> &item_ref,
                                item *parent, const tripoint &location, const float insulation,
                                const temperature_flag flag, const float spoil_multiplier )
 {
+    const auto old_state = crafting_state( *item_ref );
     if( item_ref->process( here, nullptr, location, insulation, flag, spoil_multiplier, false ) ) {
         // Item is to be destroyed so erase it from the map stack
         // unless it was already destroyed by processing.
@@ -5194,13 +5255,17 @@ static bool process_map_items( map &here, item_stack &items, safe_reference<item
             item_ref->spill_contents( location );
             if( parent != nullptr ) {
                 parent->remove_item( *item_ref );
+                map::contents_changed();
             } else {
                 items.erase( items.get_iterator_from_pointer( item_ref.get() ) );
             }
         }
         return true;
     }
-    // Item not destroyed
+    // Item not destroyed, but it may have been used up, recharged, spoiled or frozen
+    if( item_ref && crafting_state( *item_ref ) != old_state ) {
+        map::contents_changed();
+    }
     return false;
 }
 
@@ -5227,6 +5292,9 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
                 break;
             }
         }
+        if( washing_machine_finished ) {
+            map::contents_changed();
+        }
         if( washing_machine_finished && !cur_veh.part_flag( part, VPFLAG_APPLIANCE ) ) {
             //~ %1$s: Cleaner, %2$s: Name of the vehicle
             add_msg( _( "The %1$s in the %2$s has finished washing." ), cur_veh.part( part ).name( false ),
@@ -5258,6 +5326,9 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
                 break;
             }
         }
+        if( autoclave_finished ) {
+            map::contents_changed();
+        }
         if( autoclave_finished && !cur_veh.part_flag( part, VPFLAG_APPLIANCE ) ) {
             add_msg( _( "The autoclave in the %s has finished its cycle." ), cur_veh.name );
         } else if( autoclave_finished ) {
@@ -5286,6 +5357,7 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
                             } else {
                                 n.ammo_set( itype_battery, n.ammo_remaining() + 1 );
                             }
+                            map::contents_changed();
                         }
                         power -= 1000;
                     }
@@ -5298,6 +5370,7 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
 
 void map::process_items()
 {
+    CATA_PROFILE_ZONE( "map::process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z();
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -5615,6 +5688,8 @@ std::list<item_location> map::items_with( const tripoint &p,
 std::list<item> map::use_amount( const tripoint &origin, const int range, const itype_id &type,
                                  int &quantity, const std::function<bool( const item & )> &filter, bool select_ind )
 {
+    // items are consumed in place
+    contents_changed();
     std::list<item> ret;
     if( select_ind && !type->count_by_charges() ) {
         std::vector<item_location> locs;
@@ -5716,6 +5791,8 @@ std::list<item> map::use_charges( const tripoint &origin, const int range,
                                   const std::function<bool( const item & )> &filter,
                                   basecamp *bcp, bool in_tools )
 {
+    // charges are consumed in place
+    contents_changed();
     std::list<item> ret;
 
     // populate a grid of spots that can be reached
@@ -5931,6 +6008,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    appearance_changed();
 }
 
 void map::trap_set( const tripoint_bub_ms &p, const trap_id &type )
@@ -5963,6 +6041,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        appearance_changed();
     }
 }
 
@@ -6239,15 +6318,45 @@ void map::clear_fields( const tripoint &p )
     point l;
     submap *const current_submap = unsafe_get_submap_at( p, l );
     current_submap->clear_fields( l );
+    appearance_changed();
+}
+
+std::vector<tripoint> map::get_fires( const int zlev )
+{
+    std::vector<tripoint> fires;
+    const level_cache &cache = get_cache_ref( zlev );
+    for( int smx = 0; smx < MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < MAPSIZE; smy++ ) {
+            // Only look at submaps that have any fields at all.
+            if( !cache.field_cache[smx + smy * MAPSIZE] ) {
+                continue;
+            }
+            submap *const sm = get_submap_at_grid( tripoint( smx, smy, zlev ) );
+            if( sm == nullptr ) {
+                continue;
+            }
+            for( const point &l : sm->get_fires() ) {
+                fires.emplace_back( smx * SEEX + l.x, smy * SEEY + l.y, zlev );
+            }
+        }
+    }
+    return fires;
 }
 
 void map::on_field_modified( const tripoint &p, const field_type &fd_type )
 {
     invalidate_max_populated_zlev( p.z );
+    appearance_changed();
 
     get_cache( p.z ).field_cache.set(
         static_cast<size_t>( p.x / SEEX ) + ( ( p.y / SEEX ) * MAPSIZE ) );
 
+    if( fd_type.id == fd_fire ) {
+        if( submap *const sm = get_submap_at( p ) ) {
+            sm->fires_changed();
+        }
+    }
+
     // Dirty the transparency cache now that field processing doesn't always do it
     if( fd_type.dirty_transparency_cache || !fd_type.is_transparent() ) {
         set_transparency_cache_dirty( p, true );
@@ -6967,7 +7076,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             }
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        skew_vision_cache.insert( key, visible ? 1 : 0 );
         return visible;
     }
 
@@ -7000,7 +7109,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    skew_vision_cache.insert( key, visible ? 1 : 0 );
     return visible;
 }
 
@@ -7330,6 +7439,7 @@ void map::save()
 void map::load( const tripoint_abs_sm &w, const bool update_vehicle,
                 const bool pump_events )
 {
+    contents_changed();
     map &main_map = get_map();
     // It used to be unsafe to load a map that overlaps with the primary map;
     // Show an info line in tests to help track new errors
@@ -7449,6 +7559,8 @@ void map::shift( const point &sp )
     if( std::abs( sp.x ) > 1 || std::abs( sp.y ) > 1 ) {
         debugmsg( "map::shift called with a shift of more than one submap" );
     }
+    // everything moved to different local coordinates
+    contents_changed();
 
     const tripoint_abs_sm abs = get_abs_sub();
 
@@ -8473,6 +8585,7 @@ void map::clear_traps()
     for( auto &i : traplocs ) {
         i.clear();
     }
+    appearance_changed();
 }
 
 const std::vector<tripoint> &map::get_furn_field_locations() const
@@ -8666,6 +8779,7 @@ int map::determine_wall_corner( const tripoint &p ) const
 
 void map::build_outside_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_outside_cache" );
     auto *ch_lazy = get_cache_lazy( zlev );
     if( !ch_lazy || !ch_lazy->outside_cache_dirty ) {
         return;
@@ -8758,7 +8872,7 @@ void map::build_obstacle_cache(
                         // some nominal temp and humidity.
                         // TODO: figure out if our temp/altitude/humidity variation is
                         // sufficient to bother setting this differently.
-                        obstacle_cache[p2.x][p2.y].velocity = 1.2f;
+                        obstacle_cache[p2.x][p2.y].velocity = FRAGMENT_AIR_DRAG;
                         obstacle_cache[p2.x][p2.y].density = 1.0f;
                     }
                 }
@@ -8823,6 +8937,7 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
 
 bool map::build_floor_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_floor_cache" );
     auto *ch_lazy = get_cache_lazy( zlev );
     if( !ch_lazy || !ch_lazy->floor_cache_dirty ) {
         return false;
@@ -8925,6 +9040,7 @@ static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_
 
 void map::do_vehicle_caching( int z )
 {
+    CATA_PROFILE_ZONE( "map::do_vehicle_caching" );
     level_cache *ch = get_cache_lazy( z );
     if( !ch ) {
         return;
@@ -8945,6 +9061,7 @@ void map::do_vehicle_caching( int z )
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    CATA_PROFILE_ZONE( "map::build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
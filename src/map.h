@@ -26,14 +26,15 @@
 #include "colony.h"
 #include "coordinate_conversions.h"
 #include "coordinates.h"
+#include "cuboid_rectangle.h"
 #include "enums.h"
 #include "game_constants.h"
+#include "generational_cache.h"
 #include "item.h"
 #include "item_stack.h"
 #include "level_cache.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "map_selector.h"
 #include "mapdata.h"
 #include "maptile_fwd.h"
@@ -679,6 +680,9 @@ class map
         // distance from \p source position, if any parts are CONTROLS, ENGINE or WHEELS returns a
         // list of tripoints with exclusively such parts instead. Used for monster gun actor targeting.
         std::set<tripoint_bub_ms> get_moving_vehicle_targets( const Creature &z, int max_range );
+        // returns whether the occupied bounds of any vehicle other than \p veh intersect \p bounds
+        bool other_vehicle_within( const vehicle &veh,
+                                   const inclusive_cuboid<tripoint> &bounds ) const;
 
         // Removes vehicle from map and returns it in unique_ptr
         std::unique_ptr<vehicle> detach_vehicle( vehicle *veh );
@@ -1217,6 +1221,23 @@ class map
         // Returns points for all submaps with inconsistent state relative to
         // the list in map.  Used in tests.
         void check_submap_active_item_consistency();
+        /**
+         * Counter that changes whenever items, terrain, furniture or vehicles on any loaded
+         * submap change, or the map is shifted or loaded. Items processed in place count as
+         * changed when they are used up, recharged, spoiled or frozen. Caches of things found on the map
+         * (like @ref Character::crafting_inventory) can compare it to see if they are still valid.
+         */
+        static int64_t contents_generation();
+        /** Changes @ref contents_generation, call after modifying map contents directly. */
+        static void contents_changed();
+        /**
+         * Counter that changes with @ref contents_generation and whenever fields or traps change.
+         * Things drawn from the map (like the render list of the tiles) compare it instead, fields
+         * change almost every turn and would needlessly invalidate caches of the contents.
+         */
+        static int64_t appearance_generation();
+        /** Changes @ref appearance_generation only, call after modifying fields or traps. */
+        static void appearance_changed();
         // Accessor that returns a wrapped reference to an item stack for safe modification.
         // TODO: fix point types (remove the first overload)
         map_stack i_at( const tripoint &p );
@@ -1576,6 +1597,11 @@ class map
          * Remove all field entries at location.
          */
         void clear_fields( const tripoint &p );
+        /**
+         * Positions of the fires on z-level @p zlev, including contained ones. Each submap
+         * keeps its own, and only looks for them again after fire was added or removed there.
+         */
+        std::vector<tripoint> get_fires( int zlev );
 
         /**
          * Get applicable fd_electricity field type for a given point
@@ -2173,8 +2199,9 @@ class map
 
         /**
          * Cache of coordinate pairs recently checked for visibility.
+         * Cleared whenever the transparency cache changes.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable generational_cache<point, char> skew_vision_cache{ 17 };
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -11,7 +11,7 @@
 #include "string_formatter.h"
 #include "translations.h"
 
-const memorized_terrain_tile mm_submap::default_tile{ "", 0, 0 };
+const memorized_terrain_tile mm_submap::default_tile{};
 const int mm_submap::default_symbol = 0;
 
 #define MM_SIZE (MAPSIZE * 2)
@@ -46,6 +46,59 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+
+struct interned_tile_names {
+    // Node based, so the names stay where they are when more are added.
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<const std::string *> names;
+
+    interned_tile_names() {
+        names.push_back( &ids.emplace( std::string(), 0 ).first->first );
+    }
+};
+
+interned_tile_names &get_interned_tile_names()
+{
+    static interned_tile_names interned;
+    return interned;
+}
+
+} // namespace
+
+memorized_terrain_tile::memorized_terrain_tile( const std::string &tile, const int subtile,
+        const int rotation ) : tile_id( intern( tile ) ), subtile( subtile ), rotation( rotation )
+{
+}
+
+const std::string &memorized_terrain_tile::tile() const
+{
+    return name_of( tile_id );
+}
+
+uint32_t memorized_terrain_tile::intern( const std::string &name )
+{
+    interned_tile_names &interned = get_interned_tile_names();
+    const auto it = interned.ids.find( name );
+    if( it != interned.ids.end() ) {
+        return it->second;
+    }
+    const uint32_t id = interned.names.size();
+    interned.names.push_back( &interned.ids.emplace( name, id ).first->first );
+    return id;
+}
+
+const std::string &memorized_terrain_tile::name_of( const uint32_t id )
+{
+    const interned_tile_names &interned = get_interned_tile_names();
+    if( id >= interned.names.size() ) {
+        debugmsg( "Invalid memorized tile id %d", id );
+        return *interned.names.front();
+    }
+    return *interned.names[id];
+}
+
 mm_submap::mm_submap() = default;
 mm_submap::mm_submap( bool make_valid ) : valid( make_valid ) {}
 
@@ -2,7 +2,11 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
 #include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "mdarray.h"
@@ -14,13 +18,31 @@ class JsonObject;
 class JsonOut;
 class JsonValue;
 
+/**
+ * A memorized tile. The name of the tile is interned: every distinct name is stored once for
+ * the whole game and tiles only keep its index, so memorizing a large area costs 8 bytes per
+ * tile no matter how long the names are.
+ */
 struct memorized_terrain_tile {
-    std::string tile;
-    int subtile;
-    int rotation;
+    /** Index of the name in the table of interned names, 0 is the empty name. */
+    uint32_t tile_id = 0;
+    int16_t subtile = 0;
+    int16_t rotation = 0;
+
+    memorized_terrain_tile() = default;
+    memorized_terrain_tile( const std::string &tile, int subtile, int rotation );
+
+    /** Name of the tile, empty if nothing is memorized. */
+    const std::string &tile() const;
+
+    /** Interned index of @p name, interning it if needed. */
+    static uint32_t intern( const std::string &name );
+    /** The name interned as @p id. */
+    static const std::string &name_of( uint32_t id );
 
     inline bool operator==( const memorized_terrain_tile &rhs ) const {
-        return ( rotation == rhs.rotation ) && ( subtile == rhs.subtile ) && ( tile == rhs.tile );
+        return ( rotation == rhs.rotation ) && ( subtile == rhs.subtile ) &&
+               ( tile_id == rhs.tile_id );
     }
 
     inline bool operator!=( const memorized_terrain_tile &rhs ) const {
@@ -81,8 +103,16 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
+        /**
+         * Tiles are written with the index of their name in the list of names of the region,
+         * @p region_ids maps interned ids to those indices.
+         */
+        void serialize( JsonOut &jsout,
+                        const std::unordered_map<uint32_t, int> &region_ids ) const;
+        /** Reads a submap saved before names were listed per region, with names in each tile. */
         void deserialize( const JsonValue &ja );
+        /** @p interned_ids maps the indices in the list of names of the region to interned ids. */
+        void deserialize( const JsonValue &ja, const std::vector<uint32_t> &interned_ids );
 
     private:
         // NOLINTNEXTLINE(cata-serialize)
@@ -96,6 +126,7 @@ struct mm_submap {
  * Represents a square of mm_submaps.
  * For faster save/load, submaps are collected into regions
  * and each region is saved in its own file.
+ * The file lists the names of the tiles used in the region once, tiles refer to them by index.
  */
 struct mm_region {
     cata::mdarray<shared_ptr_fast<mm_submap>, point, MM_REG_SIZE, MM_REG_SIZE> submaps;
@@ -181,7 +212,7 @@ class map_memory
         void clear_memorized_tile( const tripoint &pos );
 
     private:
-        std::map<tripoint, shared_ptr_fast<mm_submap>> submaps;
+        std::unordered_map<tripoint, shared_ptr_fast<mm_submap>> submaps;
 
         std::vector<shared_ptr_fast<mm_submap>> cached;
         tripoint cache_pos;
@@ -274,7 +274,7 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
         return FLT_MAX;
     }
 
-    if( !sees( c ) ) {
+    if( !get_creature_tracker().visibility().sees( *this, c ) ) {
         return FLT_MAX;
     }
 
@@ -327,9 +327,16 @@ void monster::plan()
     bool swarms = has_flag( MF_SWARMS );
     monster_attitude mood = attitude();
     Character &player_character = get_player_character();
+    creature_tracker &creatures = get_creature_tracker();
+    visibility_matrix &visibility = creatures.visibility();
+    // Candidates further away than this can't be rated better than the current target,
+    // see rate_target. Smart planning rates by power as well, so it can't be limited.
+    const auto target_radius = [smart_planning]( float best ) {
+        return smart_planning ? -1 : static_cast<int>( std::ceil( best ) );
+    };
     // If we can see the player, move toward them or flee.
     if( friendly == 0 && seen_levels.test( player_character.pos().z + OVERMAP_DEPTH ) &&
-        sees( player_character ) ) {
+        visibility.sees( *this, player_character ) ) {
         dist = rate_target( player_character, dist, smart_planning );
         fleeing = fleeing || is_fleeing( player_character );
         target = &player_character;
@@ -391,9 +398,10 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 && tmp.attitude_to( *this ) == Attitude::HOSTILE &&
-                seen_levels.test( tmp.pos().z + OVERMAP_DEPTH ) ) {
+        for( monster *candidate : creatures.monsters_near( get_location(), target_radius( dist ),
+                seen_levels ) ) {
+            monster &tmp = *candidate;
+            if( tmp.friendly == 0 && tmp.attitude_to( *this ) == Attitude::HOSTILE ) {
                 float rating = rate_target( tmp, dist, smart_planning );
                 if( rating < dist ) {
                     target = &tmp;
@@ -494,47 +502,33 @@ void monster::plan()
                                  turns_since_target );
     int turns_to_skip = max_turns_to_skip * rate_limiting_factor;
     if( friendly == 0 && ( turns_to_skip == 0 || turns_since_target % turns_to_skip == 0 ) ) {
-        for( const auto &fac_list : factions ) {
-            mf_attitude faction_att = faction.obj().attitude( fac_list.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
-            }
-
-            for( const auto &fac : fac_list.second ) {
-                if( !seen_levels.test( fac.first + OVERMAP_DEPTH ) ) {
-                    continue;
+        // Every hostile counts towards anger and morale below, not only those in range
+        for( monster *hostile : creatures.hostile_monsters_near( faction, get_location(), -1,
+                seen_levels ) ) {
+            monster &mon = *hostile;
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = &mon;
                 }
-                for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                    const shared_ptr_fast<monster> shared = weak.lock();
-                    if( !shared ) {
-                        continue;
-                    }
-                    monster &mon = *shared;
-                    float rating = rate_target( mon, dist, smart_planning );
-                    if( rating == dist ) {
-                        ++valid_targets;
-                        if( one_in( valid_targets ) ) {
-                            target = &mon;
-                        }
-                    }
-                    if( rating < dist ) {
-                        target = &mon;
-                        dist = rating;
-                        valid_targets = 1;
-                    }
-                    if( rating <= 5 ) {
-                        if( anger <= 30 ) {
-                            anger += angers_hostile_near;
-                        }
-                        morale -= fears_hostile_near;
-                    }
-                    if( !fleeing && anger <= 20 && valid_targets != 0 ) {
-                        anger += angers_hostile_seen;
-                    }
-                    if( !fleeing && valid_targets != 0 ) {
-                        morale -= fears_hostile_seen;
-                    }
+            }
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                if( anger <= 30 ) {
+                    anger += angers_hostile_near;
                 }
+                morale -= fears_hostile_near;
+            }
+            if( !fleeing && anger <= 20 && valid_targets != 0 ) {
+                anger += angers_hostile_seen;
+            }
+            if( !fleeing && valid_targets != 0 ) {
+                morale -= fears_hostile_seen;
             }
         }
     }
@@ -682,7 +676,7 @@ void monster::plan()
     } else if( friendly > 0 && one_in( 3 ) ) {
         // Grow restless with no targets
         friendly--;
-    } else if( friendly < 0 && sees( player_character ) &&
+    } else if( friendly < 0 && visibility.sees( *this, player_character ) &&
                // Simpleminded animals are too dumb to follow the player.
                !has_flag( MF_PET_WONT_FOLLOW ) ) {
         if( rl_dist( get_location(), player_character.get_location() ) > 2 ) {
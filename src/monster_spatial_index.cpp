@@ -0,0 +1,141 @@
+#include "monster_spatial_index.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "item.h"
+#include "monfaction.h"
+#include "monster.h"
+
+static const mfaction_str_id monfaction_player( "player" );
+
+// order within a bucket or faction does not matter
+static bool erase_from( std::vector<monster *> &monsters, const monster &critter )
+{
+    const auto iter = std::find( monsters.begin(), monsters.end(), &critter );
+    if( iter == monsters.end() ) {
+        return false;
+    }
+    *iter = monsters.back();
+    monsters.pop_back();
+    return true;
+}
+
+void monster_spatial_index::add( monster &critter, const tripoint_abs_ms &loc )
+{
+    buckets[bucket_of( loc )].push_back( &critter );
+    const mfaction_id faction = faction_of( critter );
+    const auto inserted = listed_faction.emplace( &critter, faction );
+    if( inserted.second ) {
+        faction_members[faction].push_back( &critter );
+    }
+}
+
+void monster_spatial_index::remove( const monster &critter, const tripoint_abs_ms &loc )
+{
+    const auto listed = listed_faction.find( &critter );
+    if( listed != listed_faction.end() ) {
+        erase_from( faction_members[listed->second], critter );
+        listed_faction.erase( listed );
+    }
+    remove_from_buckets( critter, loc );
+}
+
+void monster_spatial_index::remove_from_buckets( const monster &critter,
+        const tripoint_abs_ms &loc )
+{
+    const auto erase_from_bucket = [&critter]( std::vector<monster *> &bucket ) {
+        return erase_from( bucket, critter );
+    };
+    const auto bucket_iter = buckets.find( bucket_of( loc ) );
+    if( bucket_iter != buckets.end() && erase_from_bucket( bucket_iter->second ) ) {
+        return;
+    }
+    // It might have been indexed at another location, so look for it.
+    for( std::pair<const tripoint, std::vector<monster *>> &bucket : buckets ) {
+        if( erase_from_bucket( bucket.second ) ) {
+            return;
+        }
+    }
+}
+
+void monster_spatial_index::move( monster &critter, const tripoint_abs_ms &old_loc,
+                                  const tripoint_abs_ms &new_loc )
+{
+    if( bucket_of( old_loc ) == bucket_of( new_loc ) ) {
+        return;
+    }
+    remove_from_buckets( critter, old_loc );
+    buckets[bucket_of( new_loc )].push_back( &critter );
+}
+
+void monster_spatial_index::clear()
+{
+    buckets.clear();
+    faction_members.clear();
+    listed_faction.clear();
+}
+
+mfaction_id monster_spatial_index::faction_of( const monster &critter )
+{
+    return critter.friendly == 0 ? critter.faction : monfaction_player.id();
+}
+
+void monster_spatial_index::refresh_faction( monster &critter )
+{
+    const auto listed = listed_faction.find( &critter );
+    if( listed == listed_faction.end() ) {
+        return;
+    }
+    const mfaction_id faction = faction_of( critter );
+    if( listed->second == faction ) {
+        return;
+    }
+    erase_from( faction_members[listed->second], critter );
+    faction_members[faction].push_back( &critter );
+    listed->second = faction;
+}
+
+void monster_spatial_index::collect( const tripoint_abs_ms &center, int radius,
+                                     const std::bitset<OVERMAP_LAYERS> &levels,
+                                     std::vector<monster *> &result ) const
+{
+    const auto in_range = [&]( const monster &critter ) {
+        const tripoint_abs_ms loc = critter.get_location();
+        return ( radius < 0 || ( std::abs( loc.x() - center.x() ) <= radius &&
+                                 std::abs( loc.y() - center.y() ) <= radius ) ) &&
+               loc.z() >= -OVERMAP_DEPTH && loc.z() <= OVERMAP_HEIGHT &&
+               levels.test( loc.z() + OVERMAP_DEPTH );
+    };
+    const auto collect_bucket = [&]( const std::vector<monster *> &bucket ) {
+        for( monster *critter : bucket ) {
+            if( in_range( *critter ) ) {
+                result.push_back( critter );
+            }
+        }
+    };
+
+    const tripoint min_bucket = bucket_of( center - tripoint( radius, radius, 0 ) );
+    const tripoint max_bucket = bucket_of( center + tripoint( radius, radius, 0 ) );
+    if( radius < 0 || static_cast<size_t>( max_bucket.x - min_bucket.x + 1 ) *
+        ( max_bucket.y - min_bucket.y + 1 ) * levels.count() >= buckets.size() ) {
+        // Looking at every bucket is cheaper than looking up all buckets in range.
+        for( const std::pair<const tripoint, std::vector<monster *>> &bucket : buckets ) {
+            collect_bucket( bucket.second );
+        }
+        return;
+    }
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        if( !levels.test( z + OVERMAP_DEPTH ) ) {
+            continue;
+        }
+        for( int x = min_bucket.x; x <= max_bucket.x; x++ ) {
+            for( int y = min_bucket.y; y <= max_bucket.y; y++ ) {
+                const auto iter = buckets.find( tripoint( x, y, z ) );
+                if( iter != buckets.end() ) {
+                    collect_bucket( iter->second );
+                }
+            }
+        }
+    }
+}
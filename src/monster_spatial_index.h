@@ -0,0 +1,71 @@
+#pragma once
+#ifndef CATA_SRC_MONSTER_SPATIAL_INDEX_H
+#define CATA_SRC_MONSTER_SPATIAL_INDEX_H
+
+#include <bitset>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinates.h"
+#include "game_constants.h"
+#include "point.h"
+#include "type_id.h"
+
+class monster;
+
+/**
+ * Index of monsters by their location and by their faction.
+ *
+ * Monsters are stored in buckets of a coarse grid, so finding the monsters near a point only
+ * looks at the buckets around it instead of all monsters. The index must be told about every
+ * change of a monsters location, @ref creature_tracker does this alongside its own map of
+ * monsters by location.
+ *
+ * Monsters are also listed by their faction, see @ref faction_of, so finding the monsters of
+ * some factions at any distance does not look at the others. Factions change without the
+ * index being told, @ref refresh_faction has to be called for that.
+ */
+class monster_spatial_index
+{
+    public:
+        void add( monster &critter, const tripoint_abs_ms &loc );
+        /** Removes the monster, which is expected (but not required) to be at @p loc. */
+        void remove( const monster &critter, const tripoint_abs_ms &loc );
+        void move( monster &critter, const tripoint_abs_ms &old_loc,
+                   const tripoint_abs_ms &new_loc );
+        void clear();
+        /**
+         * Appends the monsters that are at most @p radius tiles away from @p center in x and y
+         * direction and on one of the given z-levels to @p result. A negative @p radius
+         * means any distance.
+         * The order of the monsters is unspecified.
+         */
+        void collect( const tripoint_abs_ms &center, int radius,
+                      const std::bitset<OVERMAP_LAYERS> &levels,
+                      std::vector<monster *> &result ) const;
+
+        /** The faction the monster belongs to, friendly monsters belong to the player faction. */
+        static mfaction_id faction_of( const monster &critter );
+        /** Lists the monster under its current faction if it changed since it was added. */
+        void refresh_faction( monster &critter );
+        /** The monsters listed under each faction, in no particular order. */
+        const std::unordered_map<mfaction_id, std::vector<monster *>> &by_faction() const {
+            return faction_members;
+        }
+
+    private:
+        // size of the buckets in x and y direction
+        static constexpr int bucket_size = 12;
+
+        static tripoint bucket_of( const tripoint_abs_ms &loc ) {
+            return divide_xy_round_to_minus_infinity( loc.raw(), bucket_size );
+        }
+        void remove_from_buckets( const monster &critter, const tripoint_abs_ms &loc );
+
+        std::unordered_map<tripoint, std::vector<monster *>> buckets;
+        std::unordered_map<mfaction_id, std::vector<monster *>> faction_members;
+        /** The faction each monster is listed under in @ref faction_members. */
+        std::unordered_map<const monster *, mfaction_id> listed_faction;
+};
+
+#endif // CATA_SRC_MONSTER_SPATIAL_INDEX_H
@@ -555,6 +555,10 @@ struct npc_short_term_cache {
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
+    // action chosen by the last full run of the AI, see npc::reuse_last_plan
+    npc_action last_action{};
+    // how often the last plan was reused since the AI last ran
+    int plans_reused = 0;
     // returns the value of the distance between a friendly creature and the closest enemy to that
     // friendly creature.
     // returns nullopt if not applicable
@@ -960,6 +964,18 @@ class npc : public Character
 
         // AI helpers
         void regen_ai_cache();
+        /**
+         * Whether the AI has to run this turn even when the NPC AI is over its time budget
+         * (see @ref npc_ai_blackboard), because the NPC is in danger, near the player, has
+         * an activity or has reused its last plan too often.
+         */
+        bool ai_is_urgent() const;
+        /**
+         * Keeps doing what the AI decided last time (waiting or walking along the path)
+         * without deciding again. Returns whether that used any moves, if not @ref move
+         * has to be called instead.
+         */
+        bool reuse_last_plan();
         const Creature *current_target() const;
         Creature *current_target();
         const Creature *current_ally() const;
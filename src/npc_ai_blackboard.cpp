@@ -0,0 +1,158 @@
+#include "npc_ai_blackboard.h"
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include "debug.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "mapdata.h"
+#include "messages.h"
+#include "npc.h"
+#include "output.h"
+#include "overmapbuffer.h"
+#include "vpart_position.h"
+#include "vehicle.h"
+#include "veh_type.h"
+
+void npc_ai_blackboard::invalidate()
+{
+    turn = calendar::turn;
+    followers_valid = false;
+    follower_ptrs.clear();
+    follower_list.clear();
+    fires_valid.assign( OVERMAP_LAYERS, false );
+    fires.resize( OVERMAP_LAYERS );
+    items_generation = -1;
+    item_counts.clear();
+}
+
+void npc_ai_blackboard::validate()
+{
+    if( turn != calendar::turn ) {
+        invalidate();
+    }
+}
+
+const std::vector<npc *> &npc_ai_blackboard::followers()
+{
+    validate();
+    if( !followers_valid ) {
+        for( const character_id &id : g->get_follower_list() ) {
+            shared_ptr_fast<npc> guy = overmap_buffer.find_npc( id );
+            if( guy ) {
+                follower_list.push_back( guy.get() );
+                follower_ptrs.emplace_back( std::move( guy ) );
+            }
+        }
+        followers_valid = true;
+    }
+    return follower_list;
+}
+
+const std::vector<tripoint_abs_ms> &npc_ai_blackboard::fires_on_level( int z )
+{
+    validate();
+    const int level = z + OVERMAP_DEPTH;
+    if( level < 0 || level >= OVERMAP_LAYERS ) {
+        static const std::vector<tripoint_abs_ms> none;
+        return none;
+    }
+    std::vector<tripoint_abs_ms> &result = fires[level];
+    if( fires_valid[level] ) {
+        return result;
+    }
+    result.clear();
+    fires_valid[level] = true;
+
+    map &here = get_map();
+    for( const tripoint &p : here.get_fires( z ) ) {
+        if( !here.has_flag( ter_furn_flag::TFLAG_FIRE_CONTAINER, p ) ) {
+            result.push_back( here.getglobal( p ) );
+        }
+    }
+    return result;
+}
+
+int npc_ai_blackboard::item_count( const tripoint &p )
+{
+    validate();
+    if( items_generation != map::contents_generation() ) {
+        items_generation = map::contents_generation();
+        item_counts.clear();
+    }
+    map &here = get_map();
+    const tripoint_abs_ms abs_p = here.getglobal( p );
+    const auto iter = item_counts.find( abs_p );
+    if( iter != item_counts.end() ) {
+        return iter->second;
+    }
+    int count = here.i_at( p ).size();
+    const optional_vpart_position vp = here.veh_at( p );
+    if( vp ) {
+        const std::optional<vpart_reference> cargo = vp.part_with_feature( VPFLAG_CARGO, true );
+        if( cargo ) {
+            count += cargo->vehicle().get_items( cargo->part_index() ).size();
+        }
+    }
+    item_counts.emplace( abs_p, count );
+    return count;
+}
+
+void npc_ai_blackboard::start_ai_turn( std::chrono::microseconds budget )
+{
+    ai_budget = budget;
+    ai_time_total = std::chrono::microseconds::zero();
+    deferred_this_turn.clear();
+    ai_time_this_turn.clear();
+}
+
+void npc_ai_blackboard::record_deferred_ai( const npc &guy )
+{
+    deferred_this_turn.push_back( guy.getID() );
+}
+
+void npc_ai_blackboard::record_ai_time( const npc &guy, std::chrono::microseconds time )
+{
+    ai_time_this_turn[guy.getID()] += time;
+    ai_time_total += time;
+}
+
+std::chrono::microseconds npc_ai_blackboard::ai_time( const npc &guy ) const
+{
+    const auto iter = ai_time_last_turn.find( guy.getID() );
+    return iter == ai_time_last_turn.end() ? std::chrono::microseconds::zero() : iter->second;
+}
+
+void npc_ai_blackboard::report_ai_time()
+{
+    if( ai_time_this_turn.empty() ) {
+        return;
+    }
+    std::chrono::microseconds total = std::chrono::microseconds::zero();
+    std::pair<character_id, std::chrono::microseconds> slowest = *ai_time_this_turn.begin();
+    for( const std::pair<const character_id, std::chrono::microseconds> &entry :
+         ai_time_this_turn ) {
+        total += entry.second;
+        if( entry.second > slowest.second ) {
+            slowest = entry;
+        }
+    }
+    const auto name_of = []( const character_id & id ) -> std::string {
+        const npc *guy = g->find_npc( id );
+        return guy ? guy->get_name() : "unknown";
+    };
+    add_msg_debug( debugmode::DF_NPC, "NPC AI of %d NPCs took %d us, slowest was %s with %d us",
+                   ai_time_this_turn.size(), total.count(), name_of( slowest.first ),
+                   slowest.second.count() );
+    if( !deferred_this_turn.empty() ) {
+        add_msg_debug( debugmode::DF_NPC, "NPC AI over budget of %d us, reused the last plan of %s",
+                       ai_budget.count(), enumerate_as_string( deferred_this_turn, name_of ) );
+    }
+    deferred_last_turn = deferred_this_turn.size();
+    deferred_this_turn.clear();
+    ai_time_last_turn = std::move( ai_time_this_turn );
+    ai_time_this_turn.clear();
+}
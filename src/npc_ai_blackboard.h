@@ -0,0 +1,94 @@
+#pragma once
+#ifndef CATA_SRC_NPC_AI_BLACKBOARD_H
+#define CATA_SRC_NPC_AI_BLACKBOARD_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "calendar.h"
+#include "character_id.h"
+#include "coordinates.h"
+#include "memory_fast.h"
+#include "point.h"
+
+class npc;
+
+/**
+ * State of the world that the AI of all NPCs looks at, collected once per turn instead of
+ * once per NPC (or once per item an NPC considers).
+ *
+ * Everything is collected lazily and kept until the turn changes or @ref invalidate is
+ * called. The game calls @ref invalidate before the NPCs move, so changes done by the
+ * player and the monsters are visible to the NPCs.
+ *
+ * Also records how long each NPC spent thinking, see @ref record_ai_time, and keeps the
+ * time spent within a budget: once the NPCs of this turn took longer than the budget, NPCs
+ * whose AI is not urgent (@ref npc::ai_is_urgent) reuse their last plan instead of deciding
+ * again (@ref npc::reuse_last_plan).
+ */
+class npc_ai_blackboard
+{
+    public:
+        /** Drops everything collected so far. */
+        void invalidate();
+
+        /** The NPCs following the player that are loaded. */
+        const std::vector<npc *> &followers();
+        /** Locations of fires that are not contained (@ref ter_furn_flag::TFLAG_FIRE_CONTAINER). */
+        const std::vector<tripoint_abs_ms> &fires_on_level( int z );
+        /**
+         * Number of items on the given tile, including those in vehicle cargo.
+         * Cached until the contents of the map change, see @ref map::contents_generation.
+         */
+        int item_count( const tripoint &p );
+
+        /** Starts recording the AI time of a new turn, 0 means no budget. */
+        void start_ai_turn( std::chrono::microseconds budget );
+        /** Whether the NPCs used up the AI time budget of this turn. */
+        bool ai_over_budget() const {
+            return ai_budget.count() > 0 && ai_time_total >= ai_budget;
+        }
+        /** Records that @p guy reused its last plan this turn because of the budget. */
+        void record_deferred_ai( const npc &guy );
+        /** Number of NPCs that reused their last plan during the last reported turn. */
+        int deferred_ai_count() const {
+            return deferred_last_turn;
+        }
+        /** Adds time spent in the AI of @p guy this turn. */
+        void record_ai_time( const npc &guy, std::chrono::microseconds time );
+        /** Time spent in the AI of @p guy during the last turn it was recorded for. */
+        std::chrono::microseconds ai_time( const npc &guy ) const;
+        /** Logs the AI time of this turn (if any was recorded) and starts a new turn. */
+        void report_ai_time();
+
+    private:
+        /** Calls @ref invalidate if the turn changed since the last call. */
+        void validate();
+
+        time_point turn = calendar::before_time_starts;
+
+        bool followers_valid = false;
+        std::vector<shared_ptr_fast<npc>> follower_ptrs;
+        std::vector<npc *> follower_list;
+
+        // indexed by z-level + OVERMAP_DEPTH, invalid entries have not been collected
+        std::vector<bool> fires_valid;
+        std::vector<std::vector<tripoint_abs_ms>> fires;
+
+        int64_t items_generation = -1;
+        std::unordered_map<tripoint_abs_ms, int> item_counts;
+
+        std::chrono::microseconds ai_budget = std::chrono::microseconds::zero();
+        std::chrono::microseconds ai_time_total = std::chrono::microseconds::zero();
+        std::vector<character_id> deferred_this_turn;
+        int deferred_last_turn = 0;
+        std::map<character_id, std::chrono::microseconds> ai_time_this_turn;
+        std::map<character_id, std::chrono::microseconds> ai_time_last_turn;
+};
+
+npc_ai_blackboard &get_npc_ai_blackboard();
+
+#endif // CATA_SRC_NPC_AI_BLACKBOARD_H
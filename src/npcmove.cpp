@@ -54,6 +54,7 @@
 #include "mission.h"
 #include "monster.h"
 #include "mtype.h"
+#include "npc_ai_blackboard.h"
 #include "npc_attack.h"
 #include "npctalk.h"
 #include "omdata.h"
@@ -476,13 +477,10 @@ void npc::assess_danger()
         cur_threat_map[ threat_dir ] = 0.25f * ai_cache.threat_map[ threat_dir ];
     }
     map &here = get_map();
-    // cache string_id -> int_id conversion before hot loop
-    const field_type_id fd_fire = ::fd_fire;
     // first, check if we're about to be consumed by fire
-    // `map::get_field` uses `field_cache`, so in general case (no fire) it provides an early exit
-    for( const tripoint &pt : here.points_in_radius( pos(), 6 ) ) {
-        if( pt == pos() || !here.get_field( pt, fd_fire ) ||
-            here.has_flag( ter_furn_flag::TFLAG_FIRE_CONTAINER,  pt ) ) {
+    for( const tripoint_abs_ms &fire : get_npc_ai_blackboard().fires_on_level( posz() ) ) {
+        const tripoint pt = here.getlocal( fire );
+        if( pt == pos() || std::abs( pt.x - posx() ) > 6 || std::abs( pt.y - posy() ) > 6 ) {
             continue;
         }
         int dist = rl_dist( pos(), pt );
@@ -531,7 +529,7 @@ void npc::assess_danger()
             ai_cache.neutral_guys.emplace_back( g->shared_from( critter ) );
             continue;
         }
-        if( !sees( critter ) ) {
+        if( !get_creature_tracker().visibility().sees( *this, critter ) ) {
             continue;
         }
 
@@ -789,6 +787,37 @@ void npc::regen_ai_cache()
     }
 }
 
+bool npc::ai_is_urgent() const
+{
+    // How often the last plan may be reused before the AI has to run again.
+    constexpr int max_plans_reused = 10;
+    // NPCs this close to the player are likely to be watched or talked to.
+    constexpr int player_near = SEEX;
+    if( ai_cache.plans_reused >= max_plans_reused || ai_cache.danger_assessment > 0 ||
+        !ai_cache.target.expired() || !ai_cache.sound_alerts.empty() ||
+        !ai_cache.dangerous_explosives.empty() || has_effect( effect_npc_run_away ) ||
+        has_effect( effect_npc_fire_bad ) || is_enemy() || is_walking_with() ||
+        attitude == NPCATT_TALK || !activity.is_null() ) {
+        return true;
+    }
+    return rl_dist( get_location(), get_player_character().get_location() ) <= player_near;
+}
+
+bool npc::reuse_last_plan()
+{
+    const int old_moves = moves;
+    if( ai_cache.last_action == npc_pause ) {
+        move_pause();
+    } else if( ai_cache.last_action == npc_goto_destination && !path.empty() ) {
+        move_to_next();
+    }
+    if( moves == old_moves ) {
+        return false;
+    }
+    ai_cache.plans_reused++;
+    return true;
+}
+
 void npc::move()
 {
     // don't just return from this function without doing something
@@ -800,6 +829,9 @@ void npc::move()
         set_attitude( NPCATT_NULL );
     }
     regen_ai_cache();
+    // Paths that return before execute_action leave no plan that could be reused
+    ai_cache.last_action = npc_undecided;
+    ai_cache.plans_reused = 0;
     // NPCs under operation should just stay still
     if( activity.id() == ACT_OPERATION || activity.id() == ACT_SPELLCASTING ) {
         execute_action( npc_player_activity );
@@ -1052,6 +1084,8 @@ void npc::move()
 
 void npc::execute_action( npc_action action )
 {
+    ai_cache.last_action = action;
+    ai_cache.plans_reused = 0;
     int oldmoves = moves;
     tripoint tar = pos();
     Creature *cur = current_target();
@@ -2874,17 +2908,8 @@ void npc::find_item()
     const auto consider_item =
         [&wanted, &best_value, this]
     ( const item & it, const tripoint & p ) {
-        std::vector<npc *> followers;
-        for( const character_id &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
         viewer &player_view = get_player_view();
-        for( npc *&elem : followers ) {
+        for( npc *elem : get_npc_ai_blackboard().followers() ) {
             if( !it.is_owned_by( *this, true ) && ( player_view.sees( this->pos() ) ||
                                                     player_view.sees( wanted_item_pos ) ||
                                                     elem->sees( this->pos() ) || elem->sees( wanted_item_pos ) ) ) {
@@ -2929,16 +2954,7 @@ void npc::find_item()
         const tripoint abs_p = get_location().raw() - pos() + p;
         const int prev_num_items = ai_cache.searched_tiles.get( abs_p, -1 );
         // Prefetch the number of items present so we can bail out if we already checked here.
-        const map_stack m_stack = here.i_at( p );
-        int num_items = m_stack.size();
-        const optional_vpart_position vp = here.veh_at( p );
-        if( vp ) {
-            const std::optional<vpart_reference> cargo = vp.part_with_feature( VPFLAG_CARGO, true );
-            if( cargo ) {
-                vehicle_stack v_stack = cargo->vehicle().get_items( cargo->part_index() );
-                num_items += v_stack.size();
-            }
-        }
+        const int num_items = get_npc_ai_blackboard().item_count( p );
         if( prev_num_items == num_items ) {
             continue;
         }
@@ -2950,7 +2966,7 @@ void npc::find_item()
         bool can_see = false;
         if( here.sees_some_items( p, *this ) && sees( p ) ) {
             can_see = true;
-            for( const item &it : m_stack ) {
+            for( const item &it : here.i_at( p ) ) {
                 consider_item( it, p );
             }
         }
@@ -2961,6 +2977,7 @@ void npc::find_item()
             consider_terrain( p );
         }
 
+        const optional_vpart_position vp = here.veh_at( p );
         if( !vp || vp->vehicle().is_moving() || !( can_see || sees( p ) ) ) {
             cache_tile();
             continue;
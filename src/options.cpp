@@ -1943,6 +1943,11 @@ void options_manager::add_options_interface()
          false
        );
 
+    add( "OVERMAP_SEARCH_ALL", "interface", to_translation( "Search all loaded overmaps" ),
+         to_translation( "If true, searching the overmap finds places in all loaded overmaps rather than only around the cursor." ),
+         false
+       );
+
     add_empty_line();
 
     add( "SIDEBAR_POSITION", "interface", to_translation( "Sidebar position" ),
@@ -2530,6 +2535,11 @@ void options_manager::add_options_graphics()
          false, COPT_CURSES_HIDE
        );
 
+    add( "BATCH_SPRITES", "graphics", to_translation( "Batch sprites" ),
+         to_translation( "If true, the sprites of the map are drawn in batches, which is faster with most renderers.  Requires SDL 2.0.18 or newer, otherwise sprites are drawn one by one." ),
+         true, COPT_CURSES_HIDE
+       );
+
     add( "SCALING_MODE", "graphics", to_translation( "Scaling mode" ),
          to_translation( "Sets the scaling mode, 'none' (default) displays at the game's native resolution, 'nearest' uses low-quality but fast scaling, and 'linear' provides high-quality scaling." ),
          //~ Do not scale the game image to the window size.
@@ -2927,6 +2937,13 @@ void options_manager::add_options_debug()
 
     add_empty_line();
 
+    add( "NPC_AI_BUDGET", "debug", to_translation( "NPC AI time budget" ),
+         to_translation( "How many microseconds per turn the NPCs may spend deciding what to do.  When they take longer, NPCs that are not busy, in danger or near the player keep following their last plan for a few turns.  0 means no limit." ),
+         0, 1000000, 0
+       );
+
+    add_empty_line();
+
     add( "PREVENT_OCCLUSION", "debug", to_translation( "Handle occlusion by high sprites" ),
     to_translation( "Draw walls normal (Off), retracted/transparent (On), or automatically retracting/transparent near player (Auto)." ), {
         { 0, to_translation( "Off" ) }, { 1, to_translation( "On" ) },
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <exception>
 #include <istream>
@@ -2948,6 +2949,12 @@ oter_id overmap::get_default_terrain( int z ) const
     return settings->default_oter[OVERMAP_DEPTH + z].id();
 }
 
+static uint64_t new_travel_revision()
+{
+    static uint64_t last_revision = 0;
+    return ++last_revision;
+}
+
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
@@ -2956,6 +2963,30 @@ void overmap::init_layers()
         l.terrain.fill( tid );
         l.visible.fill( false );
         l.explored.fill( false );
+        seen_index[k].valid = false;
+        touch_travel( k - OVERMAP_DEPTH );
+    }
+}
+
+uint64_t overmap::travel_revision( const tripoint_om_omt &p ) const
+{
+    if( !inbounds( p ) ) {
+        return 0;
+    }
+    return travel_revisions[p.z() + OVERMAP_DEPTH][p.y() / travel_sector_size * travel_sectors +
+            p.x() / travel_sector_size];
+}
+
+void overmap::touch_travel( const tripoint_om_omt &p )
+{
+    travel_revisions[p.z() + OVERMAP_DEPTH][p.y() / travel_sector_size * travel_sectors +
+            p.x() / travel_sector_size] = new_travel_revision();
+}
+
+void overmap::touch_travel( const int z )
+{
+    for( uint64_t &revision : travel_revisions[z + OVERMAP_DEPTH] ) {
+        revision = new_travel_revision();
     }
 }
 
@@ -2970,6 +3001,12 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     if( id->has_flag( oter_flags::requires_predecessor ) ) {
         predecessors_[p].push_back( val );
     }
+    if( val != id ) {
+        if( seen( p ) ) {
+            seen_index[p.z() + OVERMAP_DEPTH].valid = false;
+        }
+        touch_travel( p );
+    }
     val = id;
 }
 
@@ -3026,6 +3063,14 @@ void overmap::set_seen( const tripoint_om_omt &p, bool val )
     }
 
     layer[p.z() + OVERMAP_DEPTH].visible[p.xy()] = val;
+    touch_travel( p );
+
+    seen_terrain_index &index = seen_index[p.z() + OVERMAP_DEPTH];
+    if( !val ) {
+        index.valid = false;
+    } else if( index.valid ) {
+        index.points[ter( p )].push_back( p.xy() );
+    }
 
     if( val ) {
         add_extra_note( p );
@@ -3139,17 +3184,9 @@ bool overmap::is_marked_dangerous( const tripoint_om_omt &p ) const
         } else if( p.xy() == i.p ) {
             return true;
         }
-        const int radius = i.danger_radius;
-        if( i.danger_radius == 0 && i.p != p.xy() ) {
-            continue;
-        }
-        for( int x = -radius; x <= radius; x++ ) {
-            for( int y = -radius; y <= radius; y++ ) {
-                const tripoint_om_omt rad_point = tripoint_om_omt( i.p, p.z() ) + point( x, y );
-                if( p.xy() == rad_point.xy() ) {
-                    return true;
-                }
-            }
+        if( std::abs( p.x() - i.p.x() ) <= i.danger_radius &&
+            std::abs( p.y() - i.p.y() ) <= i.danger_radius ) {
+            return true;
         }
     }
     return false;
@@ -3188,6 +3225,9 @@ void overmap::add_note( const tripoint_om_omt &p, std::string message )
     } else if( !message.empty() ) {
         it->text = std::move( message );
     } else {
+        if( it->dangerous ) {
+            touch_travel( p.z() );
+        }
         notes.erase( it );
     }
 }
@@ -3198,6 +3238,7 @@ void overmap::mark_note_dangerous( const tripoint_om_omt &p, int radius, bool is
         if( p.xy() == i.p ) {
             i.dangerous = is_dangerous;
             i.danger_radius = radius;
+            touch_travel( p.z() );
             return;
         }
     }
@@ -3836,6 +3877,42 @@ std::vector<point_abs_omt> overmap::find_terrain( const std::string &term, int z
     return found;
 }
 
+const overmap::seen_terrain_index &overmap::get_seen_index( const int z ) const
+{
+    seen_terrain_index &index = seen_index[z + OVERMAP_DEPTH];
+    if( !index.valid ) {
+        index.points.clear();
+        const map_layer &l = layer[z + OVERMAP_DEPTH];
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                const point_om_omt p( x, y );
+                if( l.visible[p] ) {
+                    index.points[l.terrain[p]].push_back( p );
+                }
+            }
+        }
+        index.valid = true;
+    }
+    return index;
+}
+
+std::vector<point_abs_omt> overmap::find_seen_terrain( const std::string &term,
+        const int zlevel ) const
+{
+    std::vector<point_abs_omt> found;
+    if( zlevel < -OVERMAP_DEPTH || zlevel > OVERMAP_HEIGHT ) {
+        return found;
+    }
+    for( const auto &type_points : get_seen_index( zlevel ).points ) {
+        if( match_include_exclude( type_points.first->get_name(), term ) ) {
+            for( const point_om_omt &p : type_points.second ) {
+                found.push_back( project_combine( pos(), p ) );
+            }
+        }
+    }
+    return found;
+}
+
 const city &overmap::get_nearest_city( const tripoint_om_omt &p ) const
 {
     int distance = 999;
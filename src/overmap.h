@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -264,8 +265,24 @@ class overmap
          * coordinates), or empty vector if no matching terrain is found.
          */
         std::vector<point_abs_omt> find_terrain( const std::string &term, int zlevel ) const;
+        /**
+         * Like @ref find_terrain, but matching the names with @ref match_include_exclude.
+         * Goes through an index of the seen terrain by type, so each type is matched once,
+         * rather than looking at every terrain of the layer.
+         */
+        std::vector<point_abs_omt> find_seen_terrain( const std::string &term, int zlevel ) const;
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
+        /**
+         * Size of the squares of OMTs travel revisions are kept for, see
+         * @ref pf::omt_travel_graph.
+         */
+        static constexpr int travel_sector_size = 20;
+        /**
+         * Revision of what traveling over the square of OMTs around @p p costs. Changes whenever
+         * their terrain, whether they were seen, or the dangerous notes of their layer do.
+         */
+        uint64_t travel_revision( const tripoint_om_omt &p ) const;
         // ter has bounds checking, and returns ot_null when out of bounds.
         const oter_id &ter( const tripoint_om_omt &p ) const;
         // ter_unsafe is UB when out of bounds.
@@ -389,6 +406,27 @@ class overmap
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
+        // The seen terrain of each layer by type, for searching it. Built the first time the
+        // layer is searched, tiles that become seen are added to it, any other change to the
+        // seen terrain of the layer drops it.
+        struct seen_terrain_index {
+            bool valid = false;
+            std::unordered_map<oter_id, std::vector<point_om_omt>> points;
+        };
+        // NOLINTNEXTLINE(cata-serialize)
+        mutable std::array<seen_terrain_index, OVERMAP_LAYERS> seen_index;
+        const seen_terrain_index &get_seen_index( int z ) const;
+
+        static constexpr int travel_sectors = OMAPX / travel_sector_size;
+        static_assert( OMAPX % travel_sector_size == 0, "travel sectors have to tile the overmap" );
+        // Revisions of the travel sectors of each layer by y * travel_sectors + x, unique among
+        // all overmaps.
+        // NOLINTNEXTLINE(cata-serialize)
+        std::array<std::array<uint64_t, travel_sectors * travel_sectors>, OVERMAP_LAYERS>
+        travel_revisions;
+        void touch_travel( const tripoint_om_omt &p );
+        void touch_travel( int z );
+
         // Records the locations where a given overmap special was placed, which
         // can be used after placement to lookup whether a given location was created
         // as part of a special.
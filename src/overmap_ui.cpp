@@ -1336,30 +1336,9 @@ static bool search( const ui_adaptor &om_ui, tripoint_abs_omt &curs, const tripo
         return false;
     }
 
-    std::vector<point_abs_omt> locations;
-    std::vector<point_abs_om> overmap_checked;
-
-    const int radius = OMAPX; // arbitrary
-    for( const tripoint_abs_omt &p : points_in_radius( curs, radius ) ) {
-        overmap_with_local_coords om_loc = overmap_buffer.get_existing_om_global( p );
-
-        if( om_loc ) {
-            tripoint_om_omt om_relative = om_loc.local;
-            point_abs_om om_cache = project_to<coords::om>( p.xy() );
-
-            if( std::find( overmap_checked.begin(), overmap_checked.end(),
-                           om_cache ) == overmap_checked.end() ) {
-                overmap_checked.push_back( om_cache );
-                std::vector<point_abs_omt> notes = om_loc.om->find_notes( curs.z(), term );
-                locations.insert( locations.end(), notes.begin(), notes.end() );
-            }
-
-            if( om_loc.om->seen( om_relative ) &&
-                match_include_exclude( om_loc.om->ter( om_relative )->get_name(), term ) ) {
-                locations.push_back( project_combine( om_loc.om->pos(), om_relative.xy() ) );
-            }
-        }
-    }
+    // arbitrary, unless all loaded overmaps are searched
+    const int radius = get_option<bool>( "OVERMAP_SEARCH_ALL" ) ? -1 : OMAPX;
+    std::vector<point_abs_omt> locations = overmap_buffer.search( curs, radius, term );
 
     if( locations.empty() ) {
         sfx::play_variant_sound( "menu_error", "default", 100 );
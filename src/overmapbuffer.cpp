@@ -70,6 +70,8 @@ overmapbuffer::overmapbuffer()
 {
 }
 
+overmapbuffer::~overmapbuffer() = default;
+
 const city_reference city_reference::invalid{ nullptr, tripoint_abs_sm(), -1 };
 
 int city_reference::get_distance_from_bounds() const
@@ -252,6 +254,7 @@ void overmapbuffer::clear()
     known_non_existing.clear();
     placed_unique_specials.clear();
     last_requested_overmap = nullptr;
+    travel_graphs.clear();
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -906,15 +909,19 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params )
+bool overmap_path_params::operator==( const overmap_path_params &rhs ) const
+{
+    const auto as_tuple = []( const overmap_path_params & p ) {
+        return std::make_tuple( p.road_cost, p.field_cost, p.dirt_road_cost, p.trail_cost,
+                                p.forest_cost, p.small_building_cost, p.shore_cost, p.swamp_cost,
+                                p.water_cost, p.air_cost, p.other_cost, p.avoid_danger,
+                                p.only_known_by_player );
+    };
+    return as_tuple( *this ) == as_tuple( rhs );
+}
+
+static int get_terrain_cost( const oter_id &oter, const overmap_path_params &params )
 {
-    if( params.only_known_by_player && !overmap_buffer.seen( omt_pos ) ) {
-        return -1;
-    }
-    if( params.avoid_danger && overmap_buffer.is_marked_dangerous( omt_pos ) ) {
-        return -1;
-    }
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     if( ( oter->get_type_id() == oter_type_road ) ||
         ( oter->get_type_id() == oter_type_bridge_road ) ||
         ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
@@ -956,13 +963,81 @@ static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path
     }
 }
 
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
+static bool is_ramp( const oter_id &oter )
 {
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     return ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
            ( oter->get_type_id() == oter_type_bridgehead_ramp );
 }
 
+static_assert( overmap::travel_sector_size == pf::omt_travel_graph::sector_size,
+               "the revisions of the overmap are those of the sectors of the travel graph" );
+
+pf::omt_travel_graph &overmapbuffer::get_travel_graph( const overmap_path_params &params )
+{
+    // The last used graph goes first, the least recently used one is dropped.
+    constexpr size_t max_travel_graphs = 4;
+    const auto it = std::find_if( travel_graphs.begin(), travel_graphs.end(),
+    [&params]( const std::pair<overmap_path_params, std::unique_ptr<pf::omt_travel_graph>> &g ) {
+        return g.first == params;
+    } );
+    if( it != travel_graphs.end() ) {
+        std::rotate( travel_graphs.begin(), it, it + 1 );
+        return *travel_graphs.front().second;
+    }
+    if( travel_graphs.size() >= max_travel_graphs ) {
+        travel_graphs.pop_back();
+    }
+
+    const auto in_layers = []( const tripoint_abs_omt & p ) {
+        return p.z() >= -OVERMAP_DEPTH && p.z() <= OVERMAP_HEIGHT;
+    };
+    pf::omt_travel_graph::revision_fn revision = [this, in_layers](
+    const tripoint_abs_omt & p ) -> uint64_t {
+        if( !in_layers( p ) ) {
+            return 0;
+        }
+        const overmap_with_local_coords om_loc = get_existing_om_global( p );
+        return om_loc ? om_loc.om->travel_revision( om_loc.local ) : 0;
+    };
+    // The terrain costs by type, most of a sector is a few types of terrain.
+    std::unordered_map<oter_id, int> terrain_costs;
+    pf::omt_travel_graph::costs_fn costs = [this, in_layers, params, terrain_costs](
+    const tripoint_abs_omt & origin, pf::omt_travel_graph::sector_costs & sector ) mutable {
+        sector.allow_z_change.reset();
+        if( !in_layers( origin ) ) {
+            sector.cost.fill( -1 );
+            return;
+        }
+        static const oter_id ot_null;
+        const overmap_with_local_coords om_loc = get_existing_om_global( origin );
+        constexpr int size = pf::omt_travel_graph::sector_size;
+        for( int y = 0; y < size; y++ ) {
+            for( int x = 0; x < size; x++ ) {
+                const int i = y * size + x;
+                const tripoint_om_omt local = om_loc.local + point( x, y );
+                if( om_loc && params.avoid_danger && om_loc.om->is_marked_dangerous( local ) ) {
+                    sector.cost[i] = -1;
+                    continue;
+                }
+                if( params.only_known_by_player && !( om_loc && om_loc.om->seen( local ) ) ) {
+                    sector.cost[i] = -1;
+                    continue;
+                }
+                const oter_id &oter = om_loc ? om_loc.om->ter( local ) : ot_null;
+                auto cost = terrain_costs.find( oter );
+                if( cost == terrain_costs.end() ) {
+                    cost = terrain_costs.emplace( oter, get_terrain_cost( oter, params ) ).first;
+                }
+                sector.cost[i] = cost->second;
+                sector.allow_z_change[i] = is_ramp( oter );
+            }
+        }
+    };
+    travel_graphs.emplace( travel_graphs.begin(), params,
+                           std::make_unique<pf::omt_travel_graph>( revision, costs ) );
+    return *travel_graphs.front().second;
+}
+
 std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
 {
@@ -970,18 +1045,9 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
-    const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
-        const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
-        if( cur_cost < 0 ) {
-            return pf::omt_score::rejected;
-        }
-        return pf::omt_score( cur_cost, is_ramp( pos ) );
-    };
-
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate,
-            g->display_om_pathfinding_progress );
-    return path.points;
+    return get_travel_graph( params ).find_path( src, dest, radius,
+            g->display_om_pathfinding_progress ).points;
 }
 
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
@@ -1330,6 +1396,30 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_player( int radiu
     return get_npcs_near( get_player_character().global_sm_location(), radius );
 }
 
+std::vector<point_abs_omt> overmapbuffer::search( const tripoint_abs_omt &center,
+        const int radius, const std::string &term )
+{
+    std::vector<overmap *> searched;
+    if( radius < 0 ) {
+        for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
+            searched.push_back( omp.second.get() );
+        }
+    } else {
+        searched = get_overmaps_near( project_to<coords::sm>( center.xy() ), radius * 2 + 1 );
+    }
+    std::vector<point_abs_omt> result;
+    for( overmap *om : searched ) {
+        std::vector<point_abs_omt> notes = om->find_notes( center.z(), term );
+        result.insert( result.end(), notes.begin(), notes.end() );
+        for( const point_abs_omt &p : om->find_seen_terrain( term, center.z() ) ) {
+            if( radius < 0 || square_dist( center.xy(), p ) <= radius ) {
+                result.push_back( p );
+            }
+        }
+    }
+    return result;
+}
+
 std::vector<overmap *> overmapbuffer::get_overmaps_near( const tripoint_abs_sm &location,
         const int radius )
 {
@@ -37,6 +37,11 @@ struct om_vehicle;
 struct radio_tower;
 struct regional_settings;
 
+namespace pf
+{
+class omt_travel_graph;
+} // namespace pf
+
 struct overmap_path_params {
     int road_cost = -1;
     int field_cost = -1;
@@ -52,6 +57,8 @@ struct overmap_path_params {
     bool avoid_danger = true;
     bool only_known_by_player = true;
 
+    bool operator==( const overmap_path_params &rhs ) const;
+
     static constexpr int standard_cost = 10;
     static overmap_path_params for_player();
     static overmap_path_params for_npc();
@@ -146,6 +153,7 @@ class overmapbuffer
 {
     public:
         overmapbuffer();
+        ~overmapbuffer();
 
         static cata_path terrain_filename( const point_abs_om & );
         static cata_path player_filename( const point_abs_om & );
@@ -413,6 +421,14 @@ class overmapbuffer
         t_extras_vector find_extras( int z, const std::string &pattern ) {
             return get_extras( z, &pattern ); // filter with pattern
         }
+        /**
+         * Get the seen terrain whose name matches @p term (see @ref match_include_exclude),
+         * and the notes matching it, on the z-level of @p center in the loaded overmaps.
+         * @param radius Only the terrain this many overmap terrains around @p center, and
+         * the notes of the overmaps it overlaps, are returned. Everything is if negative.
+         */
+        std::vector<point_abs_omt> search( const tripoint_abs_omt &center, int radius,
+                                           const std::string &term );
         /**
          * Signal nearby hordes to move to given location.
          * @param center The origin of the signal, hordes (that recognize the signal) want to go
@@ -542,6 +558,10 @@ class overmapbuffer
         overmap mutable *last_requested_overmap;
         // Set of globally unique overmap specials that have already been placed
         std::unordered_set<overmap_special_id> placed_unique_specials;
+        // Graphs for the travel paths of the last few kinds of travelers, see get_travel_path.
+        std::vector<std::pair<overmap_path_params, std::unique_ptr<pf::omt_travel_graph>>>
+        travel_graphs;
+        pf::omt_travel_graph &get_travel_graph( const overmap_path_params &params );
 
         /**
          * Get a list of notes in the (loaded) overmaps.
@@ -0,0 +1,174 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <unordered_set>
+#include <vector>
+
+#include "cata_utility.h"
+#include "json.h"
+
+namespace profiler
+{
+namespace
+{
+
+struct zone_record {
+    const char *name;
+    // nanoseconds
+    int64_t start;
+    int64_t duration;
+    int thread;
+    // number of enclosing zones on the same thread
+    int depth;
+};
+
+struct profiler_state {
+    std::atomic<bool> recording{ compiled_in() };
+    // Zones are recorded from several threads (like the tileset loading), and exported
+    // while that happens.
+    std::mutex ring_mutex;
+    // Only allocated when the profiler is compiled in, zones are never recorded otherwise.
+    std::vector<zone_record> ring = std::vector<zone_record>( compiled_in() ? ring_size : 0 );
+    // Total number of zones recorded, the next one goes to next % ring_size.
+    uint64_t next = 0;
+    std::mutex names_mutex;
+    // Node based, so the names stay where they are when more are added.
+    std::unordered_set<std::string> names;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+profiler_state &get_state()
+{
+    static profiler_state state;
+    return state;
+}
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - get_state().epoch ).count();
+}
+
+// Zones entered on this thread and not left yet.
+thread_local int zone_depth = 0;
+
+// Small numbers are easier to read in the trace viewer than hashes of std::thread::id.
+int current_thread()
+{
+    static std::atomic<int> next_thread{ 0 };
+    thread_local const int thread = next_thread++;
+    return thread;
+}
+
+const char *intern( const std::string &name )
+{
+    profiler_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.names_mutex );
+    return state.names.insert( name ).first->c_str();
+}
+
+} // namespace
+
+bool is_recording()
+{
+    return compiled_in() && get_state().recording.load( std::memory_order_relaxed );
+}
+
+void set_recording( const bool recording )
+{
+    get_state().recording = compiled_in() && recording;
+}
+
+void clear()
+{
+    profiler_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.ring_mutex );
+    state.next = 0;
+}
+
+size_t recorded_zones()
+{
+    profiler_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.ring_mutex );
+    return std::min<uint64_t>( state.next, ring_size );
+}
+
+bool export_chrome_trace( const std::string &path )
+{
+    profiler_state &state = get_state();
+    std::vector<zone_record> zones;
+    {
+        std::lock_guard<std::mutex> lock( state.ring_mutex );
+        if( state.next <= ring_size ) {
+            zones.assign( state.ring.begin(), state.ring.begin() + state.next );
+        } else {
+            zones = state.ring;
+        }
+    }
+    // Parents before their children, which end first and so were recorded first. Zones too
+    // short to be told apart by the clock are ordered by how deep they are nested.
+    std::sort( zones.begin(), zones.end(), []( const zone_record & a, const zone_record & b ) {
+        if( a.start != b.start ) {
+            return a.start < b.start;
+        }
+        if( a.duration != b.duration ) {
+            return a.duration > b.duration;
+        }
+        return a.depth < b.depth;
+    } );
+    return write_to_file( path, [&zones]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ms" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const zone_record &z : zones ) {
+            jsout.start_object();
+            jsout.member( "name", z.name );
+            jsout.member( "ph", "X" );
+            // The trace format is in microseconds, fractions keep the nanoseconds.
+            jsout.member( "ts", z.start / 1000.0 );
+            jsout.member( "dur", z.duration / 1000.0 );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", z.thread );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "profiler trace" );
+}
+
+zone::zone( const char *name ) : name( name ), start( -1 )
+{
+    if( is_recording() ) {
+        zone_depth++;
+        start = now_ns();
+    }
+}
+
+zone::zone( const std::string &name ) : name( nullptr ), start( -1 )
+{
+    if( is_recording() ) {
+        this->name = intern( name );
+        zone_depth++;
+        start = now_ns();
+    }
+}
+
+zone::~zone()
+{
+    if( start < 0 ) {
+        return;
+    }
+    const int64_t end = now_ns();
+    const int depth = --zone_depth;
+    profiler_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.ring_mutex );
+    state.ring[state.next++ % ring_size] = { name, start, end - start, current_thread(), depth };
+}
+
+} // namespace profiler
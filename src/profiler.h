@@ -0,0 +1,78 @@
+#pragma once
+#ifndef CATA_SRC_PROFILER_H
+#define CATA_SRC_PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Timing of nested zones of code, to find out which part of a slow turn (or a slow frame, or
+ * slow loading) took the time.
+ *
+ * A zone is a scope marked with @ref CATA_PROFILE_ZONE. Each time a zone is left, its start
+ * and duration are stored in a ring buffer holding the last @ref profiler::ring_size zones.
+ * Zones nest by time, so a zone entered within another one shows up as its child. The buffer
+ * can be exported from the debug menu as a Chrome trace, to be opened with chrome://tracing
+ * or https://ui.perfetto.dev.
+ *
+ * The profiler is only compiled in when CATA_PROFILER is defined (make PROFILER=1, or
+ * -DPROFILER=ON with CMake). Otherwise the zones expand to nothing and cost nothing.
+ */
+namespace profiler
+{
+
+constexpr size_t ring_size = 1 << 16;
+
+/** Whether the profiler was compiled in. */
+constexpr bool compiled_in()
+{
+#if defined(CATA_PROFILER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** Whether zones are being recorded, they are as soon as the profiler is compiled in. */
+bool is_recording();
+void set_recording( bool recording );
+/** Drops all recorded zones. */
+void clear();
+/** Number of zones in the ring buffer. */
+size_t recorded_zones();
+
+/** Writes the recorded zones as Chrome trace JSON, returns false on failure. */
+bool export_chrome_trace( const std::string &path );
+
+/** Records the time until it goes out of scope, use through @ref CATA_PROFILE_ZONE. */
+class zone
+{
+    public:
+        /** @p name has to outlive the zone, a string literal usually. */
+        explicit zone( const char *name );
+        /** For names built at run time, a copy of @p name is kept while recording. */
+        explicit zone( const std::string &name );
+        ~zone();
+        zone( const zone & ) = delete;
+        zone &operator=( const zone & ) = delete;
+
+    private:
+        const char *name;
+        // nanoseconds since the profiler started, negative if not recording
+        int64_t start;
+};
+
+} // namespace profiler
+
+#if defined(CATA_PROFILER)
+#define CATA_PROFILE_CONCAT_IMPL( a, b ) a##b
+#define CATA_PROFILE_CONCAT( a, b ) CATA_PROFILE_CONCAT_IMPL( a, b )
+/** Records the time from here to the end of the enclosing scope as a zone named @p name. */
+#define CATA_PROFILE_ZONE( name ) \
+    profiler::zone CATA_PROFILE_CONCAT( profile_zone_, __LINE__ )( name )
+#else
+#define CATA_PROFILE_ZONE( name ) static_cast<void>( 0 )
+#endif
+
+#endif // CATA_SRC_PROFILER_H
@@ -69,6 +69,7 @@
 #include "field.h"
 #include "field_type.h"
 #include "flag.h"
+#include "flag_bitset.h"
 #include "flat_set.h"
 #include "game.h"
 #include "game_constants.h"
@@ -3047,6 +3048,7 @@ void item::io( Archive &archive )
     erase_if( item_tags, [&]( const flag_id & f ) {
         return !f.is_valid();
     } );
+    item_tag_bits = dense_flag_bits( item_tags );
 
     if( note_read ) {
         snip_id = SNIPPET.migrate_hash_to_id( note );
@@ -4041,7 +4043,8 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout,
+                           const std::unordered_map<uint32_t, int> &region_ids ) const
 {
     jsout.start_array();
 
@@ -4052,7 +4055,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
 
     const auto write_seq = [&]() {
         jsout.start_array();
-        jsout.write( last.tile.tile );
+        jsout.write( region_ids.at( last.tile.tile_id ) );
         jsout.write( last.tile.subtile );
         jsout.write( last.tile.rotation );
         jsout.write( last.symbol );
@@ -4085,6 +4088,11 @@ void mm_submap::serialize( JsonOut &jsout ) const
 }
 
 void mm_submap::deserialize( const JsonValue &ja )
+{
+    deserialize( ja, {} );
+}
+
+void mm_submap::deserialize( const JsonValue &ja, const std::vector<uint32_t> &interned_ids )
 {
     // Uses RLE for compression.
 
@@ -4099,7 +4107,15 @@ void mm_submap::deserialize( const JsonValue &ja )
                 remaining -= 1;
             } else {
                 JsonArray elem_json = sm_json.next_array();
-                elem.tile.tile = elem_json.next_string();
+                if( elem_json.test_string() ) {
+                    elem.tile.tile_id = memorized_terrain_tile::intern( elem_json.next_string() );
+                } else {
+                    const int index = elem_json.next_int();
+                    if( index < 0 || static_cast<size_t>( index ) >= interned_ids.size() ) {
+                        elem_json.throw_error( "Tile index out of the range of tile names" );
+                    }
+                    elem.tile.tile_id = interned_ids[index];
+                }
                 elem.tile.subtile = elem_json.next_int();
                 elem.tile.rotation = elem_json.next_int();
                 elem.symbol = elem_json.next_int();
@@ -4124,6 +4140,32 @@ void mm_submap::deserialize( const JsonValue &ja )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Names of the tiles used in this region, in the order they are first used.
+    std::unordered_map<uint32_t, int> region_ids;
+    std::vector<uint32_t> names;
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            const mm_submap &sm = *submaps[x][y];
+            for( int sy = 0; sy < SEEY; sy++ ) {
+                for( int sx = 0; sx < SEEX; sx++ ) {
+                    const uint32_t id = sm.tile( point( sx, sy ) ).tile_id;
+                    if( region_ids.emplace( id, static_cast<int>( names.size() ) ).second ) {
+                        names.push_back( id );
+                    }
+                }
+            }
+        }
+    }
+
+    jsout.start_object();
+    jsout.member( "tiles" );
+    jsout.start_array();
+    for( const uint32_t id : names ) {
+        jsout.write( memorized_terrain_tile::name_of( id ) );
+    }
+    jsout.end_array();
+    jsout.member( "submaps" );
     jsout.start_array();
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         // NOLINTNEXTLINE(modernize-loop-convert)
@@ -4132,16 +4174,28 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, region_ids );
             }
         }
     }
     jsout.end_array();
+    jsout.end_object();
 }
 
 void mm_region::deserialize( const JsonValue &ja )
 {
-    JsonArray region_json = ja;
+    // Regions saved before the names were listed once per region are just the submaps.
+    std::vector<uint32_t> interned_ids;
+    JsonArray region_json;
+    if( ja.test_object() ) {
+        JsonObject jo = ja;
+        for( const std::string &name : jo.get_string_array( "tiles" ) ) {
+            interned_ids.push_back( memorized_terrain_tile::intern( name ) );
+        }
+        region_json = jo.get_array( "submaps" );
+    } else {
+        region_json = ja;
+    }
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         // NOLINTNEXTLINE(modernize-loop-convert)
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
@@ -4149,7 +4203,7 @@ void mm_region::deserialize( const JsonValue &ja )
             sm = make_shared_fast<mm_submap>();
             JsonValue jsin = region_json.next_value();
             if( !jsin.test_null() ) {
-                sm->deserialize( jsin );
+                sm->deserialize( jsin, interned_ids );
             }
         }
     }
@@ -4170,7 +4224,7 @@ void map_memory::load_legacy( const JsonValue &jv )
         p.y = elem_json.next_int();
         p.z = elem_json.next_int();
         mig_elem &elem = elems[p];
-        elem.tile.tile = elem_json.next_string();
+        elem.tile.tile_id = memorized_terrain_tile::intern( elem_json.next_string() );
         elem.tile.subtile = elem_json.next_int();
         elem.tile.rotation = elem_json.next_int();
         if( elem_json.has_more() ) {
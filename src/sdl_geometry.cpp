@@ -1,5 +1,10 @@
 #if defined(TILES)
 #include "sdl_geometry.h"
+
+#include <array>
+#include <cmath>
+#include <utility>
+
 #include "debug.h"
 
 void GeometryRenderer::horizontal_line( const SDL_Renderer_Ptr &renderer, const point &pos, int x2,
@@ -73,4 +78,85 @@ void ColorModulatedGeometryRenderer::rect( const SDL_Renderer_Ptr &renderer, con
     }
 }
 
+void SpriteBatch::add( const SDL_Renderer_Ptr &renderer, SDL_Texture *tex, const SDL_Rect &src,
+                       const SDL_Rect &dest, const double angle, const SDL_RendererFlip flip )
+{
+    if( tex != texture ) {
+        flush( renderer );
+        texture = tex;
+    }
+    quads.push_back( { src, dest, angle, flip } );
+}
+
+void SpriteBatch::flush( const SDL_Renderer_Ptr &renderer )
+{
+    if( quads.empty() ) {
+        return;
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if( !geometry_failed ) {
+        static constexpr std::array<int, 6> quad_corners = {{ 0, 1, 2, 0, 2, 3 }};
+        int tex_width = 0;
+        int tex_height = 0;
+        SDL_QueryTexture( texture, nullptr, nullptr, &tex_width, &tex_height );
+        vertices.clear();
+        indices.clear();
+        for( const quad &q : quads ) {
+            float u0 = static_cast<float>( q.src.x ) / tex_width;
+            float v0 = static_cast<float>( q.src.y ) / tex_height;
+            float u1 = static_cast<float>( q.src.x + q.src.w ) / tex_width;
+            float v1 = static_cast<float>( q.src.y + q.src.h ) / tex_height;
+            if( q.flip & SDL_FLIP_HORIZONTAL ) {
+                std::swap( u0, u1 );
+            }
+            if( q.flip & SDL_FLIP_VERTICAL ) {
+                std::swap( v0, v1 );
+            }
+            // Corners relative to the center of dest, clockwise from the top left one
+            const float half_w = q.dest.w / 2.0f;
+            const float half_h = q.dest.h / 2.0f;
+            const std::array<SDL_FPoint, 4> corners = {{
+                    { -half_w, -half_h }, { half_w, -half_h },
+                    { half_w, half_h }, { -half_w, half_h }
+                }
+            };
+            const std::array<SDL_FPoint, 4> tex_coords = {{
+                    { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 }
+                }
+            };
+            const float radians = static_cast<float>( q.angle * M_PI / 180.0 );
+            const float cos_a = std::cos( radians );
+            const float sin_a = std::sin( radians );
+            const SDL_FPoint center = { q.dest.x + half_w, q.dest.y + half_h };
+            const int first = static_cast<int>( vertices.size() );
+            for( size_t i = 0; i < corners.size(); i++ ) {
+                const SDL_FPoint &c = corners[i];
+                const SDL_FPoint pos = { center.x + c.x * cos_a - c.y * sin_a,
+                                         center.y + c.x * sin_a + c.y * cos_a
+                                       };
+                vertices.push_back( { pos, SDL_Color{ 255, 255, 255, 255 }, tex_coords[i] } );
+            }
+            // Two triangles for each quad
+            for( const int corner : quad_corners ) {
+                indices.push_back( first + corner );
+            }
+        }
+        if( SDL_RenderGeometry( renderer.get(), texture, vertices.data(),
+                                static_cast<int>( vertices.size() ), indices.data(),
+                                static_cast<int>( indices.size() ) ) == 0 ) {
+            quads.clear();
+            return;
+        }
+        // Not supported by this renderer, draw the quads one by one from now on.
+        printErrorIf( true, "SDL_RenderGeometry failed" );
+        geometry_failed = true;
+    }
+#endif
+    for( const quad &q : quads ) {
+        printErrorIf( SDL_RenderCopyEx( renderer.get(), texture, &q.src, &q.dest, q.angle, nullptr,
+                                        q.flip ) != 0, "SDL_RenderCopyEx failed" );
+    }
+    quads.clear();
+}
+
 #endif // TILES
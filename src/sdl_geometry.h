@@ -4,6 +4,7 @@
 
 #if defined(TILES)
 #include <memory>
+#include <vector>
 
 #include "sdl_wrappers.h"
 #include "point.h"
@@ -53,6 +54,38 @@ class ColorModulatedGeometryRenderer: public DefaultGeometryRenderer
         SDL_Texture_Ptr tex;
 };
 
+/// Collects textured quads and draws those of the same texture with a single
+/// SDL_RenderGeometry call, instead of one SDL_RenderCopyEx call each. The quads are drawn
+/// in the order they were added, adding a quad of another texture draws the collected ones.
+/// With SDL older than 2.0.18, or a renderer that can't draw geometry, the quads are drawn
+/// with SDL_RenderCopyEx.
+class SpriteBatch
+{
+    public:
+        /// Draws @p src of @p tex to @p dest like SDL_RenderCopyEx does (rotated around the
+        /// center of @p dest), once the batch is flushed.
+        void add( const SDL_Renderer_Ptr &renderer, SDL_Texture *tex, const SDL_Rect &src,
+                  const SDL_Rect &dest, double angle, SDL_RendererFlip flip );
+        /// Draws the collected quads. Must be called before anything else is drawn, and before
+        /// the render target or the clipping changes.
+        void flush( const SDL_Renderer_Ptr &renderer );
+
+    private:
+        struct quad {
+            SDL_Rect src;
+            SDL_Rect dest;
+            double angle;
+            SDL_RendererFlip flip;
+        };
+        SDL_Texture *texture = nullptr;
+        std::vector<quad> quads;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        bool geometry_failed = false;
+#endif
+};
+
 #endif // TILES
 
 #endif // CATA_SRC_SDL_GEOMETRY_H
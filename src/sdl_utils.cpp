@@ -3,6 +3,7 @@
 #include "sdl_utils.h"
 
 #include <array>
+#include <unordered_set>
 #include <utility>
 
 #include "color.h"
@@ -33,6 +34,57 @@ color_pixel_function_pointer get_color_pixel_function( const std::string &name )
     return iter->second;
 }
 
+// The result of these only depends on the average of the color, whether it is black and its alpha.
+static const std::unordered_set<color_pixel_function_pointer> average_color_pixel_functions = {
+    color_pixel_sepia_light,
+    color_pixel_sepia_dark,
+    color_pixel_blue_dark,
+    color_pixel_custom,
+    color_pixel_grayscale,
+    color_pixel_nightvision,
+    color_pixel_overexposed,
+};
+
+color_pixel_filter::color_pixel_filter( const color_pixel_function_pointer function ) :
+    function( function )
+{
+    if( !average_color_pixel_functions.count( function ) ) {
+        return;
+    }
+    use_table = true;
+    // Every average is reached by some sum of the channels.
+    for( int sum = 1; sum <= 3 * 0xFF; ++sum ) {
+        const SDL_Color color = {
+            static_cast<Uint8>( std::clamp( sum, 0, 0xFF ) ),
+            static_cast<Uint8>( std::clamp( sum - 0xFF, 0, 0xFF ) ),
+            static_cast<Uint8>( std::clamp( sum - 2 * 0xFF, 0, 0xFF ) ),
+            0xFF
+        };
+        by_average[average_pixel_color( color )] = function( color );
+    }
+    black = function( SDL_Color{ 0x00, 0x00, 0x00, 0xFF } );
+}
+
+void color_pixel_filter::apply( SDL_Color *pixels, const size_t count ) const
+{
+    SDL_Color *const end = pixels + count;
+    for( SDL_Color *pix = pixels; pix != end; ++pix ) {
+        if( pix->a == 0x00 ) {
+            // This check significantly improves the performance since
+            // vast majority of pixels in the tilesets are completely transparent.
+            continue;
+        }
+        if( !use_table ) {
+            *pix = function( *pix );
+            continue;
+        }
+        const SDL_Color &filtered = is_black( *pix ) ? black : by_average[average_pixel_color( *pix )];
+        pix->r = filtered.r;
+        pix->g = filtered.g;
+        pix->b = filtered.b;
+    }
+}
+
 SDL_Color adjust_color_brightness( const SDL_Color &color, int percent )
 {
     if( percent <= 0 ) {
@@ -3,7 +3,9 @@
 #define CATA_SRC_SDL_UTILS_H
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -17,6 +19,25 @@ using color_pixel_function_map = std::unordered_map<std::string, color_pixel_fun
 
 color_pixel_function_pointer get_color_pixel_function( const std::string &name );
 
+/**
+ * Applies a color pixel function to many pixels, leaving fully transparent pixels alone.
+ * Functions that only depend on the average of a color are looked up in a table filled
+ * once, calling them for each pixel is much slower (gamma in the memory filters).
+ */
+class color_pixel_filter
+{
+    public:
+        explicit color_pixel_filter( color_pixel_function_pointer function );
+        /** Only touches the given pixels, so it can run on several threads at once. */
+        void apply( SDL_Color *pixels, size_t count ) const;
+
+    private:
+        color_pixel_function_pointer function;
+        bool use_table = false;
+        std::array<SDL_Color, 256> by_average = {};
+        SDL_Color black = {};
+};
+
 SDL_Color adjust_color_brightness( const SDL_Color &color, int percent );
 SDL_Color mix_colors( const SDL_Color &first, const SDL_Color &second,
                       int second_percent );
@@ -1,4 +1,5 @@
 #include "cursesdef.h" // IWYU pragma: associated
+#include "profiler.h"
 #include "sdltiles.h" // IWYU pragma: associated
 
 #include "cuboid_rectangle.h"
@@ -525,6 +526,7 @@ SDL_Rect get_android_render_rect( float DisplayBufferWidth, float DisplayBufferH
 
 void refresh_display()
 {
+    CATA_PROFILE_ZONE( "refresh_display" );
     needupdate = false;
     lastupdate = SDL_GetTicks();
 
@@ -584,6 +586,8 @@ static void invalidate_framebuffer( std::vector<curseline> &framebuffer )
     for( curseline &i : framebuffer ) {
         std::fill_n( i.chars.begin(), i.chars.size(), cursecell( "" ) );
     }
+    // The next window can't rely on the screen showing what it drew before
+    winBuffer.reset();
 }
 
 void reinitialize_framebuffer( const bool force_invalidate )
@@ -596,6 +600,7 @@ void reinitialize_framebuffer( const bool force_invalidate )
     if( new_height != prev_height || new_width != prev_width ) {
         prev_height = new_height;
         prev_width = new_width;
+        winBuffer.reset();
         oversized_framebuffer.resize( new_height );
         for( int i = 0; i < new_height; i++ ) {
             oversized_framebuffer[i].chars.assign( new_width, cursecell( "" ) );
@@ -1283,10 +1288,17 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
 
     // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
     static const std::string space_string = " ";
+    const bool draw_ascii_lines = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+    // Only the changed cells need drawing, but that relies on the screen still showing this
+    // window as it was drawn last time. After any other window was drawn, even a compatible
+    // one, or the zoom changed, the whole of every touched line is drawn again.
+    const bool screen_intact = win == winBuffer && fontScale == fontScaleBuffer;
+    const bool framebuffer_valid = oldWinCompatible && fontScale == fontScaleBuffer;
 
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
-        if( !win->line[j].touched ) {
+        curseline &line = win->line[j];
+        if( !line.touched() ) {
             continue;
         }
 
@@ -1297,15 +1309,23 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
         }
 
         update = true;
-        win->line[j].touched = false;
-        for( int i = 0; i < win->width; i++ ) {
+        int begin = 0;
+        int end = win->width;
+        if( screen_intact ) {
+            // A wide character starting left of the range is drawn again whole
+            begin = line.dirty_begin > 0 && line.chars[line.dirty_begin].ch.empty() ?
+                    line.dirty_begin - 1 : line.dirty_begin;
+            end = std::min( line.dirty_end, win->width );
+        }
+        line.untouch();
+        for( int i = begin; i < end; i++ ) {
             const int fbx = win->pos.x + i;
             if( fbx >= static_cast<int>( framebuffer[fby].chars.size() ) ) {
                 // prevent indexing outside the frame buffer. This might happen for some parts of the window.
                 break;
             }
 
-            const cursecell &cell = win->line[j].chars[i];
+            const cursecell &cell = line.chars[i];
 
             const point draw( offset + point( i * font->width, j * font->height ) );
             if( draw.x + font->width > WindowWidth || draw.y + font->height > WindowHeight ) {
@@ -1317,7 +1337,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             // TODO: handle caching when drawing normal windows over graphical tiles
             cursecell &oldcell = framebuffer[fby].chars[fbx];
 
-            if( oldWinCompatible && cell == oldcell && fontScale == fontScaleBuffer ) {
+            if( framebuffer_valid && cell == oldcell ) {
                 continue;
             }
             oldcell = cell;
@@ -1340,7 +1360,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                 // utf8_width() may return a negative width
                 continue;
             }
-            bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+            bool use_draw_ascii_lines_routine = draw_ascii_lines;
             unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
@@ -1496,6 +1516,8 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
 
         invalidate_framebuffer( terminal_framebuffer, win->pos,
                                 TERRAIN_WINDOW_TERM_WIDTH, TERRAIN_WINDOW_TERM_HEIGHT );
+        // The tiles may have covered the last window drawn as text
+        ::winBuffer.reset();
 
         update = true;
     } else if( g && w == g->w_terrain && map_font ) {
@@ -1527,6 +1549,7 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
     } else if( g && w == g->w_overmap && use_tiles && use_tiles_overmap ) {
         overmap_tilecontext->draw_om( win->pos, overmap_ui::redraw_info.center,
                                       overmap_ui::redraw_info.blink );
+        ::winBuffer.reset();
         update = true;
     } else if( g && w == g->w_overmap && overmap_font ) {
         // Special font for the terrain window
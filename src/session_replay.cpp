@@ -0,0 +1,317 @@
+#include "session_replay.h"
+
+#include <array>
+#include <istream>
+#include <limits>
+#include <set>
+#include <system_error>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "input.h"
+#include "json.h"
+#include "json_loader.h"
+#include "main_menu.h"
+#include "path_info.h"
+#include "rng.h"
+#include "worldfactory.h"
+
+namespace session_replay
+{
+namespace
+{
+
+enum class session_mode : int {
+    none,
+    recording,
+    replaying
+};
+
+constexpr size_t num_stages = static_cast<size_t>( turn_stage::num_stages );
+
+const std::array<const char *, num_stages> stage_names = {{
+        "vehmove", "process_fields", "process_items", "build_map_cache", "monmove"
+    }
+};
+
+struct session_state {
+    session_mode mode = session_mode::none;
+    // Input is only recorded or replayed between begin_session and end_session.
+    bool in_session = false;
+    std::string path;
+    cata::ofstream out;
+
+    std::string world;
+    // Where the save of a replay was copied to, deleted once the replay is finished.
+    std::string replay_world_path;
+    std::string save_id;
+    int seed = 0;
+    std::vector<input_event> events;
+    size_t next_event = 0;
+
+    std::chrono::steady_clock::time_point turn_start;
+    std::array<std::chrono::microseconds, num_stages> stage_times;
+    std::chrono::microseconds total_time = std::chrono::microseconds::zero();
+    int turns = 0;
+};
+
+session_state &get_state()
+{
+    static session_state state;
+    return state;
+}
+
+// The copy of the save a recording starts from.
+std::string save_copy_path( const std::string &path )
+{
+    return path + ".save";
+}
+
+std::string timings_path( const std::string &path )
+{
+    return path + ".timings.csv";
+}
+
+bool copy_directory( const std::string &from, const std::string &to )
+{
+    std::error_code ec;
+    fs::remove_all( fs::u8path( to ), ec );
+    fs::copy( fs::u8path( from ), fs::u8path( to ), fs::copy_options::recursive, ec );
+    if( ec ) {
+        debugmsg( "Failed to copy %s to %s: %s", from, to, ec.message() );
+        return false;
+    }
+    return true;
+}
+
+void reset_turn_timings()
+{
+    session_state &state = get_state();
+    state.stage_times.fill( std::chrono::microseconds::zero() );
+    state.turn_start = std::chrono::steady_clock::now();
+}
+
+void finish_replay()
+{
+    session_state &state = get_state();
+    DebugLog( D_INFO, DC_ALL ) << "[replay] replayed " << state.next_event << " input events and "
+                               << state.turns << " turns in "
+                               << state.total_time.count() / 1000 << " ms";
+    // Like quitting without saving, the replayed world is not worth keeping.
+    std::error_code ec;
+    fs::remove_all( fs::u8path( state.replay_world_path ), ec );
+    if( ec ) {
+        debugmsg( "Failed to delete the replayed world %s: %s", state.replay_world_path,
+                  ec.message() );
+    }
+}
+
+} // namespace
+
+void serialize( const input_event &evt, JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "type", static_cast<int>( evt.type ) );
+    jsout.member( "sequence", evt.sequence );
+    jsout.member( "modifiers" );
+    jsout.start_array();
+    for( const keymod_t mod : evt.modifiers ) {
+        jsout.write( static_cast<int>( mod ) );
+    }
+    jsout.end_array();
+    jsout.member( "mouse_pos", evt.mouse_pos );
+    jsout.member( "text", evt.text );
+    jsout.member( "edit", evt.edit );
+    jsout.member( "edit_refresh", evt.edit_refresh );
+    jsout.end_object();
+}
+
+input_event deserialize_input_event( const JsonObject &jo )
+{
+    input_event evt;
+    evt.type = static_cast<input_event_t>( jo.get_int( "type" ) );
+    evt.sequence = jo.get_int_array( "sequence" );
+    for( const int mod : jo.get_int_array( "modifiers" ) ) {
+        evt.modifiers.insert( static_cast<keymod_t>( mod ) );
+    }
+    jo.read( "mouse_pos", evt.mouse_pos );
+    evt.text = jo.get_string( "text" );
+    evt.edit = jo.get_string( "edit" );
+    evt.edit_refresh = jo.get_bool( "edit_refresh" );
+    return evt;
+}
+
+void record_to( const std::string &path )
+{
+    session_state &state = get_state();
+    state.mode = session_mode::recording;
+    state.path = path;
+}
+
+bool replay_from( const std::string &path )
+{
+    session_state &state = get_state();
+    state.events.clear();
+    bool header_read = false;
+    const bool file_read = read_from_file( path, [&]( std::istream & fin ) {
+        std::string line;
+        while( std::getline( fin, line ) ) {
+            if( line.empty() ) {
+                continue;
+            }
+            const JsonObject jo = json_loader::from_string( line ).get_object();
+            if( !header_read ) {
+                state.world = jo.get_string( "world" );
+                state.save_id = jo.get_string( "save" );
+                state.seed = jo.get_int( "seed" );
+                header_read = true;
+            } else {
+                state.events.push_back( deserialize_input_event( jo ) );
+            }
+        }
+    } );
+    if( !file_read || !header_read ) {
+        debugmsg( "Could not read the recorded session %s", path );
+        return false;
+    }
+
+    // Replay in a world of its own, so the recorded world stays as it was.
+    const std::string replay_world = state.world + " replay";
+    state.replay_world_path = PATH_INFO::savedir() + replay_world;
+    if( !copy_directory( save_copy_path( path ), state.replay_world_path ) ) {
+        return false;
+    }
+    state.mode = session_mode::replaying;
+    state.path = path;
+    state.next_event = 0;
+    main_menu::queued_world_to_load = replay_world;
+    main_menu::queued_save_id_to_load = state.save_id;
+    return true;
+}
+
+void begin_session()
+{
+    session_state &state = get_state();
+    if( state.mode == session_mode::recording ) {
+        // The save on disk has to match the state the recorded input starts from.
+        if( !g->save() || !copy_directory( PATH_INFO::world_base_save_path(),
+                                           save_copy_path( state.path ) ) ) {
+            debugmsg( "Could not copy the save, the session is not recorded." );
+            state.mode = session_mode::none;
+            return;
+        }
+        state.seed = rng( 0, std::numeric_limits<int>::max() );
+        state.out.open( fs::u8path( state.path ), std::ios::binary );
+        JsonOut jsout( state.out );
+        jsout.start_object();
+        jsout.member( "world", world_generator->active_world->world_name );
+        jsout.member( "save", get_avatar().get_save_id() );
+        jsout.member( "seed", state.seed );
+        jsout.end_object();
+        state.out << '\n';
+    } else if( state.mode == session_mode::replaying ) {
+        if( get_avatar().get_save_id() != state.save_id ) {
+            debugmsg( "Loaded %s instead of the recorded %s, not replaying.",
+                      get_avatar().get_save_id(), state.save_id );
+            state.mode = session_mode::none;
+            return;
+        }
+        state.out.open( fs::u8path( timings_path( state.path ) ), std::ios::binary );
+        state.out << "turn,total_us";
+        for( const char *name : stage_names ) {
+            state.out << ',' << name << "_us";
+        }
+        state.out << '\n';
+        reset_turn_timings();
+    } else {
+        return;
+    }
+    rng_set_engine_seed( state.seed );
+    state.in_session = true;
+}
+
+void end_session()
+{
+    session_state &state = get_state();
+    if( !state.in_session ) {
+        return;
+    }
+    state.out.close();
+    if( state.mode == session_mode::replaying ) {
+        finish_replay();
+    }
+    state.in_session = false;
+    state.mode = session_mode::none;
+}
+
+void end_turn()
+{
+    if( !is_replaying() ) {
+        return;
+    }
+    session_state &state = get_state();
+    const std::chrono::microseconds total = std::chrono::duration_cast<std::chrono::microseconds>
+                                            ( std::chrono::steady_clock::now() - state.turn_start );
+    state.out << to_turn<int>( calendar::turn ) << ',' << total.count();
+    for( const std::chrono::microseconds &time : state.stage_times ) {
+        state.out << ',' << time.count();
+    }
+    state.out << '\n';
+    state.total_time += total;
+    state.turns++;
+    reset_turn_timings();
+}
+
+bool is_recording()
+{
+    const session_state &state = get_state();
+    return state.in_session && state.mode == session_mode::recording;
+}
+
+bool is_replaying()
+{
+    const session_state &state = get_state();
+    return state.in_session && state.mode == session_mode::replaying;
+}
+
+input_event get_input_event( const keyboard_mode preferred_keyboard_mode )
+{
+    session_state &state = get_state();
+    if( is_replaying() ) {
+        if( state.next_event < state.events.size() ) {
+            return state.events[state.next_event++];
+        }
+        throw replay_finished();
+    }
+    input_event evt = inp_mngr.get_input_event( preferred_keyboard_mode );
+    if( is_recording() ) {
+        JsonOut jsout( state.out );
+        serialize( evt, jsout );
+        state.out << '\n';
+        state.out.flush();
+    }
+    return evt;
+}
+
+stage_timer::stage_timer( const turn_stage stage ) : stage( stage ), active( is_replaying() )
+{
+    if( active ) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+stage_timer::~stage_timer()
+{
+    if( active ) {
+        get_state().stage_times[static_cast<size_t>( stage )] +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start );
+    }
+}
+
+} // namespace session_replay
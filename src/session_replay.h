@@ -0,0 +1,101 @@
+#pragma once
+#ifndef CATA_SRC_SESSION_REPLAY_H
+#define CATA_SRC_SESSION_REPLAY_H
+
+#include <chrono>
+#include <string>
+
+class JsonObject;
+class JsonOut;
+enum class keyboard_mode;
+struct input_event;
+
+/**
+ * Recording and replaying of game sessions, to measure the speed of the game on real
+ * sessions in a reproducible way.
+ *
+ * A recording (started with the --record command line option) consists of:
+ * - a copy of the save the session started from, in a directory next to the recording,
+ * - the seed the random number generator was set to when the session started,
+ * - all input events handled by input_context during the session.
+ *
+ * A replay (started with --replay) copies the save into a new world, loads it, sets the
+ * same seed and feeds the recorded input back without waiting for anything. The time spent in
+ * each turn and in the expensive stages of a turn (see @ref turn_stage) is written to a CSV
+ * file next to the recording. Once all recorded input has been used, the game loop unwinds
+ * (see @ref replay_finished), the replayed world is deleted and the game exits.
+ *
+ * Sessions only replay identically with the same game data, mods, options and keybindings.
+ * Anything that depends on the wall clock (like autosaves) may make them diverge.
+ */
+namespace session_replay
+{
+
+/**
+ * Records the next session into the given file. The game is saved when the session starts,
+ * so the save on disk matches the state the recorded input starts from.
+ */
+void record_to( const std::string &path );
+/**
+ * Prepares replaying the session recorded in the given file, the world of the recording is
+ * queued to be loaded from the main menu. Returns false if the recording can't be read.
+ */
+bool replay_from( const std::string &path );
+
+/** Called once a game has been started or loaded, starts recording or replaying. */
+void begin_session();
+/**
+ * Called when the game is over or the replay has finished, stops recording or writes the
+ * last timings and deletes the world the session was replayed in.
+ */
+void end_session();
+/** Called after each turn, writes the timings of the turn when replaying. */
+void end_turn();
+
+bool is_recording();
+bool is_replaying();
+
+/**
+ * Thrown by @ref get_input_event once a replay has used all recorded input, caught by the
+ * game loop in main. Not derived from std::exception, so handlers for errors don't stop it.
+ */
+struct replay_finished {};
+
+/**
+ * The next input event, replayed from the recording or read from the input manager and
+ * recorded. Throws @ref replay_finished when a replay runs out of recorded input.
+ */
+input_event get_input_event( keyboard_mode preferred_keyboard_mode );
+
+/** How input events are stored in a recording, one object per event. */
+void serialize( const input_event &evt, JsonOut &jsout );
+input_event deserialize_input_event( const JsonObject &jo );
+
+/** Expensive parts of a turn whose time is written by a replay. */
+enum class turn_stage : int {
+    vehmove,
+    process_fields,
+    process_items,
+    build_map_cache,
+    monmove,
+    num_stages
+};
+
+/** Adds the time until it goes out of scope to a stage of the current turn, when replaying. */
+class stage_timer
+{
+    public:
+        explicit stage_timer( turn_stage stage );
+        ~stage_timer();
+        stage_timer( const stage_timer & ) = delete;
+        stage_timer &operator=( const stage_timer & ) = delete;
+
+    private:
+        turn_stage stage;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+};
+
+} // namespace session_replay
+
+#endif // CATA_SRC_SESSION_REPLAY_H
@@ -115,6 +115,9 @@ inline float accumulate_transparency( const float &cumulative_transparency,
     return ( ( distance - 1 ) * cumulative_transparency + current_transparency ) / distance;
 }
 
+// How far castLight looks by default, including the offsetDistance.
+constexpr int SHADOWCASTING_MAX_DISTANCE = 60;
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
@@ -122,7 +125,7 @@ template<typename T, typename Out, T( *calc )( const T &, const T &, const int &
 void castLightAll( cata::mdarray<Out, point_bub_ms> &output_cache,
                    const cata::mdarray<T, point_bub_ms> &input_array,
                    const point &offset, int offsetDistance = 0,
-                   T numerator = 1.0 );
+                   T numerator = 1.0, int max_distance = SHADOWCASTING_MAX_DISTANCE );
 
 template<typename T>
 using array_of_grids_of =
@@ -1,9 +1,15 @@
 #include "simple_pathfinding.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <queue>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "coordinates.h"
@@ -363,4 +369,555 @@ simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
     return ret;
 }
 
+namespace
+{
+
+constexpr int sector_size = omt_travel_graph::sector_size;
+constexpr int sector_area = omt_travel_graph::sector_area;
+using sector_costs = omt_travel_graph::sector_costs;
+
+// The sides of a sector, east, south, west and north, in the order of the bits of the exits
+// of its entrances. The entrances of a run of OMTs along a side are at most this far apart.
+const std::array<point, 4> sector_sides = {{ point_east, point_south, point_west, point_north }};
+const std::array<direction, 4> side_directions = {{
+        direction::EAST, direction::SOUTH, direction::WEST, direction::NORTH
+    }
+};
+constexpr int max_entrance_spacing = 7;
+// An OMT is left through one of the sides, up or down.
+constexpr int exit_up = 4;
+constexpr int exit_down = 5;
+constexpr int exit_kinds = 6;
+// An OMT is entered from one of the sides, or from another z-level. The source counts as
+// entered from another z-level, going through it costs nothing anyway.
+constexpr int entered_vertically = 4;
+constexpr int entry_kinds = 5;
+// Bit of the exits of an entrance that is reached from the z-level above or below.
+constexpr uint8_t reached_vertically = 1 << 6;
+
+int opposite_side( const int side )
+{
+    return ( side + 2 ) % 4;
+}
+
+// Cost of going through an OMT entered and left as given, cheaper for turns as in
+// find_overmap_path. Negative for going back the way one came.
+int through_cost( const int cost, const int entered, const int exit )
+{
+    if( exit < 4 && exit == entered ) {
+        return -1;
+    }
+    const direction dir_in = exit < 4 ? side_directions[opposite_side( exit )] : direction::CENTER;
+    const direction dir_out = entered < 4 ? side_directions[entered] : direction::CENTER;
+    return adjust_omt_cost( cost, dir_in, dir_out );
+}
+
+tripoint_abs_omt sector_origin( const tripoint_abs_omt &p )
+{
+    return tripoint_abs_omt( divide_round_to_minus_infinity( p.x(), sector_size ) * sector_size,
+                             divide_round_to_minus_infinity( p.y(), sector_size ) * sector_size,
+                             p.z() );
+}
+
+int sector_index( const tripoint_abs_omt &origin, const tripoint_abs_omt &p )
+{
+    const tripoint_rel_omt local = p - origin;
+    return local.y() * sector_size + local.x();
+}
+
+tripoint_abs_omt sector_omt( const tripoint_abs_omt &origin, const int index )
+{
+    return origin + point( index % sector_size, index / sector_size );
+}
+
+// The i-th OMT along the given side of a sector.
+int side_index( const size_t side, const int i )
+{
+    switch( side ) {
+        case 0:
+            return i * sector_size + sector_size - 1;
+        case 1:
+            return ( sector_size - 1 ) * sector_size + i;
+        case 2:
+            return i * sector_size;
+        default:
+            return i;
+    }
+}
+
+// The OMTs next to an OMT of a sector, east, south, west and north, negative for those outside
+// of the sector.
+std::array<int, 4> sector_neighbors( const int index )
+{
+    const int x = index % sector_size;
+    const int y = index / sector_size;
+    return {{
+            x + 1 < sector_size ? index + 1 : -1,
+            y + 1 < sector_size ? index + sector_size : -1,
+            x > 0 ? index - 1 : -1,
+            y > 0 ? index - sector_size : -1
+        }
+    };
+}
+
+// Cheapest paths from an OMT of a sector to the others, without leaving the sector. Turning is
+// cheaper than going straight, so the OMTs are reached by the side they are entered from: the
+// states are index * entry_kinds + how the OMT was entered.
+struct sector_search {
+    // negative if the state can't be reached
+    std::array<int, sector_area * entry_kinds> cost;
+    std::array<int16_t, sector_area * entry_kinds> prev;
+    int start = -1;
+    // Whether the start can be left for free
+    bool free_start = false;
+    // States to visit by cost modulo the number of buckets, kept between searches to not
+    // allocate them each time
+    std::vector<std::vector<int16_t>> buckets;
+
+    // Cost of going through the OMT of the reached state and leaving through exit, negative
+    // if it can't be done.
+    int leave_cost( const sector_costs &costs, const int state, const int exit ) const {
+        if( cost[state] < 0 ) {
+            return -1;
+        }
+        if( free_start && state == start ) {
+            return 0;
+        }
+        return through_cost( costs.cost[state / entry_kinds], state % entry_kinds, exit );
+    }
+
+    // The cheapest state to reach the OMT at index in, negative if it can't be reached.
+    int cheapest_arrival( const int index ) const {
+        int best = -1;
+        for( int state = index * entry_kinds; state < ( index + 1 ) * entry_kinds; state++ ) {
+            if( cost[state] >= 0 && ( best < 0 || cost[state] < cost[best] ) ) {
+                best = state;
+            }
+        }
+        return best;
+    }
+
+    // The cheapest state to leave the OMT at index through exit from, and the cost of reaching
+    // and leaving it. Negative if it can't be left so.
+    std::pair<int, int> cheapest_exit( const sector_costs &costs, const int index,
+                                       const int exit ) const {
+        std::pair<int, int> best( -1, -1 );
+        for( int state = index * entry_kinds; state < ( index + 1 ) * entry_kinds; state++ ) {
+            const int leave = leave_cost( costs, state, exit );
+            if( leave >= 0 && ( best.first < 0 || cost[state] + leave < best.second ) ) {
+                best = { state, cost[state] + leave };
+            }
+        }
+        return best;
+    }
+};
+
+// Dijkstra with a bucket queue: the costs are small integers, so the states to visit are sorted
+// by the cost to reach them for almost nothing.
+void search_sector( const sector_costs &costs, const int start, const int entered,
+                    const bool free_start, sector_search &result )
+{
+    result.cost.fill( -1 );
+    result.prev.fill( -1 );
+    // All the costs to reach states are multiples of step, and everything queued at any time
+    // costs at most max_cost more than what is being visited.
+    int max_cost = 0;
+    int step = 0;
+    for( const int cost : costs.cost ) {
+        max_cost = std::max( max_cost, cost );
+        for( const int through : {
+                 cost, through_cost( cost, 0, 1 )
+             } ) {
+            step = through > 0 ? std::gcd( step, through ) : step;
+        }
+    }
+    step = std::max( step, 1 );
+    const size_t bucket_count = max_cost / step + 1;
+    std::vector<std::vector<int16_t>> &buckets = result.buckets;
+    if( buckets.size() < bucket_count ) {
+        buckets.resize( bucket_count );
+    }
+    for( std::vector<int16_t> &bucket : buckets ) {
+        bucket.clear();
+    }
+    result.start = start * entry_kinds + entered;
+    result.free_start = free_start;
+    result.cost[result.start] = 0;
+    buckets[0].push_back( static_cast<int16_t>( result.start ) );
+    size_t queued = 1;
+    for( int cost = 0; queued > 0; cost += step ) {
+        std::vector<int16_t> &bucket = buckets[cost / step % bucket_count];
+        // States that can be left for free go to the bucket being visited
+        for( size_t i = 0; i < bucket.size(); i++ ) {
+            const int cur = bucket[i];
+            queued--;
+            if( result.cost[cur] != cost ) {
+                continue; // already reached for less
+            }
+            const std::array<int, 4> neighbors = sector_neighbors( cur / entry_kinds );
+            for( int side = 0; side < 4; side++ ) {
+                const int next = neighbors[side];
+                if( next < 0 || costs.cost[next] < 0 ) {
+                    continue;
+                }
+                const int leave = result.leave_cost( costs, cur, side );
+                if( leave < 0 ) {
+                    continue;
+                }
+                const int next_state = next * entry_kinds + opposite_side( side );
+                const int next_cost = cost + leave;
+                if( result.cost[next_state] >= 0 && result.cost[next_state] <= next_cost ) {
+                    continue;
+                }
+                result.cost[next_state] = next_cost;
+                result.prev[next_state] = static_cast<int16_t>( cur );
+                buckets[next_cost / step % bucket_count].push_back(
+                    static_cast<int16_t>( next_state ) );
+                queued++;
+            }
+        }
+        bucket.clear();
+    }
+}
+
+// A point of the search over the entrances: an OMT and how it was entered.
+using waypoint_key = std::pair<tripoint_abs_omt, int>;
+
+} // namespace
+
+omt_travel_graph::omt_travel_graph( revision_fn revision, costs_fn costs ) :
+    revision( std::move( revision ) ), costs( std::move( costs ) )
+{
+}
+
+const omt_travel_graph::sector &omt_travel_graph::get_costs( const tripoint_abs_omt &origin )
+{
+    sector &sec = sectors[origin];
+    if( sec.checked_by != searches ) {
+        sec.checked_by = searches;
+        const uint64_t current = revision( origin );
+        if( !sec.has_costs || sec.revision != current ) {
+            costs( origin, sec.costs );
+            sec.revision = current;
+            sec.has_costs = true;
+        }
+    }
+    return sec;
+}
+
+const omt_travel_graph::sector &omt_travel_graph::get_graph( const tripoint_abs_omt &origin )
+{
+    sector &sec = sectors[origin];
+    if( sec.has_graph && sec.graph_checked_by == searches ) {
+        return sec;
+    }
+    std::array<uint64_t, 7> revisions;
+    revisions[0] = get_costs( origin ).revision;
+    for( size_t side = 0; side < sector_sides.size(); side++ ) {
+        revisions[side + 1] = get_costs( origin + sector_sides[side] * sector_size ).revision;
+    }
+    revisions[5] = get_costs( origin + tripoint_above ).revision;
+    revisions[6] = get_costs( origin + tripoint_below ).revision;
+    if( !sec.has_graph || sec.graph_revisions != revisions ) {
+        find_entrances( sec, origin );
+        sec.graph_revisions = revisions;
+        sec.has_graph = true;
+    }
+    sec.graph_checked_by = searches;
+    return sec;
+}
+
+void omt_travel_graph::find_entrances( sector &sec, const tripoint_abs_omt &origin )
+{
+    sec.entrances.clear();
+    sec.exits.clear();
+    sec.entrance_at.fill( -1 );
+    const auto add_entrance = [&sec]( const int index, const uint8_t exit ) {
+        if( sec.entrance_at[index] < 0 ) {
+            sec.entrance_at[index] = static_cast<int16_t>( sec.entrances.size() );
+            sec.entrances.push_back( index );
+            sec.exits.push_back( 0 );
+        }
+        sec.exits[sec.entrance_at[index]] |= exit;
+    };
+    const sector_costs &here = sec.costs;
+    for( size_t side = 0; side < sector_sides.size(); side++ ) {
+        const sector_costs &there = sectors.at( origin + sector_sides[side] * sector_size ).costs;
+        const size_t opposite = ( side + 2 ) % sector_sides.size();
+        int run_start = -1;
+        for( int i = 0; i <= sector_size; i++ ) {
+            const bool open = i < sector_size && here.cost[side_index( side, i )] >= 0 &&
+                              there.cost[side_index( opposite, i )] >= 0;
+            if( open && run_start < 0 ) {
+                run_start = i;
+            } else if( !open && run_start >= 0 ) {
+                // Spread over the run, both sides of the border have to pick the same OMTs
+                const int length = i - run_start;
+                const int count = ( length + max_entrance_spacing - 1 ) / max_entrance_spacing;
+                for( int k = 0; k < count; k++ ) {
+                    const int picked = run_start + ( 2 * k + 1 ) * length / ( 2 * count );
+                    add_entrance( side_index( side, picked ), 1 << side );
+                }
+                run_start = -1;
+            }
+        }
+    }
+    const sector_costs &above = sectors.at( origin + tripoint_above ).costs;
+    const sector_costs &below = sectors.at( origin + tripoint_below ).costs;
+    for( int i = 0; i < sector_area; i++ ) {
+        if( here.cost[i] < 0 ) {
+            continue;
+        }
+        if( here.allow_z_change[i] && above.cost[i] >= 0 ) {
+            add_entrance( i, 1 << exit_up );
+        }
+        if( here.allow_z_change[i] && below.cost[i] >= 0 ) {
+            add_entrance( i, 1 << exit_down );
+        }
+        // Where one gets to from the z-level above or below
+        if( ( above.allow_z_change[i] && above.cost[i] >= 0 ) ||
+            ( below.allow_z_change[i] && below.cost[i] >= 0 ) ) {
+            add_entrance( i, reached_vertically );
+        }
+    }
+
+    // An entrance is entered from the sides it leads out of, or from another z-level.
+    const int count = static_cast<int>( sec.entrances.size() );
+    sec.ins.clear();
+    sec.outs.clear();
+    sec.in_at.assign( count * entry_kinds, -1 );
+    for( int entrance = 0; entrance < count; entrance++ ) {
+        const uint8_t exits = sec.exits[entrance];
+        for( int side = 0; side < 4; side++ ) {
+            if( exits & ( 1 << side ) ) {
+                sec.in_at[entrance * entry_kinds + side] = static_cast<int16_t>( sec.ins.size() );
+                sec.ins.push_back( entrance * entry_kinds + side );
+            }
+        }
+        if( exits & reached_vertically ) {
+            sec.in_at[entrance * entry_kinds + entered_vertically] =
+                static_cast<int16_t>( sec.ins.size() );
+            sec.ins.push_back( entrance * entry_kinds + entered_vertically );
+        }
+        for( int exit = 0; exit < exit_kinds; exit++ ) {
+            if( exits & ( 1 << exit ) ) {
+                sec.outs.push_back( entrance * exit_kinds + exit );
+            }
+        }
+    }
+    sec.paths.assign( sec.ins.size() * sec.outs.size(), -1 );
+    sector_search search;
+    for( size_t in = 0; in < sec.ins.size(); in++ ) {
+        search_sector( here, sec.entrances[sec.ins[in] / entry_kinds], sec.ins[in] % entry_kinds,
+                       false, search );
+        for( size_t out = 0; out < sec.outs.size(); out++ ) {
+            const int exit_from = sec.entrances[sec.outs[out] / exit_kinds];
+            sec.paths[in * sec.outs.size() + out] =
+                search.cheapest_exit( here, exit_from, sec.outs[out] % exit_kinds ).second;
+        }
+    }
+}
+
+simple_path<tripoint_abs_omt> omt_travel_graph::find_path( const tripoint_abs_omt &source,
+        const tripoint_abs_omt &dest, const int radius,
+        const std::function<void( size_t, size_t )> &progress_fn )
+{
+    cata_assert( progress_fn != nullptr );
+    simple_path<tripoint_abs_omt> ret;
+    searches++;
+    // The sectors are kept until there are too many of them, after a few long trips, and then
+    // built again as they are needed.
+    constexpr size_t max_sectors = 16384;
+    if( sectors.size() > max_sectors ) {
+        sectors.clear();
+    }
+    if( source == dest ) {
+        ret.points.push_back( source );
+        return ret;
+    }
+    const tripoint_abs_omt source_origin = sector_origin( source );
+    const tripoint_abs_omt dest_origin = sector_origin( dest );
+    const int source_index = sector_index( source_origin, source );
+    const int dest_index = sector_index( dest_origin, dest );
+    if( get_costs( dest_origin ).costs.cost[dest_index] < 0 ) {
+        return ret;
+    }
+
+    // The OMTs of the sectors of the source and of the destination are searched, the rest of
+    // the search only goes through entrances.
+    sector_search search;
+    const sector &dest_sector = get_graph( dest_origin );
+    // The state the destination is reached in from each way into its sector, negative if it
+    // isn't
+    std::vector<int> to_dest;
+    std::vector<int> to_dest_cost;
+    for( const int in : dest_sector.ins ) {
+        search_sector( dest_sector.costs, dest_sector.entrances[in / entry_kinds], in % entry_kinds,
+                       false, search );
+        const int arrival = search.cheapest_arrival( dest_index );
+        to_dest.push_back( arrival );
+        to_dest_cost.push_back( arrival >= 0 ? search.cost[arrival] : -1 );
+    }
+    sector_search from_source;
+    search_sector( get_graph( source_origin ).costs, source_index, entered_vertically, true,
+                   from_source );
+
+    struct waypoint {
+        int cost;
+        waypoint_key prev;
+        // Whether it was reached within the sector of prev rather than by leaving it.
+        bool within;
+        bool closed;
+    };
+    struct scored_waypoint {
+        int score;
+        waypoint_key key;
+        bool operator> ( const scored_waypoint &other ) const {
+            return score > other.score;
+        }
+    };
+    constexpr size_t max_search_count = 100000;
+    std::unordered_map<waypoint_key, waypoint, cata::tuple_hash> known_waypoints;
+    std::priority_queue<scored_waypoint, std::vector<scored_waypoint>, std::greater<>> open_set;
+    // As if the rest of the way cost 12 per OMT, a bit more than the 10 of a road. That can make
+    // the path up to 20% more costly, a few percent in practice, but long searches look at a small
+    // part of the entrances they would look at otherwise.
+    const auto estimate = [&dest]( const tripoint_abs_omt & p ) {
+        return octile_dist( p.xy(), dest.xy(), 12 ) + std::abs( p.z() - dest.z() ) * 12;
+    };
+    const auto reach = [&]( const waypoint_key & key, const waypoint_key & from, const int cost,
+    const bool within ) {
+        if( octile_dist( source.xy(), key.first.xy() ) > radius ) {
+            return;
+        }
+        const auto iter = known_waypoints.find( key );
+        if( iter == known_waypoints.end() ) {
+            if( known_waypoints.size() >= max_search_count ) {
+                return;
+            }
+            known_waypoints.emplace( key, waypoint{ cost, from, within, false } );
+        } else if( iter->second.closed || iter->second.cost <= cost ) {
+            return;
+        } else {
+            iter->second.cost = cost;
+            iter->second.prev = from;
+            iter->second.within = within;
+        }
+        open_set.push( scored_waypoint{ cost + estimate( key.first ), key } );
+    };
+    // Leaves the sector at origin through an exit of one of its entrances, by y * sector_size + x
+    // and exit.
+    const auto leave = [&]( const tripoint_abs_omt & origin, const int exit_from, const int exit,
+    const waypoint_key & from, const int cost ) {
+        const tripoint_abs_omt p = sector_omt( origin, exit_from );
+        if( exit < 4 ) {
+            reach( waypoint_key( p + sector_sides[exit], opposite_side( exit ) ), from, cost,
+                   false );
+        } else {
+            reach( waypoint_key( p + ( exit == exit_up ? tripoint_above : tripoint_below ),
+                                 entered_vertically ), from, cost, false );
+        }
+    };
+    const waypoint_key source_key( source, entered_vertically );
+    known_waypoints.emplace( source_key, waypoint{ 0, source_key, false, false } );
+    open_set.push( scored_waypoint{ estimate( source ), source_key } );
+    // Building the sectors a search goes through for the first time can take a while, the
+    // progress is reported when it does.
+    constexpr auto report_period = std::chrono::milliseconds( 100 );
+    std::chrono::steady_clock::time_point report_next = std::chrono::steady_clock::now() +
+            report_period;
+    int progress = 0;
+    std::optional<waypoint_key> found;
+    while( !open_set.empty() ) {
+        const waypoint_key cur_key = open_set.top().key;
+        open_set.pop();
+        if( progress++ >= 10 ) { // stagger progress checks to 1 in 10 waypoints
+            progress = 0;
+            const auto now = std::chrono::steady_clock::now();
+            if( now > report_next ) { // report progress every `report_period`
+                progress_fn( open_set.size(), known_waypoints.size() );
+                report_next = now + report_period;
+            }
+        }
+        waypoint &cur_waypoint = known_waypoints.at( cur_key );
+        if( cur_waypoint.closed ) {
+            continue;
+        }
+        cur_waypoint.closed = true;
+        const tripoint_abs_omt &cur = cur_key.first;
+        if( cur == dest ) {
+            found = cur_key;
+            break;
+        }
+        const int cur_cost = cur_waypoint.cost;
+        const tripoint_abs_omt origin = sector_origin( cur );
+        const sector &sec = get_graph( origin );
+        if( cur_key == source_key ) {
+            for( const int out : sec.outs ) {
+                const int exit_from = sec.entrances[out / exit_kinds];
+                const int cost =
+                    from_source.cheapest_exit( sec.costs, exit_from, out % exit_kinds ).second;
+                if( cost >= 0 ) {
+                    leave( origin, exit_from, out % exit_kinds, cur_key, cur_cost + cost );
+                }
+            }
+            const int arrival = from_source.cheapest_arrival( dest_index );
+            if( origin == dest_origin && arrival >= 0 ) {
+                reach( waypoint_key( dest, arrival % entry_kinds ), cur_key,
+                       cur_cost + from_source.cost[arrival], true );
+            }
+            continue;
+        }
+        const int entrance = sec.entrance_at[sector_index( origin, cur )];
+        const int in = entrance >= 0 ? sec.in_at[entrance * entry_kinds + cur_key.second] : -1;
+        if( in < 0 ) {
+            continue;
+        }
+        for( size_t out = 0; out < sec.outs.size(); out++ ) {
+            const int path_cost = sec.paths[in * sec.outs.size() + out];
+            if( path_cost >= 0 ) {
+                leave( origin, sec.entrances[sec.outs[out] / exit_kinds],
+                       sec.outs[out] % exit_kinds, cur_key, cur_cost + path_cost );
+            }
+        }
+        if( origin == dest_origin && to_dest[in] >= 0 ) {
+            reach( waypoint_key( dest, to_dest[in] % entry_kinds ), cur_key,
+                   cur_cost + to_dest_cost[in], true );
+        }
+    }
+    if( !found ) {
+        return ret;
+    }
+
+    // Fill in the OMTs between the waypoints, from the destination back to the source
+    ret.points.push_back( dest );
+    for( waypoint_key to = *found; to != source_key; ) {
+        const waypoint &to_waypoint = known_waypoints.at( to );
+        const waypoint_key &from = to_waypoint.prev;
+        const tripoint_abs_omt origin = sector_origin( from.first );
+        const sector_costs &from_costs = get_costs( origin ).costs;
+        search_sector( from_costs, sector_index( origin, from.first ), from.second,
+                       from == source_key, search );
+        // The last state in the sector of from
+        int state;
+        if( to_waypoint.within ) {
+            state = search.prev[sector_index( origin, to.first ) * entry_kinds + to.second];
+        } else if( to.second < 4 ) {
+            const int exit_from = sector_index( origin, to.first + sector_sides[to.second] );
+            state = search.cheapest_exit( from_costs, exit_from, opposite_side( to.second ) ).first;
+        } else {
+            const int exit_from = sector_index( origin, tripoint_abs_omt( to.first.xy(),
+                                                from.first.z() ) );
+            const int exit = from.first.z() < to.first.z() ? exit_up : exit_down;
+            state = search.cheapest_exit( from_costs, exit_from, exit ).first;
+        }
+        for( ; state != search.start; state = search.prev[state] ) {
+            ret.points.push_back( sector_omt( origin, state / entry_kinds ) );
+        }
+        ret.points.push_back( from.first );
+        to = from;
+    }
+    return ret;
+}
+
 } // namespace pf
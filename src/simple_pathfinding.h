@@ -2,8 +2,12 @@
 #ifndef CATA_SRC_SIMPLE_PATHFINDING_H
 #define CATA_SRC_SIMPLE_PATHFINDING_H
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <functional>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "coordinates.h"
@@ -130,6 +134,104 @@ simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
         const std::function<void( size_t, size_t )> &progress_fn,
         const std::optional<int> &max_cost = std::nullopt );
 
+/**
+ * Finds paths over OMTs like @ref find_overmap_path, approximately, through a graph that is
+ * kept between searches so that long paths take milliseconds rather than seconds.
+ *
+ * The OMTs are split in sectors of sector_size x sector_size OMTs of a z-level. The entrances of
+ * a sector are a few OMTs of each run of OMTs that can be crossed into the neighboring sector,
+ * and the OMTs where one can go up or down. The cheapest paths between the entrances of a sector
+ * are computed once, a search goes from entrance to entrance and only looks at the OMTs of the
+ * sectors it goes through to turn that into a path over OMTs.
+ *
+ * The costs of a sector are read again when its revision changes, and its paths recomputed when
+ * its costs or those of its neighbors did, so the graph follows changes to the terrain.
+ *
+ * As in @ref find_overmap_path, turning in an OMT costs less than going straight through it,
+ * so the paths within a sector are found between the ways into and out of its entrances.
+ */
+class omt_travel_graph
+{
+    public:
+        static constexpr int sector_size = 20;
+        static constexpr int sector_area = sector_size * sector_size;
+
+        struct sector_costs {
+            // Cost of going through each OMT of the sector, by y * sector_size + x, negative if
+            // it can't be traversed.
+            std::array<int, sector_area> cost;
+            // Whether it may be possible to go up or down from each OMT.
+            std::bitset<sector_area> allow_z_change;
+        };
+
+        /**
+         * Returns the revision of the costs of the sector with its (0, 0) corner at the given
+         * OMT, which has to change whenever they do.
+         */
+        using revision_fn = std::function<uint64_t( const tripoint_abs_omt & )>;
+        /** Fills the costs of the sector with its (0, 0) corner at the given OMT. */
+        using costs_fn = std::function<void( const tripoint_abs_omt &, sector_costs & )>;
+
+        omt_travel_graph( revision_fn revision, costs_fn costs );
+
+        /**
+         * The path from @p source to @p dest, see @ref find_overmap_path. The cost of
+         * @p source is ignored, it can always be left.
+         * @param radius Maximum search radius
+         * @param progress_fn Called now and then while a search takes long, when it goes
+         * through sectors that were not built yet.
+         */
+        simple_path<tripoint_abs_omt> find_path( const tripoint_abs_omt &source,
+                const tripoint_abs_omt &dest, int radius,
+                const std::function<void( size_t, size_t )> &progress_fn );
+
+    private:
+        struct sector {
+            // Revision the costs were read at.
+            uint64_t revision = 0;
+            bool has_costs = false;
+            // Search the revision was last checked by.
+            uint64_t checked_by = 0;
+            sector_costs costs;
+
+            // Revisions of this sector and of its neighbors (east, south, west, north, above
+            // and below) the entrances were found with.
+            std::array<uint64_t, 7> graph_revisions;
+            bool has_graph = false;
+            // Search the revisions of the graph were last checked by.
+            uint64_t graph_checked_by = 0;
+            // OMTs of the entrances, by y * sector_size + x.
+            std::vector<int> entrances;
+            // For each entrance, the directions it leads out of the sector in, and whether it is
+            // reached from another z-level, as a bitmask.
+            std::vector<uint8_t> exits;
+            // Index in entrances by OMT, negative if the OMT is no entrance.
+            std::array<int16_t, sector_area> entrance_at;
+            // The ways into the sector, as entrance * 5 + the side the entrance is entered from,
+            // or 4 for another z-level.
+            std::vector<int> ins;
+            // Index in ins by entrance * 5 + how it is entered, negative if it isn't entered so.
+            std::vector<int16_t> in_at;
+            // The ways out of the sector, as entrance * 6 + the side it is left through, or 4 for
+            // up and 5 for down.
+            std::vector<int> outs;
+            // Cost of the cheapest path within the sector from ins[i] to leaving through outs[j]
+            // at i * outs.size() + j, including going through the OMT left, negative if there is
+            // none.
+            std::vector<int> paths;
+        };
+
+        const sector &get_costs( const tripoint_abs_omt &origin );
+        const sector &get_graph( const tripoint_abs_omt &origin );
+        void find_entrances( sector &sec, const tripoint_abs_omt &origin );
+
+        revision_fn revision;
+        costs_fn costs;
+        // By their (0, 0) corner.
+        std::unordered_map<tripoint_abs_omt, sector> sectors;
+        uint64_t searches = 0;
+};
+
 } // namespace pf
 
 #endif // CATA_SRC_SIMPLE_PATHFINDING_H
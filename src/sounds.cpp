@@ -33,6 +33,7 @@
 #include "overmapbuffer.h"
 #include "player_activity.h"
 #include "point.h"
+#include "profiler.h"
 #include "rng.h"
 #include "safemode_ui.h"
 #include "string_formatter.h"
@@ -452,6 +453,7 @@ static int get_signal_for_hordes( const centroid &centr )
 
 void sounds::process_sounds()
 {
+    CATA_PROFILE_ZONE( "sounds::process_sounds" );
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
     for( const centroid &this_centroid : sound_clusters ) {
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "basecamp.h"
+#include "field_type.h"
 #include "mapdata.h"
 #include "tileray.h"
 #include "trap.h"
@@ -36,6 +37,29 @@ void submap::clear_fields( const point &p )
     field &f = get_field( p );
     field_count -= f.field_count();
     f.clear();
+    fires_changed();
+}
+
+const std::vector<point> &submap::get_fires()
+{
+    if( fires_valid ) {
+        return fires;
+    }
+    fires.clear();
+    fires_valid = true;
+    if( is_uniform() || field_count == 0 ) {
+        return fires;
+    }
+    // cache string_id -> int_id conversion before the loop
+    const field_type_id fire = fd_fire;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( m->fld[x][y].find_field( fire ) ) {
+                fires.emplace_back( x, y );
+            }
+        }
+    }
+    return fires;
 }
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
@@ -229,6 +253,7 @@ void submap::rotate( int turns )
     if( turns == 0 ) {
         return;
     }
+    fires_changed();
 
     const auto rotate_point = [turns]( const point & p ) {
         return p.rotate( turns, { SEEX, SEEY } );
@@ -301,6 +326,7 @@ void submap::mirror( bool horizontally )
     if( is_uniform() ) {
         return;
     }
+    fires_changed();
     std::map<point, computer> mirror_comp;
 
     if( horizontally ) {
@@ -216,6 +216,16 @@ class submap
 
         void clear_fields( const point &p );
 
+        /**
+         * Positions of the fire fields, collected again after @ref fires_changed. Contained
+         * fires (@ref ter_furn_flag::TFLAG_FIRE_CONTAINER) are included.
+         */
+        const std::vector<point> &get_fires();
+        /** Call after adding or removing fire, @ref map::on_field_modified does it. */
+        void fires_changed() {
+            fires_valid = false;
+        }
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -301,6 +311,9 @@ class submap
         ter_id uniform_ter = t_null;
         int temperature_mod = 0; // delta in F
 
+        std::vector<point> fires;
+        bool fires_valid = false;
+
         void update_legacy_computer();
 
         static constexpr size_t elements = SEEX * SEEY;
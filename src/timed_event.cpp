@@ -31,6 +31,7 @@
 #include "monster.h"
 #include "morale_types.h"
 #include "options.h"
+#include "profiler.h"
 #include "rng.h"
 #include "sounds.h"
 #include "text_snippets.h"
@@ -396,6 +397,7 @@ void timed_event::per_turn()
 
 void timed_event_manager::process()
 {
+    CATA_PROFILE_ZONE( "timed_event_manager::process" );
     for( auto it = events.begin(); it != events.end(); ) {
         it->per_turn();
         if( it->when <= calendar::turn ) {
@@ -12,6 +12,7 @@
 #include "cursesdef.h"
 #include "game_ui.h"
 #include "point.h"
+#include "profiler.h"
 #include "sdltiles.h" // IWYU pragma: keep
 
 using ui_stack_t = std::vector<std::reference_wrapper<ui_adaptor>>;
@@ -323,6 +324,7 @@ void ui_adaptor::redraw()
 
 void ui_adaptor::redraw_invalidated()
 {
+    CATA_PROFILE_ZONE( "ui_adaptor::redraw_invalidated" );
     if( test_mode || ui_stack.empty() ) {
         return;
     }
@@ -127,7 +127,7 @@ veh_app_interact::veh_app_interact( vehicle &veh, const point &p )
 // @returns true if a battery part exists on any vehicle connected to veh
 static bool has_battery_in_grid( vehicle *veh )
 {
-    return !veh->search_connected_batteries().empty();
+    return !veh->power_grid().batteries.empty();
 }
 
 void veh_app_interact::init_ui_windows()
@@ -223,7 +223,7 @@ void veh_app_interact::draw_info()
 
     // Battery power output
     units::power grid_flow = 0_W;
-    for( const std::pair<vehicle *const, float> &pair : veh->search_connected_vehicles() ) {
+    for( const std::pair<vehicle *, float> &pair : veh->power_grid().vehicles ) {
         grid_flow += pair.first->net_battery_charge_rate( /* include_reactors = */ true );
     }
     print_charge( _( "Grid battery power flow: " ), grid_flow, row );
@@ -2428,12 +2428,11 @@ std::vector<int> vehicle::parts_at_relative( const point &dp, const bool use_cac
             }
         }
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
+        if( const std::vector<int> *parts_here = relative_parts.find( dp ) ) {
             if( include_fake ) {
-                return iter->second;
+                return *parts_here;
             } else {
-                for( const int vp : iter->second ) {
+                for( const int vp : *parts_here ) {
                     if( !parts.at( vp ).is_fake ) {
                         res.push_back( vp );
                     }
@@ -3298,7 +3297,7 @@ int64_t vehicle::fuel_left( const itype_id &ftype,
 {
     int64_t fl = 0;
     if( ftype == fuel_type_battery ) {
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *, float> &pair : power_grid().vehicles ) {
             const vehicle &veh = *pair.first;
             const float loss = pair.second;
             for( const int part_idx : veh.batteries ) {
@@ -3362,7 +3361,7 @@ int vehicle::fuel_capacity( const itype_id &ftype ) const
 {
     if( ftype == fuel_type_battery ) { // batteries get special treatment due to power cables
         int64_t capacity = 0;
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *, float> &pair : power_grid().vehicles ) {
             const vehicle &veh = *pair.first;
             for( const int part_idx : veh.batteries ) {
                 const vehicle_part &vp = veh.parts[part_idx];
@@ -4713,7 +4712,7 @@ std::pair<int, int> vehicle::connected_battery_power_level() const
     int total_epower_remaining = 0;
     int total_epower_capacity = 0;
 
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *, float> &pair : power_grid().vehicles ) {
         int epower_remaining;
         int epower_capacity;
         std::tie( epower_remaining, epower_capacity ) = pair.first->battery_power_level();
@@ -5128,6 +5127,115 @@ std::map<const vehicle *, float> vehicle::search_connected_vehicles() const
     return search_connected_vehicles( this );
 }
 
+vehicle_power_grid_cache::vehicle_power_grid_cache( const vehicle_power_grid_cache & ) {}
+
+vehicle_power_grid_cache &vehicle_power_grid_cache::operator=( const vehicle_power_grid_cache & )
+{
+    invalidate();
+    return *this;
+}
+
+vehicle_power_grid_cache &vehicle_power_grid_cache::operator=( vehicle_power_grid_cache &&other )
+noexcept
+{
+    invalidate();
+    other.invalidate();
+    return *this;
+}
+
+vehicle_power_grid_cache::~vehicle_power_grid_cache()
+{
+    invalidate();
+}
+
+void vehicle_power_grid_cache::set( vehicle_power_grid &&new_grid,
+                                    const std::vector<vehicle_power_grid_cache *> &new_members )
+{
+    drop();
+    grid = std::move( new_grid );
+    members = new_members;
+    for( vehicle_power_grid_cache *member : members ) {
+        member->dependents.push_back( this );
+    }
+    valid = true;
+}
+
+const vehicle_power_grid &vehicle_power_grid_cache::hold( vehicle_power_grid &&new_grid )
+{
+    drop();
+    grid = std::move( new_grid );
+    return grid;
+}
+
+void vehicle_power_grid_cache::drop()
+{
+    for( vehicle_power_grid_cache *member : members ) {
+        std::vector<vehicle_power_grid_cache *> &deps = member->dependents;
+        deps.erase( std::find( deps.begin(), deps.end(), this ) );
+    }
+    members.clear();
+    valid = false;
+}
+
+void vehicle_power_grid_cache::invalidate()
+{
+    // dropping a grid removes it from the dependents of its members, this one included
+    while( !dependents.empty() ) {
+        dependents.back()->drop();
+    }
+    drop();
+}
+
+void vehicle::invalidate_power_grids()
+{
+    power_grid_cache.invalidate();
+}
+
+bool vehicle::has_cached_power_grid() const
+{
+    return power_grid_cache.get() != nullptr;
+}
+
+const vehicle_power_grid &vehicle::power_grid() const
+{
+    if( const vehicle_power_grid *cached = power_grid_cache.get() ) {
+        return *cached;
+    }
+    // the grid is a cache, constness of the connected vehicles is restored by the accessor
+    vehicle &self = const_cast<vehicle &>( *this );
+    vehicle_power_grid grid;
+    std::vector<vehicle_power_grid_cache *> members;
+    double loss_sum = 0.0;
+    bool complete = true;
+    for( const std::pair<vehicle *const, float> &pair : self.search_connected_vehicles() ) {
+        grid.vehicles.emplace_back( pair );
+        members.push_back( &pair.first->power_grid_cache );
+        for( const int part_idx : pair.first->loose_parts ) {
+            const vehicle_part &vp = pair.first->part( part_idx );
+            // a cable to a vehicle that could not be found, the grid may grow once it is loaded
+            complete &= !vp.info().has_flag( "POWER_TRANSFER" ) ||
+                        find_vehicle( vp.target.second ) != nullptr;
+        }
+    }
+    for( const std::pair<const vpart_reference, float> &pair : self.search_connected_batteries() ) {
+        const int capacity = pair.first.part().ammo_capacity( ammo_battery );
+        const int part_idx = static_cast<int>( pair.first.part_index() );
+        grid.batteries.push_back( { &pair.first.vehicle(), part_idx, pair.second } );
+        grid.total_capacity += capacity;
+        loss_sum += static_cast<double>( pair.second ) * capacity;
+    }
+    if( grid.total_capacity > 0 ) {
+        grid.weighted_loss = loss_sum / grid.total_capacity;
+    }
+    if( !complete ) {
+        // not cached, it is searched again next time
+        return power_grid_cache.hold( std::move( grid ) );
+    }
+    // searching may have loaded submaps, which does not invalidate the grid we just built
+    power_grid_cache.set( std::move( grid ), members );
+    return *power_grid_cache.get();
+}
+
 std::map<vpart_reference, float> vehicle::search_connected_batteries()
 {
     std::map<vpart_reference, float> result;
@@ -5147,28 +5255,24 @@ std::map<vpart_reference, float> vehicle::search_connected_batteries()
     return result;
 }
 
-// helper method to calculate power loss weighted by capacity
-static double weighted_power_loss( const std::map<vpart_reference, float> &batteries )
+// helper method to sum the current charge of the batteries of a power grid
+static int64_t total_battery_charge( const std::vector<vehicle_power_grid::battery> &batteries )
 {
-    double res = 0.0; // sum of power losses
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        const int capacity = vp.ammo_capacity( ammo_battery );
-        total_capacity += capacity;
-        res += pair.second * capacity;
+    int64_t total_charge = 0;
+    for( const vehicle_power_grid::battery &bat : batteries ) {
+        total_charge += bat.veh->part( bat.part_idx ).ammo_remaining();
     }
-    return res / total_capacity;
+    return total_charge;
 }
 
-// helper method to take a map of batteries, amount of charge, total capacity of batteries
-// and distribute given charge_kj over the batteries as evenly as possible
-static void distribute_charge_evenly( const std::map<vpart_reference, float> &batteries,
+// helper method to take the batteries of a power grid, amount of charge, total capacity of
+// batteries and distribute given charge_kj over the batteries as evenly as possible
+static void distribute_charge_evenly( const std::vector<vehicle_power_grid::battery> &batteries,
                                       int64_t charge_kj, int64_t total_capacity_kj )
 {
     int64_t distributed = 0;
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
+    for( const vehicle_power_grid::battery &bat : batteries ) {
+        vehicle_part &vp = bat.veh->part( bat.part_idx );
         const int bat_capacity = vp.ammo_capacity( ammo_battery );
         const float fraction = static_cast<float>( bat_capacity ) / total_capacity_kj;
         const int portion = charge_kj * fraction;
@@ -5176,8 +5280,8 @@ static void distribute_charge_evenly( const std::map<vpart_reference, float> &ba
         distributed += portion;
     }
     if( distributed < charge_kj ) { // dump indivisible remainder sequentially
-        for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-            vehicle_part &vp = pair.first.part();
+        for( const vehicle_power_grid::battery &bat : batteries ) {
+            vehicle_part &vp = bat.veh->part( bat.part_idx );
             const int64_t bat_charge = vp.ammo_remaining();
             const int64_t bat_capacity = vp.ammo_capacity( ammo_battery );
             const int chargeable = std::min( charge_kj - distributed, bat_capacity - bat_charge );
@@ -5196,7 +5300,7 @@ static void distribute_charge_evenly( const std::map<vpart_reference, float> &ba
 int64_t vehicle::battery_left( bool apply_loss ) const
 {
     int64_t ret = 0;
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *, float> &pair : power_grid().vehicles ) {
         const vehicle &veh = *pair.first;
         const float efficiency = 1.0f - ( apply_loss ? pair.second : 0.0f );
         for( const int part_idx : veh.batteries ) {
@@ -5216,18 +5320,15 @@ int vehicle::charge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
+    const vehicle_power_grid &grid = power_grid();
+    const std::vector<vehicle_power_grid::battery> &batteries = grid.batteries;
     if( batteries.empty() ) {
         return amount;
     }
-    const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
-    int64_t total_charge = 0; // sum of current charge of all batteries
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        total_charge += vp.ammo_remaining();
-        total_capacity += vp.ammo_capacity( ammo_battery );
-    }
+    const double loss = apply_loss ? grid.weighted_loss : 0.0;
+    // sum of current charge of all batteries
+    int64_t total_charge = total_battery_charge( batteries );
+    const int64_t total_capacity = grid.total_capacity; // sum of capacity of all batteries
     const int64_t chargeable = total_capacity - total_charge;
     int64_t lost_amount = roll_remainder( amount * loss );
     int64_t lossy_amount = amount;
@@ -5259,18 +5360,15 @@ int vehicle::discharge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
+    const vehicle_power_grid &grid = power_grid();
+    const std::vector<vehicle_power_grid::battery> &batteries = grid.batteries;
     if( batteries.empty() ) {
         return amount;
     }
-    const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
-    int64_t total_charge = 0; // sum of current charge of all batteries
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        total_charge += vp.ammo_remaining();
-        total_capacity += vp.ammo_capacity( ammo_battery );
-    }
+    const double loss = apply_loss ? grid.weighted_loss : 0.0;
+    // sum of current charge of all batteries
+    int64_t total_charge = total_battery_charge( batteries );
+    const int64_t total_capacity = grid.total_capacity; // sum of capacity of all batteries
 
     int64_t discharged = amount;
     int64_t lost_amount = roll_remainder( amount * loss );
@@ -5553,6 +5651,7 @@ std::optional<vehicle_stack::iterator> vehicle::add_item( int part, const item &
         item *here = istack.stacks_with( itm );
         if( here ) {
             invalidate_mass();
+            map::contents_changed();
             if( !here->merge_charges( itm ) ) {
                 return std::nullopt;
             } else {
@@ -5573,6 +5672,7 @@ std::optional<vehicle_stack::iterator> vehicle::add_item( int part, const item &
     active_items.add( *new_pos, p.mount );
 
     invalidate_mass();
+    map::contents_changed();
     return std::optional<vehicle_stack::iterator>( new_pos );
 }
 
@@ -5592,6 +5692,7 @@ vehicle_stack::iterator vehicle::remove_item( int part, const vehicle_stack::con
     cata::colony<item> &veh_items = parts[part].items;
 
     invalidate_mass();
+    map::contents_changed();
     return veh_items.erase( it );
 }
 
@@ -5852,6 +5953,10 @@ void vehicle::refresh( const bool remove_fakes )
     relative_parts.clear();
     loose_parts.clear();
     wheelcache.clear();
+    // parts or power cables may have changed
+    invalidate_power_grids();
+    // so may have the cargo space and tools found on the map
+    map::contents_changed();
     rail_wheelcache.clear();
     rotors.clear();
     steering.clear();
@@ -5909,10 +6014,10 @@ void vehicle::refresh( const bool remove_fakes )
         mount_max.y = std::max( mount_max.y, pt.y );
 
         // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
+        std::vector<int> &parts_here = relative_parts[pt];
+        std::vector<int>::iterator vii = std::lower_bound( parts_here.begin(), parts_here.end(),
                                          static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
+        parts_here.insert( vii, p );
 
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
@@ -6081,9 +6186,11 @@ void vehicle::refresh( const bool remove_fakes )
     // re-install fake parts - this could be done in a separate function, but we want to
     // guarantee that the fake parts were removed before being added
     if( remove_fakes && !has_tag( "wreckage" ) && !is_appliance() ) {
+        // adding fake parts adds new mount points, so iterate over a copy of the current ones
+        const std::vector<point> real_mounts = relative_parts.mounts();
         // add all the obstacles first
-        for( const std::pair <const point, std::vector<int>> &rp : relative_parts ) {
-            add_fake_part( rp.first, "OBSTACLE" );
+        for( const point &mount : real_mounts ) {
+            add_fake_part( mount, "OBSTACLE" );
         }
         // then add protrusions that hanging on top of fake obstacles.
 
@@ -6093,12 +6200,13 @@ void vehicle::refresh( const bool remove_fakes )
         }
 
         // add fake camera parts so vision isn't blocked by fake parts
-        for( const std::pair <const point, std::vector<int>> &rp : relative_parts ) {
-            add_fake_part( rp.first, "CAMERA" );
+        const std::vector<point> all_mounts = relative_parts.mounts();
+        for( const point &mount : all_mounts ) {
+            add_fake_part( mount, "CAMERA" );
         }
         // add fake curtains so vision is correctly blocked
-        for( const std::pair <const point, std::vector<int>> &rp : relative_parts ) {
-            add_fake_part( rp.first, "OPAQUE" );
+        for( const point &mount : all_mounts ) {
+            add_fake_part( mount, "OPAQUE" );
         }
     } else {
         // Always repopulate fake parts in relative_parts cache since we cleared it.
@@ -6136,25 +6244,25 @@ vpart_edge_info vehicle::get_edge_info( const point &mount ) const
     int r_index = -1;
     bool left_side = false;
     bool right_side = false;
-    if( relative_parts.find( forward ) != relative_parts.end() &&
-        !parts.at( relative_parts.at( forward ).front() ).is_fake ) {
-        f_index = relative_parts.at( forward ).front();
-    }
-    if( relative_parts.find( aft ) != relative_parts.end() &&
-        !parts.at( relative_parts.at( aft ).front() ).is_fake ) {
-        a_index = relative_parts.at( aft ).front();
-    }
-    if( relative_parts.find( left ) != relative_parts.end() &&
-        !parts.at( relative_parts.at( left ).front() ).is_fake ) {
-        l_index = relative_parts.at( left ).front();
-        if( parts.at( relative_parts.at( left ).front() ).info().has_flag( "PROTRUSION" ) ) {
+    const std::vector<int> *parts_forward = relative_parts.find( forward );
+    if( parts_forward && !parts.at( parts_forward->front() ).is_fake ) {
+        f_index = parts_forward->front();
+    }
+    const std::vector<int> *parts_aft = relative_parts.find( aft );
+    if( parts_aft && !parts.at( parts_aft->front() ).is_fake ) {
+        a_index = parts_aft->front();
+    }
+    const std::vector<int> *parts_left = relative_parts.find( left );
+    if( parts_left && !parts.at( parts_left->front() ).is_fake ) {
+        l_index = parts_left->front();
+        if( parts.at( l_index ).info().has_flag( "PROTRUSION" ) ) {
             left_side = true;
         }
     }
-    if( relative_parts.find( right ) != relative_parts.end() &&
-        !parts.at( relative_parts.at( right ).front() ).is_fake ) {
-        r_index = relative_parts.at( right ).front();
-        if( parts.at( relative_parts.at( right ).front() ).info().has_flag( "PROTRUSION" ) ) {
+    const std::vector<int> *parts_right = relative_parts.find( right );
+    if( parts_right && !parts.at( parts_right->front() ).is_fake ) {
+        r_index = parts_right->front();
+        if( parts.at( r_index ).info().has_flag( "PROTRUSION" ) ) {
             right_side = true;
         }
     }
@@ -6614,6 +6722,7 @@ void vehicle::shed_loose_parts( const tripoint_bub_ms *src, const tripoint_bub_m
                             // update remote part's target to new position
                             veh->parts[remote_lp].target.first = here.getabs( dst ? *dst : bub_part_pos( elem ) );
                             veh->parts[remote_lp].target.second = veh->parts[remote_lp].target.first;
+                            veh->invalidate_power_grids();
                         }
                     }
                 }
@@ -7271,14 +7380,28 @@ const std::set<tripoint> &vehicle::get_points( const bool force_refresh ) const
         occupied_cache_pos = global_pos3();
         occupied_cache_direction = face.dir();
         occupied_points.clear();
-        for( const std::pair<const point, std::vector<int>> &part_location : relative_parts ) {
-            occupied_points.insert( global_part_pos3( part_location.second.front() ) );
-        }
+        occupied_bounds = inclusive_cuboid<tripoint>( tripoint_max, tripoint_min );
+        relative_parts.for_each( [&]( const point &, const std::vector<int> &parts_here ) {
+            const tripoint p = global_part_pos3( parts_here.front() );
+            occupied_points.insert( p );
+            occupied_bounds.p_min = tripoint( std::min( p.x, occupied_bounds.p_min.x ),
+                                              std::min( p.y, occupied_bounds.p_min.y ),
+                                              std::min( p.z, occupied_bounds.p_min.z ) );
+            occupied_bounds.p_max = tripoint( std::max( p.x, occupied_bounds.p_max.x ),
+                                              std::max( p.y, occupied_bounds.p_max.y ),
+                                              std::max( p.z, occupied_bounds.p_max.z ) );
+        } );
     }
 
     return occupied_points;
 }
 
+const inclusive_cuboid<tripoint> &vehicle::get_points_bounds() const
+{
+    get_points();
+    return occupied_bounds;
+}
+
 std::list<item> vehicle::use_charges( const vpart_position &vp, const itype_id &type,
                                       int &quantity, const std::function<bool( const item & )> &filter, bool in_tools )
 {
@@ -7840,7 +7963,7 @@ tripoint vehicle::exhaust_dest( int part ) const
 {
     point p = parts[part].mount;
     // Move back from engine/muffler until we find an open space
-    while( relative_parts.find( p ) != relative_parts.end() ) {
+    while( relative_parts.contains( p ) ) {
         p.x += ( velocity < 0 ? 1 : -1 );
     }
     point q = coord_translate( p );
@@ -25,6 +25,7 @@
 #include "clzones.h"
 #include "colony.h"
 #include "coordinates.h"
+#include "cuboid_rectangle.h"
 #include "damage.h"
 #include "game_constants.h"
 #include "item.h"
@@ -36,6 +37,7 @@
 #include "tileray.h"
 #include "type_id.h"
 #include "units.h"
+#include "vehicle_mount_index.h"
 #include "vpart_range.h"
 
 class Character;
@@ -141,6 +143,18 @@ struct veh_collision {
     veh_collision() = default;
 };
 
+/**
+ * Broad phase of the collision checks of a single vehicle movement step.
+ * Computed once per step from the swept bounds of the vehicle, so the per-part checks
+ * can skip looking for other vehicles and characters that cannot be in the way.
+ */
+struct veh_collision_broadphase {
+    // whether the bounds of another vehicle intersect the swept bounds
+    bool other_vehicles = true;
+    // whether the avatar or an NPC is within the swept bounds
+    bool characters = true;
+};
+
 struct vpart_edge_info {
     int forward;
     int back;
@@ -214,6 +228,68 @@ struct bounding_box {
     point p2;
 };
 
+/**
+ * Power network of a vehicle, that is the vehicles and batteries reachable
+ * through POWER_TRANSFER parts together with their line losses.
+ */
+struct vehicle_power_grid {
+    struct battery {
+        vehicle *veh;
+        int part_idx;
+        // line loss, 0.01 corresponds to 1% charge loss to wire resistance
+        float loss;
+    };
+    // connected vehicles (including owner) and their line loss,
+    // ordered as search_connected_vehicles
+    std::vector<std::pair<vehicle *, float>> vehicles;
+    // non-fake batteries of all connected vehicles, ordered as search_connected_batteries
+    std::vector<battery> batteries;
+    // sum of battery capacity in kJ
+    int64_t total_capacity = 0;
+    // line loss of all batteries weighted by their capacity
+    double weighted_loss = 0.0;
+};
+
+/**
+ * Holds the cached power grid of a vehicle, built lazily by @ref vehicle::power_grid.
+ * The cache is linked to the caches of all vehicles in the grid, so the grid is dropped as
+ * soon as one of those vehicles changes (parts or cables installed or removed, a cable
+ * retargeted, the vehicle destroyed) while grids elsewhere on the map are kept.
+ * Copies start out empty and assigning to a cache counts as a change of its vehicle.
+ */
+class vehicle_power_grid_cache
+{
+    public:
+        vehicle_power_grid_cache() = default;
+        vehicle_power_grid_cache( const vehicle_power_grid_cache & );
+        vehicle_power_grid_cache &operator=( const vehicle_power_grid_cache & );
+        vehicle_power_grid_cache &operator=( vehicle_power_grid_cache &&other ) noexcept;
+        ~vehicle_power_grid_cache();
+
+        /// The cached grid, nullptr if there is none
+        const vehicle_power_grid *get() const {
+            return valid ? &grid : nullptr;
+        }
+        /// Caches @p new_grid until the vehicle of one of the caches in @p members changes
+        void set( vehicle_power_grid &&new_grid,
+                  const std::vector<vehicle_power_grid_cache *> &new_members );
+        /// Keeps @p new_grid without caching it, for grids that have to be searched again
+        const vehicle_power_grid &hold( vehicle_power_grid &&new_grid );
+        /// Drops the cached grids of all vehicles whose grid contains the vehicle of this cache
+        void invalidate();
+
+    private:
+        /// Drops the grid of this cache alone
+        void drop();
+
+        vehicle_power_grid grid;
+        bool valid = false;
+        // caches of the vehicles in the grid
+        std::vector<vehicle_power_grid_cache *> members;
+        // caches whose grid contains the vehicle of this cache
+        std::vector<vehicle_power_grid_cache *> dependents;
+};
+
 int mps_to_vmiph( double mps );
 double vmiph_to_mps( int vmiph );
 int cmps_to_vmiph( int cmps );
@@ -832,6 +908,15 @@ class vehicle
         /// May load the connected vehicles' submaps
         std::map<vpart_reference, float> search_connected_batteries();
 
+        /// Returns the cached power network of this vehicle, rebuilding it with
+        /// @ref search_connected_vehicles if it was invalidated since it was last built.
+        /// May load the connected vehicles' submaps when rebuilding.
+        const vehicle_power_grid &power_grid() const;
+        /// Whether @ref power_grid has a cached network to return
+        bool has_cached_power_grid() const;
+        /// Drops the cached power networks that contain this vehicle
+        void invalidate_power_grids();
+
         vehicle( map &placed_on, const vproto_id &type_id, int init_veh_fuel = -1,
                  int init_veh_status = -1, bool may_spawn_locked = false );
         vehicle();
@@ -1625,8 +1710,10 @@ class vehicle
 
         // Handle given part collision with vehicle, monster/NPC/player or terrain obstacle
         // Returns collision, which has type, impulse, part, & target.
+        // If given, the broad phase is used to skip checks for things that are not nearby.
         veh_collision part_collision( int part, const tripoint &p,
-                                      bool just_detect, bool bash_floor );
+                                      bool just_detect, bool bash_floor,
+                                      const veh_collision_broadphase *broadphase = nullptr );
 
         // Process the trap beneath
         void handle_trap( const tripoint &p, int part );
@@ -1804,6 +1891,8 @@ class vehicle
 
         // Update the set of occupied points and return a reference to it
         const std::set<tripoint> &get_points( bool force_refresh = false ) const;
+        // Bounds of the points returned by get_points, updated along with them
+        const inclusive_cuboid<tripoint> &get_points_bounds() const;
 
         /**
         * Consumes specified charges (or fewer) from the vehicle part
@@ -1970,6 +2059,8 @@ class vehicle
         mutable units::angle occupied_cache_direction = 0_degrees; // NOLINT(cata-serialize)
         // Cached points occupied by the vehicle
         mutable std::set<tripoint> occupied_points; // NOLINT(cata-serialize)
+        // Bounds of the cached occupied points
+        mutable inclusive_cuboid<tripoint> occupied_bounds; // NOLINT(cata-serialize)
 
         // Master list of parts installed in the vehicle.
         std::vector<vehicle_part> parts; // NOLINT(cata-serialize)
@@ -2046,7 +2137,7 @@ class vehicle
          */
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
-        std::map<point, std::vector<int>> relative_parts; // NOLINT(cata-serialize)
+        vehicle_mount_index relative_parts; // NOLINT(cata-serialize)
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -2080,6 +2171,8 @@ class vehicle
         mutable point mount_min; // NOLINT(cata-serialize)
         mutable point mass_center_precalc; // NOLINT(cata-serialize)
         mutable point mass_center_no_precalc; // NOLINT(cata-serialize)
+        // cached network of cable connected vehicles, see power_grid()
+        mutable vehicle_power_grid_cache power_grid_cache; // NOLINT(cata-serialize)
         tripoint autodrive_local_target = tripoint_zero; // current node the autopilot is aiming for
         class autodrive_controller;
         std::shared_ptr<autodrive_controller> active_autodrive_controller; // NOLINT(cata-serialize)
@@ -0,0 +1,86 @@
+#include "vehicle_mount_index.h"
+
+#include <algorithm>
+#include <utility>
+
+// extra cells added on each side when the grid grows, so that adding the parts of a vehicle
+// one by one does not need to rebuild the grid for every new mount point
+static constexpr int grow_margin = 4;
+
+void vehicle_mount_index::clear()
+{
+    for( std::vector<int> &cell : cells ) {
+        cell.clear();
+    }
+}
+
+const std::vector<int> *vehicle_mount_index::find( const point &mount ) const
+{
+    if( !inbounds( mount ) ) {
+        return nullptr;
+    }
+    const point rel = mount - origin;
+    const std::vector<int> &cell = cells[rel.x * size.y + rel.y];
+    return cell.empty() ? nullptr : &cell;
+}
+
+const std::vector<int> &vehicle_mount_index::at( const point &mount ) const
+{
+    static const std::vector<int> no_parts;
+    const std::vector<int> *cell = find( mount );
+    return cell != nullptr ? *cell : no_parts;
+}
+
+std::vector<int> &vehicle_mount_index::operator[]( const point &mount )
+{
+    if( !inbounds( mount ) ) {
+        grow_to( mount );
+    }
+    const point rel = mount - origin;
+    return cells[rel.x * size.y + rel.y];
+}
+
+std::vector<point> vehicle_mount_index::mounts() const
+{
+    std::vector<point> ret;
+    for_each( [&ret]( const point & mount, const std::vector<int> & ) {
+        ret.push_back( mount );
+    } );
+    return ret;
+}
+
+void vehicle_mount_index::grow_to( const point &mount )
+{
+    point new_min = mount;
+    point new_max = mount;
+    if( !cells.empty() ) {
+        new_min = point( std::min( origin.x, mount.x ), std::min( origin.y, mount.y ) );
+        new_max = point( std::max( origin.x + size.x - 1, mount.x ),
+                         std::max( origin.y + size.y - 1, mount.y ) );
+    }
+    // only add the margin on the sides that actually grew
+    if( new_min.x < origin.x || cells.empty() ) {
+        new_min.x -= grow_margin;
+    }
+    if( new_min.y < origin.y || cells.empty() ) {
+        new_min.y -= grow_margin;
+    }
+    if( new_max.x >= origin.x + size.x || cells.empty() ) {
+        new_max.x += grow_margin;
+    }
+    if( new_max.y >= origin.y + size.y || cells.empty() ) {
+        new_max.y += grow_margin;
+    }
+    const point new_size = new_max - new_min + point_south_east;
+
+    std::vector<std::vector<int>> new_cells( static_cast<size_t>( new_size.x ) * new_size.y );
+    for( int x = 0; x < size.x; x++ ) {
+        for( int y = 0; y < size.y; y++ ) {
+            const point rel = origin + point( x, y ) - new_min;
+            new_cells[rel.x * new_size.y + rel.y] = std::move( cells[x * size.y + y] );
+        }
+    }
+    cells = std::move( new_cells );
+    origin = new_min;
+    size = new_size;
+}
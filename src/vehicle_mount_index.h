@@ -0,0 +1,66 @@
+#pragma once
+#ifndef CATA_SRC_VEHICLE_MOUNT_INDEX_H
+#define CATA_SRC_VEHICLE_MOUNT_INDEX_H
+
+#include <vector>
+
+#include "point.h"
+
+/**
+ * Index of vehicle part indices by mount point.
+ *
+ * Stores one cell per mount point of a grid covering the bounding box of all mount points
+ * that were added, so lookups are a bounds check and an array access instead of a tree walk.
+ * The grid grows as needed when parts are added outside of it. Clearing the index keeps the
+ * grid and the capacity of the cells, so rebuilding the index of the same vehicle (which is
+ * what @ref vehicle::refresh does) does not allocate.
+ *
+ * Mount points are visited in the same order as a std::map<point, ...> would visit them.
+ */
+class vehicle_mount_index
+{
+    public:
+        /** Removes all part indices, keeping the grid for reuse. */
+        void clear();
+        /** Whether there are any parts at the given mount point. */
+        bool contains( const point &mount ) const {
+            return find( mount ) != nullptr;
+        }
+        /** Returns the parts at the given mount point, or nullptr if there are none. */
+        const std::vector<int> *find( const point &mount ) const;
+        /** Returns the parts at the given mount point, an empty list if there are none. */
+        const std::vector<int> &at( const point &mount ) const;
+        /** Returns the (possibly empty) parts at the given mount point for modification. */
+        std::vector<int> &operator[]( const point &mount );
+        /** Returns the mount points that have parts, ordered by x, then y. */
+        std::vector<point> mounts() const;
+        /** Calls @p func with each mount point and its parts, ordered by x, then y. */
+        template<typename Func>
+        void for_each( Func func ) const {
+            for( int x = 0; x < size.x; x++ ) {
+                for( int y = 0; y < size.y; y++ ) {
+                    const std::vector<int> &cell = cells[x * size.y + y];
+                    if( !cell.empty() ) {
+                        func( origin + point( x, y ), cell );
+                    }
+                }
+            }
+        }
+
+    private:
+        /** Grows the grid so it covers @p mount. */
+        void grow_to( const point &mount );
+        bool inbounds( const point &mount ) const {
+            const point rel = mount - origin;
+            return rel.x >= 0 && rel.y >= 0 && rel.x < size.x && rel.y < size.y;
+        }
+
+        // mount point of the first cell
+        point origin;
+        // number of cells in x and y direction
+        point size;
+        // part indices of each mount point, column major (x, then y)
+        std::vector<std::vector<int>> cells;
+};
+
+#endif // CATA_SRC_VEHICLE_MOUNT_INDEX_H
@@ -722,6 +722,35 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
     const int sign_before = sgn( velocity_before );
     bool empty = true;
     map &here = get_map();
+
+    // Broad phase: find the bounds swept by the colliding parts during this step, the
+    // per-part checks only need to look for vehicles and characters found within them.
+    inclusive_cuboid<tripoint> swept( tripoint_max, tripoint_min );
+    for( const vehicle_part &vp : parts ) {
+        if( vp.removed || !vp.is_real_or_active_fake() ) {
+            continue;
+        }
+        const vpart_info &info = vp.info();
+        if( !vp.is_fake && info.location != part_location_structure && info.rotor_diameter() == 0 ) {
+            continue;
+        }
+        const int radius = static_cast<int>( std::round( info.rotor_diameter() / 2.0f ) );
+        const tripoint dsp = global_pos3() + dp + vp.precalc[1];
+        swept.p_min = tripoint( std::min( swept.p_min.x, dsp.x - radius ),
+                                std::min( swept.p_min.y, dsp.y - radius ),
+                                std::min( swept.p_min.z, dsp.z ) );
+        swept.p_max = tripoint( std::max( swept.p_max.x, dsp.x + radius ),
+                                std::max( swept.p_max.y, dsp.y + radius ),
+                                std::max( swept.p_max.z, dsp.z ) );
+    }
+    veh_collision_broadphase broadphase;
+    if( swept.p_min.x <= swept.p_max.x ) {
+        const inclusive_cuboid<tripoint_abs_ms> swept_abs( here.getglobal( swept.p_min ),
+                here.getglobal( swept.p_max ) );
+        broadphase.other_vehicles = here.other_vehicle_within( *this, swept );
+        broadphase.characters = get_creature_tracker().character_within( swept_abs, true );
+    }
+
     for( int p = 0; p < part_count(); p++ ) {
         const vehicle_part &vp = parts.at( p );
         if( vp.removed || !vp.is_real_or_active_fake() ) {
@@ -736,11 +765,12 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
         // Coordinates of where part will go due to movement (dx/dy/dz)
         //  and turning (precalc[1])
         const tripoint dsp = global_pos3() + dp + vp.precalc[1];
-        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
+        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor, &broadphase );
         if( coll.type == veh_coll_nothing && info.rotor_diameter() > 0 ) {
             size_t radius = static_cast<size_t>( std::round( info.rotor_diameter() / 2.0f ) );
             for( const tripoint &rotor_point : here.points_in_radius( dsp, radius ) ) {
-                veh_collision rotor_coll = part_collision( p, rotor_point, just_detect, false );
+                veh_collision rotor_coll = part_collision( p, rotor_point, just_detect, false,
+                                           &broadphase );
                 if( rotor_coll.type != veh_coll_nothing ) {
                     coll = rotor_coll;
                     if( just_detect ) {
@@ -813,14 +843,19 @@ static void terrain_collision_data( const tripoint &p, bool bash_floor,
 }
 
 veh_collision vehicle::part_collision( int part, const tripoint &p,
-                                       bool just_detect, bool bash_floor )
+                                       bool just_detect, bool bash_floor,
+                                       const veh_collision_broadphase *broadphase )
 {
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
     Character &player_character = get_player_character();
     const bool pl_ctrl = player_in_control( player_character );
-    Creature *critter = get_creature_tracker().creature_at( p, true );
+    // Without characters nearby only monsters need to be looked up, which skips the NPC scan
+    creature_tracker &creatures = get_creature_tracker();
+    Creature *critter = broadphase != nullptr && !broadphase->characters ?
+                        creatures.creature_at<monster>( p, true ) :
+                        creatures.creature_at( p, true );
     Character *ph = dynamic_cast<Character *>( critter );
 
     Creature *driver = pl_ctrl ? &player_character : nullptr;
@@ -832,7 +867,11 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     }
 
     map &here = get_map();
-    const optional_vpart_position ovp = here.veh_at( p );
+    // Other vehicles can only be hit if the broad phase found any nearby, but the part lookup
+    // is still needed to tell whether a critter is riding this vehicle.
+    const bool check_vehicles = broadphase == nullptr || broadphase->other_vehicles;
+    const optional_vpart_position ovp = check_vehicles || critter != nullptr ? here.veh_at( p ) :
+                                        optional_vpart_position( std::nullopt );
     // Disable vehicle/critter collisions when bashing floor
     // TODO: More elegant code
     const bool is_veh_collision = !bash_floor && ovp && &ovp->vehicle() != this;
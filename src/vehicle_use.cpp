@@ -1602,9 +1602,8 @@ void vehicle::build_bike_rack_menu( veh_menu &menu, int part )
     }
 }
 
-void vpart_position::form_inventory( inventory &inv ) const
+void vpart_position::form_cargo_inventory( inventory &inv ) const
 {
-    const std::optional<vpart_reference> vp_faucet = part_with_tool( itype_water_faucet );
     const std::optional<vpart_reference> vp_cargo = part_with_feature( "CARGO", true );
 
     if( vp_cargo ) {
@@ -1617,6 +1616,11 @@ void vpart_position::form_inventory( inventory &inv ) const
             inv.add_item( it );
         }
     }
+}
+
+void vpart_position::form_tool_inventory( inventory &inv ) const
+{
+    const std::optional<vpart_reference> vp_faucet = part_with_tool( itype_water_faucet );
 
     // HACK: water_faucet pseudo tool gives access to liquids in tanks
     if( vp_faucet && inv.provide_pseudo_item( itype_water_faucet ) != nullptr ) {
@@ -0,0 +1,80 @@
+#include "visibility_matrix.h"
+
+#include "creature.h"
+#include "debug.h"
+#include "item.h"
+#include "messages.h"
+
+void visibility_matrix::reset( const std::vector<const Creature *> &creatures )
+{
+    if( turn.computed + turn.reused > 0 ) {
+        add_msg_debug( debugmode::DF_CREATURE, "Visibility matrix: %d of %d sight checks reused",
+                       turn.reused, turn.reused + turn.computed + turn.untracked );
+    }
+    turn = counters();
+
+    indices.clear();
+    locations.clear();
+    for( const Creature *critter : creatures ) {
+        indices.emplace( critter->get_serial(), static_cast<int>( locations.size() ) );
+        locations.push_back( critter->get_location() );
+    }
+    const size_t bits = locations.size() * locations.size();
+    known.assign( ( bits + 63 ) / 64, 0 );
+    visible.assign( ( bits + 63 ) / 64, 0 );
+}
+
+int visibility_matrix::index_of( const Creature &critter ) const
+{
+    const auto iter = indices.find( critter.get_serial() );
+    if( iter == indices.end() || locations[iter->second] != critter.get_location() ) {
+        return -1;
+    }
+    return iter->second;
+}
+
+bool visibility_matrix::sees( const Creature &viewer, const Creature &target )
+{
+    const int v = index_of( viewer );
+    const int t = index_of( target );
+    if( v < 0 || t < 0 ) {
+        turn.untracked++;
+        total.untracked++;
+        return viewer.sees( target );
+    }
+    const size_t bit = static_cast<size_t>( v ) * locations.size() + t;
+    const size_t word = bit / 64;
+    const uint64_t mask = uint64_t( 1 ) << ( bit % 64 );
+    if( known[word] & mask ) {
+        turn.reused++;
+        total.reused++;
+        return visible[word] & mask;
+    }
+    turn.computed++;
+    total.computed++;
+    const bool result = viewer.sees( target );
+    known[word] |= mask;
+    if( result ) {
+        visible[word] |= mask;
+    } else {
+        visible[word] &= ~mask;
+    }
+    return result;
+}
+
+void visibility_matrix::forget( const Creature &critter )
+{
+    const auto iter = indices.find( critter.get_serial() );
+    if( iter == indices.end() ) {
+        return;
+    }
+    const size_t count = locations.size();
+    const size_t idx = iter->second;
+    for( size_t other = 0; other < count; other++ ) {
+        for( const size_t bit : {
+                 idx * count + other, other * count + idx
+             } ) {
+            known[bit / 64] &= ~( uint64_t( 1 ) << ( bit % 64 ) );
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef CATA_SRC_VISIBILITY_MATRIX_H
+#define CATA_SRC_VISIBILITY_MATRIX_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinates.h"
+
+class Creature;
+
+/**
+ * Which creatures can see which others during the current turn.
+ *
+ * Monster planning and NPC danger assessment ask whether they see the same creatures over and
+ * over again during a turn. This indexes the creatures once per turn (after the map caches have
+ * been built) and remembers the result of each @ref Creature::sees( const Creature & ) check in
+ * a bit matrix, so each viewer/target pair is only checked once per turn.
+ *
+ * A result is only reused while both creatures are still where they were when the matrix was
+ * reset. Creatures that moved or were spawned since then are checked directly. Creatures are
+ * told apart by @ref Creature::get_serial, so a creature that takes the place of a dead one in
+ * memory is not mistaken for it. Gaining or losing an effect makes the results of a creature
+ * be checked again, as effects such as blindness change what it sees and who sees it.
+ */
+class visibility_matrix
+{
+    public:
+        struct counters {
+            // checks answered from the matrix, each one a Creature::sees call saved
+            int64_t reused = 0;
+            // checks that were computed and stored in the matrix
+            int64_t computed = 0;
+            // checks involving creatures that moved or are not in the matrix
+            int64_t untracked = 0;
+        };
+
+        /** Indexes @p creatures at their current locations and forgets all stored results. */
+        void reset( const std::vector<const Creature *> &creatures );
+        /** Same as `viewer.sees( target )`, but computed at most once per turn for each pair. */
+        bool sees( const Creature &viewer, const Creature &target );
+        /** Forgets the stored results of all pairs that include @p critter. */
+        void forget( const Creature &critter );
+
+        /** Counters since the last @ref reset. */
+        const counters &turn_counters() const {
+            return turn;
+        }
+        /** Counters since the game started. */
+        const counters &total_counters() const {
+            return total;
+        }
+
+    private:
+        // index of the creature in the matrix, -1 if it is not in there or moved since reset
+        int index_of( const Creature &critter ) const;
+
+        // indices of the creatures by their serial numbers
+        std::unordered_map<int64_t, int> indices;
+        std::vector<tripoint_abs_ms> locations;
+        // bit (viewer * locations.size() + target) is set if that pair was checked ...
+        std::vector<uint64_t> known;
+        // ... and whether the viewer sees the target
+        std::vector<uint64_t> visible;
+        counters turn;
+        counters total;
+};
+
+#endif // CATA_SRC_VISIBILITY_MATRIX_H
@@ -88,8 +88,11 @@ class vpart_position
         std::optional<vpart_reference> part_with_tool( const itype_id &tool_type ) const;
         // Returns a list of all tools provided by vehicle and their hotkey
         std::vector<std::pair<itype_id, int>> get_tools() const;
-        // Forms inventory for inventory::form_from_map
-        void form_inventory( inventory &inv ) const;
+        // Forms inventory of the cargo items for inventory::form_from_map
+        void form_cargo_inventory( inventory &inv ) const;
+        // Forms inventory of the tools for inventory::form_from_map, their charges come from
+        // the vehicle's tanks and batteries
+        void form_tool_inventory( inventory &inv ) const;
 
         /**
          * Returns the position of this part in the coordinates system that @ref game::m uses.
@@ -35,6 +35,7 @@
 #include "options.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "profiler.h"
 #include "regional_settings.h"
 #include "ret_val.h"
 #include "rng.h"
@@ -442,6 +443,7 @@ double precip_mm_per_hour( precip_class const p )
 
 void handle_weather_effects( const weather_type_id &w )
 {
+    CATA_PROFILE_ZONE( "handle_weather_effects" );
     //Possible TODO, make npc/monsters affected
     map &here = get_map();
     Character &target = get_player_character();
@@ -6,8 +6,10 @@
 #endif
 #include "cursesport.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
+#include <memory>
 
 #include "cached_options.h"
 #include "cursesdef.h"
@@ -58,6 +60,8 @@ bool initialized = false;
 
 static int TERMINAL_WIDTH;
 static int TERMINAL_HEIGHT;
+// The window drawn last, only its changed cells need drawing as nothing has covered it since
+static std::weak_ptr<void> last_drawn_window;
 
 //***********************************
 //Non-curses, Window functions      *
@@ -185,6 +189,7 @@ bool handle_resize( int, int )
         catacurses::stdscr = catacurses::newwin( TERMINAL_HEIGHT, TERMINAL_WIDTH, point_zero );
         catacurses::resizeterm();
         create_backbuffer();
+        last_drawn_window.reset();
         SetBkMode( backbuffer, TRANSPARENT ); //Transparent font backgrounds
         SelectObject( backbuffer, font ); //Load our font into the DC
         color_loader<RGBQUAD>().load( windowsPalette );
@@ -441,13 +446,23 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
     int drawx = 0;
     int drawy = 0;
     wchar_t tmp;
+    const bool screen_intact = last_drawn_window.lock().get() == w.get();
 
     for( j = 0; j < win->height; j++ ) {
-        if( win->line[j].touched ) {
-            win->line[j].touched = false;
+        curseline &line = win->line[j];
+        if( line.touched() ) {
+            int begin = 0;
+            int end = win->width;
+            if( screen_intact ) {
+                // A wide character starting left of the range is drawn again whole
+                begin = line.dirty_begin > 0 && line.chars[line.dirty_begin].ch.empty() ?
+                        line.dirty_begin - 1 : line.dirty_begin;
+                end = std::min( line.dirty_end, win->width );
+            }
+            line.untouch();
 
-            for( i = 0; i < win->width; i++ ) {
-                const cursecell &cell = win->line[j].chars[i];
+            for( i = begin; i < end; i++ ) {
+                const cursecell &cell = line.chars[i];
                 if( cell.ch.empty() ) {
                     // second cell of a multi-cell character
                     continue;
@@ -485,7 +500,7 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                         ExtTextOutW( backbuffer, drawx, drawy, 0, nullptr, utf16.c_str(), utf16.length(), nullptr );
                     }
                 } else {
-                    switch( static_cast<unsigned char>( win->line[j].chars[i].ch[0] ) ) {
+                    switch( static_cast<unsigned char>( cell.ch[0] ) ) {
                         // box bottom/top side (horizontal line)
                         case LINE_OXOX_C:
                             HorzLineDIB( drawx, drawy + halfheight, drawx + fontwidth, 1, FG );
@@ -548,6 +563,7 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
     }// for (j=0;j<win->height;j++)
     // We drew the window, mark it as so
     win->draw = false;
+    last_drawn_window = w.weak_ptr();
 }
 
 // Check for any window messages (keypress, paint, mousemove, etc)
@@ -339,3 +339,20 @@ TEST_CASE( "lcmatch", "[utility]" )
     CHECK( lcmatch( "無効", "無" ) == true );
     CHECK( lcmatch( "無効", "無效" ) == false );
 }
+
+TEST_CASE( "lcmatch_key_matches_like_lcmatch", "[utility]" )
+{
+    const std::vector<std::string> strings = { "bo", "Bo", "Bö", "Bō", "BÖ", "BŌ",
+                                               "«101 борцовский приём»", "無効"
+                                             };
+    const std::vector<std::string> queries = { "bo", "bö", "bō", "co", "при", "прИ", "прб",
+                                               "無", "無效", ""
+                                             };
+    for( const std::string &str : strings ) {
+        const lcmatch_key key( str );
+        for( const std::string &qry : queries ) {
+            CAPTURE( str, qry );
+            CHECK( key.matches( lcmatch_query( qry ) ) == lcmatch( str, qry ) );
+        }
+    }
+}
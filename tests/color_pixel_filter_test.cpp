@@ -0,0 +1,51 @@
+#if defined(TILES)
+
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "sdl_utils.h"
+#include "sdl_wrappers.h"
+
+static bool same_color( const SDL_Color &a, const SDL_Color &b )
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+TEST_CASE( "color_pixel_filter_matches_color_pixel_function", "[tiles]" )
+{
+    const std::string name = GENERATE( "color_pixel_darken", "color_pixel_sepia_light",
+                                       "color_pixel_sepia_dark", "color_pixel_blue_dark", "color_pixel_custom",
+                                       "color_pixel_grayscale", "color_pixel_nightvision", "color_pixel_overexposed" );
+    CAPTURE( name );
+    const color_pixel_function_pointer function = get_color_pixel_function( name );
+    REQUIRE( function );
+    const color_pixel_filter filter( function );
+
+    std::vector<SDL_Color> colors;
+    for( int r = 0; r <= 0xFF; r += 3 ) {
+        for( int g = 0; g <= 0xFF; g += 5 ) {
+            for( int b = 0; b <= 0xFF; b += 7 ) {
+                for( const Uint8 a : {
+                         0x00, 0x80, 0xFF
+                     } ) {
+                    colors.push_back( { static_cast<Uint8>( r ), static_cast<Uint8>( g ),
+                                        static_cast<Uint8>( b ), a } );
+                }
+            }
+        }
+    }
+    std::vector<SDL_Color> filtered = colors;
+    filter.apply( filtered.data(), filtered.size() );
+
+    int mismatches = 0;
+    for( size_t i = 0; i < colors.size(); ++i ) {
+        const SDL_Color expected = colors[i].a == 0x00 ? colors[i] : function( colors[i] );
+        if( !same_color( filtered[i], expected ) ) {
+            ++mismatches;
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+#endif // TILES
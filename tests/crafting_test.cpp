@@ -20,10 +20,12 @@
 #include "game.h"
 #include "inventory.h"
 #include "item.h"
+#include "item_location.h"
 #include "item_pocket.h"
 #include "itype.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_selector.h"
 #include "npc.h"
 #include "pimpl.h"
 #include "player_activity.h"
@@ -2197,3 +2199,89 @@ TEST_CASE( "recipes inherit rot of components properly", "[crafting][rot]" )
         }
     }
 }
+
+TEST_CASE( "crafting_inventory_follows_map_changes", "[crafting][inventory]" )
+{
+    clear_avatar();
+    clear_map();
+    Character &player_character = get_player_character();
+    map &here = get_map();
+    const tripoint near_player = player_character.pos() + tripoint_east;
+
+    here.add_item_or_charges( near_player, item( itype_hammer ) );
+    REQUIRE( player_character.crafting_inventory().amount_of( itype_hammer ) == 1 );
+
+    // the next action sees the same items, and sees changes to the map
+    player_character.mod_moves( -1 );
+    CHECK( player_character.crafting_inventory().amount_of( itype_hammer ) == 1 );
+
+    here.add_item_or_charges( near_player, item( itype_hammer ) );
+    player_character.mod_moves( -1 );
+    CHECK( player_character.crafting_inventory().amount_of( itype_hammer ) == 2 );
+
+    here.i_clear( near_player );
+    player_character.mod_moves( -1 );
+    CHECK( player_character.crafting_inventory().amount_of( itype_hammer ) == 0 );
+
+    // and so do later turns
+    here.add_item_or_charges( near_player, item( itype_chisel ) );
+    calendar::turn += 1_turns;
+    CHECK( player_character.crafting_inventory().amount_of( itype_chisel ) == 1 );
+
+    // items changed in place through an item_location are seen by the next action
+    here.i_clear( near_player );
+    item &thread = here.add_item_or_charges( near_player, item( itype_thread, calendar::turn, 10 ) );
+    player_character.mod_moves( -1 );
+    REQUIRE( player_character.crafting_inventory().charges_of( itype_thread ) == 10 );
+    item_location thread_loc( map_cursor( near_player ), &thread );
+    thread.charges = 5;
+    thread_loc.on_contents_changed();
+    player_character.mod_moves( -1 );
+    CHECK( player_character.crafting_inventory().charges_of( itype_thread ) == 5 );
+}
+
+TEST_CASE( "crafting_gui_open_benchmark", "[.][crafting][inventory][benchmark]" )
+{
+    clear_avatar();
+    clear_map();
+    Character &player_character = get_player_character();
+    map &here = get_map();
+
+    // a packed base: every tile in reach holds a few stacks of tools and materials
+    const std::vector<itype_id> stock {
+        itype_anvil, itype_awl_bone, itype_candle, itype_chisel, itype_hacksaw, itype_hammer,
+        itype_kevlar_shears, itype_pockknife, itype_sewing_kit, itype_sheet_cotton, itype_thread
+    };
+    size_t i = 0;
+    for( const tripoint &p : here.points_in_radius( player_character.pos(), PICKUP_RANGE ) ) {
+        for( int n = 0; n < 8; n++ ) {
+            here.add_item_or_charges( p, item( stock[i++ % stock.size()] ) );
+        }
+    }
+
+    std::vector<const recipe *> recipes;
+    for( const std::pair<const recipe_id, recipe> &e : recipe_dict ) {
+        if( !e.second.is_nested() && recipes.size() < 200 ) {
+            recipes.push_back( &e.second );
+        }
+    }
+    // roughly what opening the crafting menu does, after the player did something else
+    const auto open_crafting_gui = [&]() {
+        player_character.mod_moves( -1 );
+        const inventory &inv = player_character.crafting_inventory();
+        int craftable = 0;
+        for( const recipe *r : recipes ) {
+            craftable += r->deduped_requirements().can_make_with_inventory( inv,
+                         r->get_component_filter(), 1, craft_flags::start_only );
+        }
+        return craftable;
+    };
+
+    BENCHMARK( "open crafting gui" ) {
+        return open_crafting_gui();
+    };
+    BENCHMARK( "open crafting gui after invalidation" ) {
+        player_character.invalidate_crafting_inventory();
+        return open_crafting_gui();
+    };
+}
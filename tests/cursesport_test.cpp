@@ -0,0 +1,69 @@
+#if defined(TILES) || defined(_WIN32)
+
+#include <utility>
+
+#include "cata_catch.h"
+#include "cursesdef.h"
+#include "cursesport.h"
+#include "output.h"
+#include "point.h"
+
+using cata_cursesport::curseline;
+
+static cata_cursesport::WINDOW &get_win( const catacurses::window &w )
+{
+    return *w.get<cata_cursesport::WINDOW>();
+}
+
+static std::pair<int, int> dirty_range( const catacurses::window &w, const int y )
+{
+    const curseline &line = get_win( w ).line[y];
+    if( !line.touched() ) {
+        return { 0, 0 };
+    }
+    return { line.dirty_begin, line.dirty_end };
+}
+
+static void untouch_all( const catacurses::window &w )
+{
+    for( curseline &line : get_win( w ).line ) {
+        line.untouch();
+    }
+}
+
+TEST_CASE( "curses_window_tracks_changed_cells", "[curses]" )
+{
+    const catacurses::window w = catacurses::newwin( 4, 20, point_zero );
+    REQUIRE( w );
+    for( int y = 0; y < 4; y++ ) {
+        CHECK( dirty_range( w, y ) == std::make_pair( 0, 20 ) );
+    }
+    untouch_all( w );
+
+    mvwprintz( w, point( 3, 1 ), c_white, "abc" );
+    CHECK( dirty_range( w, 0 ) == std::make_pair( 0, 0 ) );
+    CHECK( dirty_range( w, 1 ) == std::make_pair( 3, 6 ) );
+    CHECK( dirty_range( w, 2 ) == std::make_pair( 0, 0 ) );
+    mvwprintz( w, point( 10, 1 ), c_white, "x" );
+    CHECK( dirty_range( w, 1 ) == std::make_pair( 3, 11 ) );
+
+    // Writing into the second half of a wide character erases the first half too
+    mvwprintz( w, point( 5, 2 ), c_white, "漢" );
+    CHECK( dirty_range( w, 2 ) == std::make_pair( 5, 7 ) );
+    untouch_all( w );
+    mvwprintz( w, point( 6, 2 ), c_white, "a" );
+    CHECK( dirty_range( w, 2 ) == std::make_pair( 5, 7 ) );
+
+    // Text running off the end of a line continues on the next one
+    untouch_all( w );
+    mvwprintz( w, point( 18, 0 ), c_white, "abcd" );
+    CHECK( dirty_range( w, 0 ) == std::make_pair( 18, 20 ) );
+    CHECK( dirty_range( w, 1 ) == std::make_pair( 0, 2 ) );
+
+    werase( w );
+    for( int y = 0; y < 4; y++ ) {
+        CHECK( dirty_range( w, y ) == std::make_pair( 0, 20 ) );
+    }
+}
+
+#endif
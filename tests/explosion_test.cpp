@@ -0,0 +1,143 @@
+#include <cstddef>
+#include <vector>
+
+#include "cata_catch.h"
+#include "explosion.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+
+static void detonate( const tripoint &p, float power, float factor )
+{
+    explosion_handler::explosion( nullptr, p, power, factor );
+    explosion_handler::process_explosions();
+}
+
+static void wall_in( const tripoint &p )
+{
+    map &here = get_map();
+    for( const tripoint &wall : here.points_in_radius( p, 1 ) ) {
+        if( wall != p ) {
+            REQUIRE( here.ter_set( wall, t_rock ) );
+        }
+    }
+}
+
+TEST_CASE( "blast_is_stopped_by_walls", "[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    const tripoint center( 30, 30, 0 );
+    const tripoint in_the_open = center + point_east * 2;
+    const tripoint walled_in = center + point_south * 8;
+    wall_in( walled_in );
+    monster &exposed = spawn_test_monster( "mon_zombie", in_the_open );
+    monster &sheltered = spawn_test_monster( "mon_zombie", walled_in );
+    const int exposed_hp = exposed.get_hp();
+    const int sheltered_hp = sheltered.get_hp();
+
+    // Twice, so the second blast runs on the scratch space left by the first one
+    for( int i = 0; i < 2; i++ ) {
+        detonate( center, 300.0f, 0.8f );
+    }
+
+    CHECK( exposed.get_hp() < exposed_hp );
+    CHECK( sheltered.get_hp() == sheltered_hp );
+    for( const tripoint &wall : here.points_in_radius( walled_in, 1 ) ) {
+        if( wall != walled_in ) {
+            CHECK( here.ter( wall ) == t_rock );
+        }
+    }
+}
+
+TEST_CASE( "simultaneous_explosions_benchmark", "[.][explosion][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    // A grid of explosives going off at once, like a cooked off ammo dump
+    std::vector<tripoint> explosives;
+    for( int x = 20; x < 110; x += 10 ) {
+        for( int y = 20; y < 110; y += 10 ) {
+            explosives.emplace_back( x, y, 0 );
+        }
+    }
+
+    BENCHMARK( "81 simultaneous blasts" ) {
+        for( const tripoint &p : explosives ) {
+            explosion_handler::explosion( nullptr, p, 200.0f, 0.8f );
+        }
+        explosion_handler::process_explosions();
+        return explosives.size();
+    };
+}
+
+TEST_CASE( "burning_ammo_depot", "[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    const tripoint depot( 60, 60, 0 );
+    monster &guard = spawn_test_monster( "mon_zombie", depot + point_east * 5 );
+    const tripoint bunker = depot + point_west * 20;
+    wall_in( bunker );
+    monster &bystander = spawn_test_monster( "mon_zombie", bunker );
+    const int bystander_hp = bystander.get_hp();
+
+    // A stack of crates cooking off all at once
+    for( const tripoint &crate : here.points_in_radius( depot, 2 ) ) {
+        explosion_handler::explosion( nullptr, crate, 100.0f, 0.8f, false, 100, 0.08f );
+    }
+    // They go off together, not as each is set off
+    REQUIRE( explosion_handler::_explosions.size() == 25 );
+    explosion_handler::process_explosions();
+
+    CHECK( guard.is_dead_state() );
+    CHECK( bystander.get_hp() == bystander_hp );
+}
+
+TEST_CASE( "blasts_of_a_batch_add_up", "[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    const tripoint crate( 60, 60, 0 );
+    monster &target = spawn_test_monster( "mon_zombie", crate + point_east );
+    const int target_hp = target.get_hp();
+    // The force at the center is a fifteenth of the power, one tile away it is 0.8 of that.
+    // That is just enough to spread, but too weak to do anything on the next tile.
+    const float power = 1.1f * 15.0f;
+    const size_t crates = 10;
+
+    SECTION( "one by one" ) {
+        for( size_t i = 0; i < crates; i++ ) {
+            detonate( crate, power, 0.8f );
+        }
+        CHECK( target.get_hp() == target_hp );
+    }
+    SECTION( "in one batch" ) {
+        for( size_t i = 0; i < crates; i++ ) {
+            explosion_handler::explosion( nullptr, crate, power, 0.8f );
+        }
+        REQUIRE( explosion_handler::_explosions.size() == crates );
+        explosion_handler::process_explosions();
+        // The blasts on the same tile add up and hit the target once
+        CHECK( target.get_hp() < target_hp );
+    }
+}
+
+TEST_CASE( "shrapnel_benchmark", "[.][explosion][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    const tripoint center( 60, 60, 0 );
+
+    // A distance factor of 0 skips the blast, so this times the fragments and the sound only
+    BENCHMARK( "grenade fragments" ) {
+        explosion_handler::explosion( nullptr, center, 185.0f, 0.0f, false, 210, 0.15f );
+        explosion_handler::process_explosions();
+        return center.x;
+    };
+    BENCHMARK( "firecracker fragments" ) {
+        explosion_handler::explosion( nullptr, center, 2.0f, 0.0f, false, 1, 0.15f );
+        explosion_handler::process_explosions();
+        return center.x;
+    };
+}
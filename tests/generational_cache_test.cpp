@@ -0,0 +1,123 @@
+#include <vector>
+
+#include "cata_catch.h"
+#include "generational_cache.h"
+#include "lru_cache.h"
+#include "point.h"
+#include "rng.h"
+
+TEST_CASE( "generational_cache_basics", "[generational_cache]" )
+{
+    generational_cache<point, char> cache( 4 );
+    CHECK( cache.capacity() == 16 );
+    CHECK( cache.get( point_zero, -1 ) == -1 );
+
+    cache.insert( point( 1, 2 ), 1 );
+    cache.insert( point( 3, 4 ), 0 );
+    CHECK( cache.get( point( 1, 2 ), -1 ) == 1 );
+    CHECK( cache.get( point( 3, 4 ), -1 ) == 0 );
+    CHECK( cache.get( point( 2, 1 ), -1 ) == -1 );
+
+    cache.insert( point( 1, 2 ), 0 );
+    CHECK( cache.get( point( 1, 2 ), -1 ) == 0 );
+
+    cache.clear();
+    CHECK( cache.get( point( 1, 2 ), -1 ) == -1 );
+    CHECK( cache.get( point( 3, 4 ), -1 ) == -1 );
+}
+
+TEST_CASE( "generational_cache_overfull", "[generational_cache]" )
+{
+    // more keys than slots: lookups may miss, but must never return another key's value
+    generational_cache<point, char> cache( 4 );
+    for( int i = 0; i < 100; i++ ) {
+        cache.insert( point( i, -i ), static_cast<char>( i % 2 ) );
+    }
+    int found = 0;
+    for( int i = 0; i < 100; i++ ) {
+        const char value = cache.get( point( i, -i ), -1 );
+        if( value >= 0 ) {
+            CHECK( value == i % 2 );
+            found++;
+        }
+    }
+    CHECK( found > 0 );
+    CHECK( found <= 16 );
+}
+
+// Keys as map::sees packs them: pairs of points that see each other.
+static point sees_key( const point &a, const point &b )
+{
+    return point( a.x << 16 | a.y << 8, b.x << 16 | b.y << 8 );
+}
+
+// A big fight: many creatures repeatedly check whether they see each other,
+// the caches get cleared every turn as things move around.
+static std::vector<std::vector<point>> big_fight_queries()
+{
+    std::vector<point> creatures;
+    for( int i = 0; i < 300; i++ ) {
+        creatures.emplace_back( rng( 0, 131 ), rng( 0, 131 ) );
+    }
+    std::vector<std::vector<point>> turns( 10 );
+    for( std::vector<point> &queries : turns ) {
+        for( int i = 0; i < 20000; i++ ) {
+            // a few creatures (the player, their allies) are involved in most queries
+            const point &from = creatures[rng( 0, 9 )];
+            const point &to = creatures[rng( 0, static_cast<int>( creatures.size() ) - 1 )];
+            queries.push_back( sees_key( from, to ) );
+        }
+        for( point &p : creatures ) {
+            p += point( rng( -1, 1 ), rng( -1, 1 ) );
+        }
+    }
+    return turns;
+}
+
+TEST_CASE( "generational_cache_benchmark", "[.][generational_cache][benchmark]" )
+{
+    const std::vector<std::vector<point>> turns = big_fight_queries();
+
+    lru_cache<point, char> lru;
+    generational_cache<point, char> generational( 17 );
+    const auto run_lru = [&]() {
+        int hits = 0;
+        for( const std::vector<point> &queries : turns ) {
+            lru.clear();
+            for( const point &key : queries ) {
+                if( lru.get( key, -1 ) >= 0 ) {
+                    hits++;
+                } else {
+                    lru.insert( 100000, key, 1 );
+                }
+            }
+        }
+        return hits;
+    };
+    const auto run_generational = [&]() {
+        int hits = 0;
+        for( const std::vector<point> &queries : turns ) {
+            generational.clear();
+            for( const point &key : queries ) {
+                if( generational.get( key, -1 ) >= 0 ) {
+                    hits++;
+                } else {
+                    generational.insert( key, 1 );
+                }
+            }
+        }
+        return hits;
+    };
+
+    const int queries = static_cast<int>( turns.size() * turns.front().size() );
+    WARN( "lru_cache hit rate: " << static_cast<double>( run_lru() ) / queries );
+    WARN( "generational_cache hit rate: " <<
+          static_cast<double>( run_generational() ) / queries );
+
+    BENCHMARK( "lru_cache" ) {
+        return run_lru();
+    };
+    BENCHMARK( "generational_cache" ) {
+        return run_generational();
+    };
+}
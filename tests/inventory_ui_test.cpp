@@ -0,0 +1,107 @@
+#include <cstddef>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "inventory_ui.h"
+#include "item.h"
+#include "item_factory.h"
+#include "item_location.h"
+#include "itype.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_selector.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "type_id.h"
+
+static const itype_id itype_jeans( "jeans" );
+static const itype_id itype_tshirt( "tshirt" );
+
+static item_location add_map_item( const tripoint &pos, const itype_id &type )
+{
+    return item_location( map_cursor( pos ), &get_map().add_item( pos, item( type ) ) );
+}
+
+static std::vector<inventory_entry *> shown_entries( const inventory_column &column )
+{
+    return column.get_entries( []( const inventory_entry & ) {
+        return true;
+    } );
+}
+
+TEST_CASE( "inventory_column_stacks_and_collates_map_items", "[inventory]" )
+{
+    clear_map();
+    const tripoint pos_a( 60, 60, 0 );
+    const tripoint pos_b( 61, 60, 0 );
+    std::vector<item_location> locations;
+    for( int i = 0; i < 3; i++ ) {
+        locations.push_back( add_map_item( pos_a, itype_jeans ) );
+    }
+    locations.push_back( add_map_item( pos_a, itype_tshirt ) );
+    locations.push_back( add_map_item( pos_b, itype_jeans ) );
+
+    inventory_column column;
+    for( const item_location &loc : locations ) {
+        REQUIRE( column.add_entry( inventory_entry( { loc } ) ) != nullptr );
+    }
+    // Items only stack with items in the same place
+    std::vector<inventory_entry *> entries = shown_entries( column );
+    REQUIRE( entries.size() == 3 );
+    CHECK( entries[0]->locations.size() == 3 );
+    CHECK( entries[1]->any_item()->typeId() == itype_tshirt );
+    CHECK( entries[2]->any_item().position() == pos_b );
+
+    // Collation gathers the stacks of the same type from everywhere
+    column.collate();
+    entries = shown_entries( column );
+    REQUIRE( entries.size() == 2 );
+    CHECK( entries[0]->is_collation_header() );
+    CHECK( entries[0]->locations.size() == 4 );
+    CHECK( entries[1]->any_item()->typeId() == itype_tshirt );
+}
+
+namespace
+{
+class open_test_selector : public inventory_selector
+{
+    public:
+        explicit open_test_selector( Character &u ) : inventory_selector( u ) {}
+        using inventory_selector::get_all_columns;
+};
+} // namespace
+
+TEST_CASE( "inventory_open_benchmark", "[.][inventory][benchmark]" )
+{
+    clear_avatar();
+    clear_map();
+    avatar &u = get_avatar();
+    // A storage room full of clothes, 20k of them on the squares around the player
+    std::vector<itype_id> clothes;
+    for( const itype *type : item_controller->all() ) {
+        if( type->armor && !type->count_by_charges() ) {
+            clothes.push_back( type->get_id() );
+        }
+    }
+    REQUIRE( !clothes.empty() );
+    const tripoint center = u.pos();
+    for( size_t i = 0; i < 20000; i++ ) {
+        const tripoint pos = center + point( static_cast<int>( i % 3 ) - 1,
+                                             static_cast<int>( i / 3 % 3 ) - 1 );
+        get_map().add_item( pos, item( clothes[i % clothes.size()] ) );
+    }
+
+    BENCHMARK( "open" ) {
+        open_test_selector inv_s( u );
+        inv_s.add_nearby_items( 1 );
+        size_t width = 0;
+        for( inventory_column *column : inv_s.get_all_columns() ) {
+            column->set_height( 40 );
+            column->prepare_paging();
+            column->reset_width( inv_s.get_all_columns() );
+            width += column->get_width();
+        }
+        return width;
+    };
+}
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "item.h"
+#include "item_factory.h"
+#include "item_search.h"
+#include "output.h"
+
+TEST_CASE( "filter_narrows", "[item][filter]" )
+{
+    CHECK( filter_narrows( "ha", "ham" ) );
+    CHECK( filter_narrows( "ham", "ham" ) );
+    CHECK( filter_narrows( "c:", "c:fo" ) );
+    CHECK( filter_narrows( "m:st", "m:steel" ) );
+    CHECK( filter_narrows( "q:ham", "q:hammer" ) );
+
+    CHECK_FALSE( filter_narrows( "", "ham" ) );
+    CHECK_FALSE( filter_narrows( "ham", "ha" ) );
+    CHECK_FALSE( filter_narrows( "ham", "jam" ) );
+    // Excluding more shows more
+    CHECK_FALSE( filter_narrows( "-ha", "-ham" ) );
+    CHECK_FALSE( filter_narrows( "ham", "ham,saw" ) );
+    CHECK_FALSE( filter_narrows( "ham", "ham{" ) );
+    // A flag typed after the name turns the whole query into something else
+    CHECK_FALSE( filter_narrows( "c", "c:" ) );
+    CHECK_FALSE( filter_narrows( "b:ham", "b:ham;steel" ) );
+}
+
+TEST_CASE( "split_basic_item_filter", "[item][filter]" )
+{
+    CHECK( split_basic_item_filter( "hammer" ) == std::make_pair( '\0', std::string( "hammer" ) ) );
+    CHECK( split_basic_item_filter( "c:food" ) == std::make_pair( 'c', std::string( "food" ) ) );
+    CHECK( split_basic_item_filter( ":x" ) == std::make_pair( '\0', std::string( ":x" ) ) );
+}
+
+TEST_CASE( "item_filter_benchmark", "[.][item][filter][benchmark]" )
+{
+    // A well stocked base: every item type, over and over
+    std::vector<item> items;
+    const std::vector<const itype *> types = item_controller->all();
+    while( items.size() < 10000 ) {
+        for( const itype *type : types ) {
+            items.emplace_back( type, calendar::turn_zero, item::solitary_tag{} );
+        }
+    }
+    items.resize( 10000 );
+    // Typed one key at a time, each key filters the items again
+    const std::vector<std::string> typed = { "s", "st", "ste", "stee", "steel" };
+
+    const auto with_item_filter = [&]() {
+        size_t shown = 0;
+        for( const std::string &filter : typed ) {
+            const auto filter_fn = item_filter_from_string( filter );
+            for( const item &it : items ) {
+                shown += filter_fn( it ) ? 1 : 0;
+            }
+        }
+        return shown;
+    };
+    // What the inventory selector does: the names are prepared once, and only the items that
+    // matched the previous filter can match the one that extends it.
+    const auto with_search_keys = [&]() {
+        std::vector<lcmatch_key> keys;
+        keys.reserve( items.size() );
+        for( const item &it : items ) {
+            keys.emplace_back( remove_color_tags( it.tname() ) );
+        }
+        std::vector<const lcmatch_key *> matching;
+        for( const lcmatch_key &key : keys ) {
+            matching.push_back( &key );
+        }
+        size_t shown = 0;
+        for( const std::string &filter : typed ) {
+            const std::u32string lc_qry = lcmatch_query( filter );
+            std::vector<const lcmatch_key *> still_matching;
+            for( const lcmatch_key *key : matching ) {
+                if( key->matches( lc_qry ) ) {
+                    still_matching.push_back( key );
+                }
+            }
+            matching = std::move( still_matching );
+            shown += matching.size();
+        }
+        return shown;
+    };
+    CHECK( with_search_keys() == with_item_filter() );
+
+    BENCHMARK( "item filter" ) {
+        return with_item_filter();
+    };
+    BENCHMARK( "search keys" ) {
+        return with_search_keys();
+    };
+}
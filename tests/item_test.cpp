@@ -5,12 +5,14 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "avatar.h"
 #include "calendar.h"
 #include "enums.h"
 #include "flag.h"
+#include "flag_bitset.h"
 #include "game.h"
 #include "item_factory.h"
 #include "item_pocket.h"
@@ -26,9 +28,14 @@
 #include "value_ptr.h"
 
 static const flag_id json_flag_COLD( "COLD" );
+static const flag_id json_flag_CONDUCTIVE( "CONDUCTIVE" );
 static const flag_id json_flag_FILTHY( "FILTHY" );
 static const flag_id json_flag_FIX_NEARSIGHT( "FIX_NEARSIGHT" );
+static const flag_id json_flag_FRAGILE( "FRAGILE" );
 static const flag_id json_flag_HOT( "HOT" );
+static const flag_id json_flag_NO_DROP( "NO_DROP" );
+static const flag_id json_flag_WATERPROOF( "WATERPROOF" );
+static const flag_id json_flag_ZERO_WEIGHT( "ZERO_WEIGHT" );
 
 static const item_category_id item_category_container( "container" );
 static const item_category_id item_category_food( "food" );
@@ -902,3 +909,69 @@ TEST_CASE( "item_single_type_contents", "[item]" )
     REQUIRE( bag.put_in( nail, item_pocket::pocket_type::CONTAINER ).success() );
     CHECK( bag.get_category_of_contents().id == item_category_container );
 }
+
+TEST_CASE( "item_flag_bits_match_flag_sets", "[item][flag]" )
+{
+    // dense flag bits must give the same answers as the sets of flag ids
+    int mismatches = 0;
+    for( const itype *type : item_controller->all() ) {
+        for( const json_flag &f : json_flag::get_all() ) {
+            if( type->has_flag( f.id ) != ( type->get_flags().count( f.id ) > 0 ) ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+
+    REQUIRE( flag_dense_index( json_flag_FILTHY ) >= 0 );
+    CHECK( flag_dense_index( flag_id( "not_a_real_flag" ) ) == -1 );
+
+    item backpack( itype_test_backpack );
+    const std::set<flag_id> hot_or_filthy { json_flag_HOT, json_flag_FILTHY };
+    REQUIRE_FALSE( backpack.has_flag( json_flag_FILTHY ) );
+    CHECK_FALSE( backpack.has_any_flag( hot_or_filthy ) );
+
+    backpack.set_flag( json_flag_FILTHY );
+    CHECK( backpack.has_own_flag( json_flag_FILTHY ) );
+    CHECK( backpack.has_flag( json_flag_FILTHY ) );
+    CHECK( backpack.has_any_flag( hot_or_filthy ) );
+    CHECK_FALSE( backpack.has_any_flag( std::set<flag_id> { json_flag_HOT, json_flag_COLD } ) );
+
+    backpack.unset_flag( json_flag_FILTHY );
+    CHECK_FALSE( backpack.has_flag( json_flag_FILTHY ) );
+
+    backpack.set_flag( json_flag_HOT );
+    backpack.unset_flags();
+    CHECK_FALSE( backpack.has_any_flag( hot_or_filthy ) );
+}
+
+TEST_CASE( "item_has_flag_benchmark", "[.][item][flag][benchmark]" )
+{
+    // one of every item type makes for a large and varied inventory
+    std::vector<item> inventory;
+    for( const itype *type : item_controller->all() ) {
+        inventory.emplace_back( type, calendar::turn_zero, item::solitary_tag {} );
+    }
+    const std::vector<flag_id> probes {
+        json_flag_CONDUCTIVE, json_flag_FILTHY, json_flag_FRAGILE, json_flag_NO_DROP,
+        json_flag_WATERPROOF, json_flag_ZERO_WEIGHT
+    };
+    const std::set<flag_id> any_probe( probes.begin(), probes.end() );
+
+    BENCHMARK( "has_flag" ) {
+        int found = 0;
+        for( const item &it : inventory ) {
+            for( const flag_id &f : probes ) {
+                found += it.has_flag( f );
+            }
+        }
+        return found;
+    };
+    BENCHMARK( "has_any_flag" ) {
+        int found = 0;
+        for( const item &it : inventory ) {
+            found += it.has_any_flag( any_probe );
+        }
+        return found;
+    };
+}
@@ -11,6 +11,7 @@
 #include "cata_assert.h"
 #include "character.h"
 #include "clzones.h"
+#include "explosion.h"
 #include "faction.h"
 #include "field.h"
 #include "game.h"
@@ -95,6 +96,7 @@ void clear_fields( const int zlevel )
             if( sm ) {
                 sm->field_count = 0;
                 sm->get_field( offset ).clear();
+                sm->fires_changed();
             }
         }
     }
@@ -130,6 +132,8 @@ void clear_map( int zmin, int zmax )
     clear_npcs();
     clear_creatures();
     here.clear_traps();
+    // Explosions a previous test queued and never set off
+    explosion_handler::_explosions.clear();
     for( int z = zmin; z <= zmax; ++z ) {
         clear_items( z );
     }
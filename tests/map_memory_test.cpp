@@ -1,14 +1,17 @@
 #include <bitset>
 #include <cstdio>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
 #include "cata_catch.h"
 #include "game_constants.h"
 #include "json.h"
+#include "json_loader.h"
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
+#include "memory_fast.h"
 #include "point.h"
 
 static constexpr tripoint p1{ -SEEX - 2, -SEEY - 3, -1 };
@@ -40,7 +43,7 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
     memory.prepare_region( p1, p2 );
     CHECK( memory.get_symbol( p1 ) == 0 );
     memorized_terrain_tile default_tile = memory.get_tile( p1 );
-    CHECK( default_tile.tile.empty() );
+    CHECK( default_tile.tile().empty() );
     CHECK( default_tile.subtile == 0 );
     CHECK( default_tile.rotation == 0 );
 }
@@ -73,7 +76,122 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+static std::string serialize_region( const mm_region &region )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    region.serialize( jsout );
+    return os.str();
+}
+
+static mm_region deserialize_region( const std::string &json )
+{
+    mm_region region;
+    region.deserialize( json_loader::from_string( json ) );
+    return region;
+}
+
+// A region as explored by a character that has seen a lot: every tile memorized, with a
+// few hundred distinct tiles.
+static mm_region explored_region( int seed )
+{
+    mm_region region;
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            shared_ptr_fast<mm_submap> &sm = region.submaps[x][y];
+            sm = make_shared_fast<mm_submap>();
+            for( int sy = 0; sy < SEEY; sy++ ) {
+                for( int sx = 0; sx < SEEX; sx++ ) {
+                    const int variant = ( seed + x * 7 + y * 13 + sx * sy ) % 300;
+                    sm->set_tile( point( sx, sy ), memorized_terrain_tile(
+                                      "t_explored_terrain_" + std::to_string( variant ),
+                                      variant % 6, ( variant % 4 ) * 90 ) );
+                    sm->set_symbol( point( sx, sy ), 'a' + variant % 26 );
+                }
+            }
+        }
+    }
+    return region;
+}
+
+static void check_same_region( const mm_region &a, const mm_region &b )
+{
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            for( int sy = 0; sy < SEEY; sy++ ) {
+                for( int sx = 0; sx < SEEX; sx++ ) {
+                    const point p( sx, sy );
+                    CAPTURE( x, y, sx, sy );
+                    CHECK( a.submaps[x][y]->tile( p ) == b.submaps[x][y]->tile( p ) );
+                    CHECK( a.submaps[x][y]->symbol( p ) == b.submaps[x][y]->symbol( p ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "map_memory_region_save_load", "[map_memory]" )
+{
+    const mm_region region = explored_region( 3 );
+    const mm_region loaded = deserialize_region( serialize_region( region ) );
+    check_same_region( region, loaded );
+    CHECK( loaded.submaps[0][0]->tile( point_zero ).tile() == "t_explored_terrain_3" );
+}
+
+TEST_CASE( "map_memory_loads_regions_with_tile_names", "[map_memory]" )
+{
+    // Saved before the names were listed once per region
+    std::string json = "[";
+    for( size_t i = 0; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+        json += i == 0 ? R"([["t_floor",0,0,46,2],["f_chair",1,90,35,)" +
+                std::to_string( SEEX * SEEY - 2 ) + "]]" : ",null";
+    }
+    json += "]";
+    const mm_region loaded = deserialize_region( json );
+    const mm_submap &sm = *loaded.submaps[0][0];
+    CHECK( sm.tile( point_zero ) == memorized_terrain_tile( "t_floor", 0, 0 ) );
+    CHECK( sm.tile( point_east ) == memorized_terrain_tile( "t_floor", 0, 0 ) );
+    CHECK( sm.tile( point( 2, 0 ) ) == memorized_terrain_tile( "f_chair", 1, 90 ) );
+    CHECK( sm.symbol( point( SEEX - 1, SEEY - 1 ) ) == 35 );
+    CHECK( loaded.submaps[1][0]->is_empty() );
+    // And it is saved the new way, with the same tiles
+    check_same_region( loaded, deserialize_region( serialize_region( loaded ) ) );
+}
+
+TEST_CASE( "map_memory_save_load_benchmark", "[.][map_memory][benchmark]" )
+{
+    // Enough regions for a character that explored a few cities
+    std::vector<mm_region> regions;
+    for( int i = 0; i < 64; i++ ) {
+        regions.push_back( explored_region( i ) );
+    }
+    std::vector<std::string> saved;
+    for( const mm_region &region : regions ) {
+        saved.push_back( serialize_region( region ) );
+    }
+    size_t saved_size = 0;
+    for( const std::string &json : saved ) {
+        saved_size += json.size();
+    }
+    const size_t tiles = regions.size() * MM_REG_SIZE * MM_REG_SIZE * SEEX * SEEY;
+    WARN( tiles << " memorized tiles take " << tiles * sizeof( memorized_terrain_tile ) / 1024 <<
+          " KiB in memory and " << saved_size / 1024 << " KiB saved" );
+
+    BENCHMARK( "save" ) {
+        size_t size = 0;
+        for( const mm_region &region : regions ) {
+            size += serialize_region( region ).size();
+        }
+        return size;
+    };
+    BENCHMARK( "load" ) {
+        size_t loaded = 0;
+        for( const std::string &json : saved ) {
+            loaded += deserialize_region( json ).is_empty() ? 0 : 1;
+        }
+        return loaded;
+    };
+}
 
 #include <chrono>
 
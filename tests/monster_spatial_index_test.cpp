@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monfaction.h"
+#include "monster.h"
+#include "mtype.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+
+static const mfaction_str_id monfaction_player( "player" );
+
+static const std::vector<std::string> mixed_monster_types = {
+    "mon_zombie", "mon_zombie_dog", "mon_pig", "mon_deer", "mon_bear", "mon_turkey",
+    "mon_manhack", "mon_wolf_mutant_huge"
+};
+
+// spawns monsters of the given types on free tiles around the avatar, some of them friendly
+static std::vector<monster *> spawn_monsters( const std::vector<std::string> &types, int count,
+        int radius, bool some_friendly )
+{
+    map &here = get_map();
+    const tripoint center = get_avatar().pos();
+    std::vector<monster *> spawned;
+    const int max_tries = count * 10;
+    for( int tries = 0; static_cast<int>( spawned.size() ) < count && tries < max_tries; tries++ ) {
+        const tripoint p = center + tripoint( rng( -radius, radius ), rng( -radius, radius ), 0 );
+        if( !here.inbounds( p ) || get_creature_tracker().creature_at( p ) ) {
+            continue;
+        }
+        monster &mon = spawn_test_monster( random_entry( types ), p );
+        if( some_friendly && one_in( 5 ) ) {
+            mon.friendly = -1;
+        }
+        spawned.push_back( &mon );
+    }
+    return spawned;
+}
+
+// spawns monsters of mixed factions on free tiles around the avatar
+static std::vector<monster *> spawn_mixed_monsters( int count, int radius )
+{
+    std::vector<monster *> spawned = spawn_monsters( mixed_monster_types, count, radius, true );
+    get_creature_tracker().refresh_monster_factions();
+    return spawned;
+}
+
+// what monster::plan did before the index: look at all monsters
+static std::vector<monster *> hostile_monsters_by_scan( const mfaction_id &faction,
+        const tripoint_abs_ms &center, int radius )
+{
+    std::vector<monster *> result;
+    for( monster &mon : g->all_monsters() ) {
+        const tripoint_abs_ms loc = mon.get_location();
+        if( ( radius >= 0 && ( std::abs( loc.x() - center.x() ) > radius ||
+                               std::abs( loc.y() - center.y() ) > radius ) ) ||
+            loc.z() != center.z() ) {
+            continue;
+        }
+        const mfaction_id other = mon.friendly == 0 ? mon.faction : monfaction_player.id();
+        const mf_attitude att = faction.obj().attitude( other );
+        if( att != MFA_NEUTRAL && att != MFA_FRIENDLY ) {
+            result.push_back( &mon );
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+TEST_CASE( "hostile_monsters_near_matches_scan", "[monster][creature_tracker]" )
+{
+    clear_avatar();
+    clear_map();
+    const std::vector<monster *> spawned = spawn_mixed_monsters( 60, 40 );
+    REQUIRE( spawned.size() > 10 );
+
+    creature_tracker &creatures = get_creature_tracker();
+    std::bitset<OVERMAP_LAYERS> levels;
+    levels.set( get_avatar().posz() + OVERMAP_DEPTH );
+    // without a radius, the monsters are found by their faction
+    const std::vector<int> radii = { 3, 16, 40, -1 };
+    const auto check_all = [&]() {
+        for( const monster *viewer : spawned ) {
+            for( const int radius : radii ) {
+                CAPTURE( viewer->type->id.str(), radius );
+                std::vector<monster *> found = creatures.hostile_monsters_near( viewer->faction,
+                                               viewer->get_location(), radius, levels );
+                std::sort( found.begin(), found.end() );
+                CHECK( found == hostile_monsters_by_scan( viewer->faction, viewer->get_location(),
+                        radius ) );
+            }
+        }
+    };
+    check_all();
+
+    // the index follows monsters that move
+    for( monster *mon : spawned ) {
+        const tripoint dest = mon->pos() + tripoint( rng( -15, 15 ), rng( -15, 15 ), 0 );
+        if( get_map().inbounds( dest ) && !creatures.creature_at( dest ) ) {
+            mon->setpos( dest );
+        }
+    }
+    check_all();
+
+    // and ones that become friendly, once the factions are refreshed
+    for( monster *mon : spawned ) {
+        if( mon->friendly == 0 && one_in( 4 ) ) {
+            mon->friendly = -1;
+        }
+    }
+    creatures.refresh_monster_factions();
+    check_all();
+
+    // and ones that die
+    for( monster *mon : spawned ) {
+        if( one_in( 2 ) ) {
+            mon->die( nullptr );
+        }
+    }
+    check_all();
+}
+
+TEST_CASE( "monster_plan_benchmark", "[.][monster][creature_tracker][benchmark]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    const std::vector<monster *> spawned = spawn_mixed_monsters( 500, 60 );
+    get_map().build_map_cache( get_avatar().posz() );
+    get_creature_tracker().reset_visibility();
+
+    BENCHMARK( "plan 500 mixed faction monsters" ) {
+        for( monster *mon : spawned ) {
+            mon->plan();
+        }
+        return spawned.size();
+    };
+
+    std::bitset<OVERMAP_LAYERS> levels;
+    levels.set( get_avatar().posz() + OVERMAP_DEPTH );
+    const creature_tracker &creatures = get_creature_tracker();
+    BENCHMARK( "hostile_monsters_near" ) {
+        size_t found = 0;
+        for( const monster *mon : spawned ) {
+            found += creatures.hostile_monsters_near( mon->faction, mon->get_location(),
+                     mon->type->vision_day, levels ).size();
+        }
+        return found;
+    };
+    BENCHMARK( "scan all monsters" ) {
+        size_t found = 0;
+        for( const monster *mon : spawned ) {
+            found += hostile_monsters_by_scan( mon->faction, mon->get_location(),
+                                               mon->type->vision_day ).size();
+        }
+        return found;
+    };
+}
+
+TEST_CASE( "monster_plan_horde_benchmark", "[.][monster][creature_tracker][benchmark]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    // a horde of a single faction, none of which are targets of each other
+    const std::vector<monster *> spawned = spawn_monsters( { "mon_zombie" }, 500, 60, false );
+    get_map().build_map_cache( get_avatar().posz() );
+    get_creature_tracker().reset_visibility();
+    get_creature_tracker().refresh_monster_factions();
+
+    BENCHMARK( "plan 500 monsters of a horde" ) {
+        for( monster *mon : spawned ) {
+            mon->plan();
+        }
+        return spawned.size();
+    };
+}
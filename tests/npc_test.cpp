@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
@@ -16,11 +18,13 @@
 #include "field.h"
 #include "field_type.h"
 #include "game.h"
+#include "item.h"
 #include "line.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "memory_fast.h"
 #include "npc.h"
+#include "npc_ai_blackboard.h"
 #include "npc_class.h"
 #include "overmapbuffer.h"
 #include "pimpl.h"
@@ -35,9 +39,13 @@
 
 class Creature;
 
+static const activity_id ACT_WAIT( "ACT_WAIT" );
+
 static const efftype_id effect_bouldering( "bouldering" );
 static const efftype_id effect_sleep( "sleep" );
 
+static const itype_id itype_rock( "rock" );
+
 static const trait_id trait_WEB_WEAVER( "WEB_WEAVER" );
 
 static const vpart_id vpart_frame( "frame" );
@@ -459,3 +467,94 @@ TEST_CASE( "npc_can_target_player" )
     REQUIRE( hostile.current_target() != nullptr );
     CHECK( hostile.current_target() == static_cast<Creature *>( &player_character ) );
 }
+
+TEST_CASE( "npc_ai_blackboard_follows_world_changes", "[npc]" )
+{
+    clear_map();
+    clear_npcs();
+    g->place_player( tripoint_zero );
+    map &here = get_map();
+    npc_ai_blackboard &blackboard = get_npc_ai_blackboard();
+    const tripoint spot = get_player_character().pos() + tripoint( 3, 0, 0 );
+
+    SECTION( "items" ) {
+        CHECK( blackboard.item_count( spot ) == 0 );
+        here.add_item_or_charges( spot, item( itype_rock ) );
+        CHECK( blackboard.item_count( spot ) == 1 );
+        here.add_item_or_charges( spot, item( itype_rock ) );
+        CHECK( blackboard.item_count( spot ) == 2 );
+    }
+
+    SECTION( "fires" ) {
+        blackboard.invalidate();
+        CHECK( blackboard.fires_on_level( spot.z ).empty() );
+        here.add_field( spot, fd_fire, 1 );
+        // fires are collected once per turn
+        blackboard.invalidate();
+        const std::vector<tripoint_abs_ms> &fires = blackboard.fires_on_level( spot.z );
+        REQUIRE( fires.size() == 1 );
+        CHECK( fires.front() == here.getglobal( spot ) );
+        // the submap looks for its fires again once one is put out
+        here.remove_field( spot, fd_fire );
+        blackboard.invalidate();
+        CHECK( blackboard.fires_on_level( spot.z ).empty() );
+    }
+
+    SECTION( "followers" ) {
+        npc &guy = spawn_npc( spot.xy(), "test_talker" );
+        const auto is_follower = [&]() {
+            const std::vector<npc *> &followers = blackboard.followers();
+            return std::find( followers.begin(), followers.end(), &guy ) != followers.end();
+        };
+        CHECK_FALSE( is_follower() );
+        g->add_npc_follower( guy.getID() );
+        CHECK( is_follower() );
+        g->remove_npc_follower( guy.getID() );
+        CHECK_FALSE( is_follower() );
+    }
+}
+
+TEST_CASE( "npc_ai_budget", "[npc]" )
+{
+    clear_map();
+    clear_npcs();
+    g->place_player( tripoint_zero );
+    npc_ai_blackboard &blackboard = get_npc_ai_blackboard();
+    const tripoint near_player = get_player_character().pos() + tripoint_east;
+    npc &guy = spawn_npc( near_player.xy(), "test_talker" );
+    guy.set_attitude( NPCATT_NULL );
+
+    SECTION( "budget" ) {
+        blackboard.start_ai_turn( std::chrono::microseconds( 0 ) );
+        blackboard.record_ai_time( guy, std::chrono::microseconds( 100000 ) );
+        CHECK_FALSE( blackboard.ai_over_budget() );
+
+        blackboard.start_ai_turn( std::chrono::microseconds( 100 ) );
+        blackboard.record_ai_time( guy, std::chrono::microseconds( 60 ) );
+        CHECK_FALSE( blackboard.ai_over_budget() );
+        blackboard.record_ai_time( guy, std::chrono::microseconds( 60 ) );
+        CHECK( blackboard.ai_over_budget() );
+
+        blackboard.record_deferred_ai( guy );
+        blackboard.report_ai_time();
+        CHECK( blackboard.deferred_ai_count() == 1 );
+        CHECK( blackboard.ai_time( guy ) == std::chrono::microseconds( 120 ) );
+    }
+
+    SECTION( "NPCs near the player always think" ) {
+        CHECK( guy.ai_is_urgent() );
+    }
+
+    SECTION( "there is no plan to reuse before the AI ran" ) {
+        const int moves = guy.get_moves();
+        CHECK_FALSE( guy.reuse_last_plan() );
+        CHECK( guy.get_moves() == moves );
+    }
+
+    SECTION( "NPCs with a new activity think again" ) {
+        guy.setpos( near_player + tripoint( 3 * SEEX, 0, 0 ) );
+        REQUIRE_FALSE( guy.ai_is_urgent() );
+        guy.assign_activity( ACT_WAIT );
+        CHECK( guy.ai_is_urgent() );
+    }
+}
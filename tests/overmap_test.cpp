@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "all_enum_values.h"
@@ -65,6 +67,40 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "seen_terrain_search_follows_seen_and_terrain_changes", "[overmap]" )
+{
+    std::unique_ptr<overmap> test_overmap = std::make_unique<overmap>( point_abs_om() );
+    const std::string term = oter_cabin.id()->get_name();
+    const oter_id &default_terrain = test_overmap->ter( tripoint_om_omt( 10, 10, 0 ) );
+    REQUIRE( default_terrain->get_name() != term );
+    const std::vector<tripoint_om_omt> cabins = {
+        { 10, 10, 0 }, { 20, 30, 0 }, { 100, 150, 0 }, { 40, 40, 0 }
+    };
+    for( const tripoint_om_omt &p : cabins ) {
+        test_overmap->ter_set( p, oter_cabin.id() );
+    }
+    for( size_t i = 0; i < 3; i++ ) {
+        test_overmap->set_seen( cabins[i], true );
+    }
+    const auto found = [&]() {
+        std::vector<point_abs_omt> indexed = test_overmap->find_seen_terrain( term, 0 );
+        std::vector<point_abs_omt> scanned = test_overmap->find_terrain( term, 0 );
+        std::sort( indexed.begin(), indexed.end() );
+        std::sort( scanned.begin(), scanned.end() );
+        CHECK( indexed == scanned );
+        return indexed.size();
+    };
+    CHECK( found() == 3 );
+    CHECK( test_overmap->find_seen_terrain( term, 1 ).empty() );
+
+    test_overmap->set_seen( cabins[3], true );
+    CHECK( found() == 4 );
+    test_overmap->ter_set( cabins[0], default_terrain );
+    CHECK( found() == 3 );
+    test_overmap->set_seen( cabins[1], false );
+    CHECK( found() == 2 );
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     int overmaps_to_construct = 10;
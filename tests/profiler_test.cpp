@@ -0,0 +1,58 @@
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "profiler.h"
+
+TEST_CASE( "profiler_exports_nested_zones", "[profiler]" )
+{
+    profiler::clear();
+    {
+        profiler::zone outer( "outer" );
+        profiler::zone inner( std::string( "inner" ) );
+    }
+    if( !profiler::compiled_in() ) {
+        CHECK( profiler::recorded_zones() == 0 );
+        return;
+    }
+    REQUIRE( profiler::recorded_zones() == 2 );
+
+    const std::string path = "profiler_test_trace.json";
+    REQUIRE( profiler::export_chrome_trace( path ) );
+    std::string trace;
+    REQUIRE( read_from_file( path, [&trace]( std::istream & fin ) {
+        trace.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    } ) );
+    remove_file( path );
+
+    JsonObject jo = json_loader::from_string( trace ).get_object();
+    jo.allow_omitted_members();
+    const JsonArray events = jo.get_array( "traceEvents" );
+    REQUIRE( events.size() == 2 );
+    JsonObject outer = events.get_object( 0 );
+    JsonObject inner = events.get_object( 1 );
+    outer.allow_omitted_members();
+    inner.allow_omitted_members();
+    CHECK( outer.get_string( "name" ) == "outer" );
+    CHECK( inner.get_string( "name" ) == "inner" );
+    CHECK( outer.get_string( "ph" ) == "X" );
+    // Nested by time, that's how the trace viewer knows which zone is the parent
+    const auto ns = []( const double us ) {
+        return std::llround( us * 1000 );
+    };
+    const int64_t outer_start = ns( outer.get_float( "ts" ) );
+    const int64_t inner_start = ns( inner.get_float( "ts" ) );
+    const int64_t outer_end = outer_start + ns( outer.get_float( "dur" ) );
+    const int64_t inner_end = inner_start + ns( inner.get_float( "dur" ) );
+    CHECK( outer_start <= inner_start );
+    CHECK( inner_end <= outer_end );
+    CHECK( outer.get_int( "tid" ) == inner.get_int( "tid" ) );
+    profiler::clear();
+}
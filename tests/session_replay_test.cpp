@@ -0,0 +1,112 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "input.h"
+#include "json.h"
+#include "json_loader.h"
+#include "main_menu.h"
+#include "path_info.h"
+#include "point.h"
+#include "session_replay.h"
+
+static input_event round_trip( const input_event &evt )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    session_replay::serialize( evt, jsout );
+    return session_replay::deserialize_input_event( json_loader::from_string(
+                os.str() ).get_object() );
+}
+
+TEST_CASE( "recorded_input_events_replay_unchanged", "[session_replay]" )
+{
+    SECTION( "key press with modifiers" ) {
+        input_event evt( 'a', input_event_t::keyboard_code );
+        evt.modifiers.insert( keymod_t::ctrl );
+        evt.modifiers.insert( keymod_t::shift );
+        const input_event replayed = round_trip( evt );
+        CHECK( replayed == evt );
+        CHECK( replayed.modifiers == evt.modifiers );
+    }
+    SECTION( "mouse click" ) {
+        input_event evt( MouseInput::LeftButtonReleased, input_event_t::mouse );
+        evt.mouse_pos = point( 12, -3 );
+        const input_event replayed = round_trip( evt );
+        CHECK( replayed == evt );
+        CHECK( replayed.mouse_pos == evt.mouse_pos );
+    }
+    SECTION( "text input" ) {
+        input_event evt;
+        evt.type = input_event_t::keyboard_char;
+        evt.text = "é";
+        evt.edit = "ab";
+        evt.edit_refresh = true;
+        const input_event replayed = round_trip( evt );
+        CHECK( replayed.type == evt.type );
+        CHECK( replayed.text == evt.text );
+        CHECK( replayed.edit == evt.edit );
+        CHECK( replayed.edit_refresh );
+    }
+}
+
+TEST_CASE( "recorded_session_replays_its_input", "[session_replay]" )
+{
+    const std::string path = PATH_INFO::user_dir() + "replay_test.jsonl";
+    const std::string replay_world = PATH_INFO::savedir() + "replay test replay";
+    std::vector<input_event> recorded;
+    recorded.emplace_back( 'w', input_event_t::keyboard_char );
+    recorded.emplace_back( '.', input_event_t::keyboard_char );
+    recorded.emplace_back( MouseInput::LeftButtonReleased, input_event_t::mouse );
+    REQUIRE( assure_dir_exist( PATH_INFO::savedir() ) );
+    REQUIRE( assure_dir_exist( path + ".save" ) );
+    write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "world", "replay test" );
+        jsout.member( "save", get_avatar().get_save_id() );
+        jsout.member( "seed", 42 );
+        jsout.end_object();
+        fout << '\n';
+        for( const input_event &evt : recorded ) {
+            JsonOut evt_out( fout );
+            session_replay::serialize( evt, evt_out );
+            fout << '\n';
+        }
+    } );
+
+    REQUIRE( session_replay::replay_from( path ) );
+    CHECK( main_menu::queued_world_to_load == "replay test replay" );
+    CHECK( dir_exist( replay_world ) );
+    session_replay::begin_session();
+    REQUIRE( session_replay::is_replaying() );
+    for( const input_event &evt : recorded ) {
+        CHECK( session_replay::get_input_event( keyboard_mode::keycode ) == evt );
+        session_replay::end_turn();
+    }
+    CHECK_THROWS_AS( session_replay::get_input_event( keyboard_mode::keycode ),
+                     session_replay::replay_finished );
+    session_replay::end_session();
+
+    CHECK_FALSE( session_replay::is_replaying() );
+    CHECK_FALSE( dir_exist( replay_world ) );
+    int timing_lines = 0;
+    read_from_file( path + ".timings.csv", [&]( std::istream & fin ) {
+        std::string line;
+        while( std::getline( fin, line ) ) {
+            timing_lines++;
+        }
+    } );
+    // The header and one line per turn
+    CHECK( timing_lines == 1 + static_cast<int>( recorded.size() ) );
+
+    main_menu::queued_world_to_load.clear();
+    main_menu::queued_save_id_to_load.clear();
+    remove_directory( path + ".save" );
+    remove_file( path );
+    remove_file( path + ".timings.csv" );
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdint>
 #include <optional>
 
 #include "cata_catch.h"
@@ -5,6 +7,7 @@
 
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
+#include "game_constants.h"
 #include "line.h"
 #include "point.h"
 
@@ -137,3 +140,181 @@ TEST_CASE( "find_overmap_path_bridge", "[pathfinding]" )
     CHECK( pth.points[0] == Point( 2, 0, 0 ) );
 }
 
+
+// A travel graph over the OMTs scored by estimate, all its sectors are at revision.
+static pf::omt_travel_graph make_travel_graph( const pf::omt_scoring_fn &estimate,
+        const uint64_t &revision )
+{
+    return pf::omt_travel_graph( [&revision]( const tripoint_abs_omt & ) {
+        return revision;
+    }, [estimate]( const tripoint_abs_omt & origin, pf::omt_travel_graph::sector_costs & costs ) {
+        constexpr int size = pf::omt_travel_graph::sector_size;
+        for( int y = 0; y < size; y++ ) {
+            for( int x = 0; x < size; x++ ) {
+                const pf::omt_score score = estimate( origin + point( x, y ) );
+                costs.cost[y * size + x] = score.node_cost;
+                costs.allow_z_change[y * size + x] = score.allow_z_change;
+            }
+        }
+    } );
+}
+
+TEST_CASE( "omt_travel_graph_u_bend", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    const Point start( 0, 0, 0 );
+    const Point finish( 2, 0, 0 );
+    const inclusive_cuboid<Point> bounds( start, Point( 2, 2, 0 ) );
+    // Same as find_overmap_path_u_bend
+
+    const pf::omt_scoring_fn estimate = [&]( Point cur ) {
+        if( !bounds.contains( cur ) || ( cur.x() == 1 && cur.y() != 2 ) ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( 10, false );
+    };
+
+    const uint64_t revision = 1;
+    pf::omt_travel_graph graph = make_travel_graph( estimate, revision );
+    const pf::simple_path<Point> pth = graph.find_path( start, finish, 2, noop_fn );
+    REQUIRE( pth.points.size() == 7 );
+    CHECK( pth.points[6] == Point( 0, 0, 0 ) );
+    CHECK( pth.points[5] == Point( 0, 1, 0 ) );
+    CHECK( pth.points[4] == Point( 0, 2, 0 ) );
+    CHECK( pth.points[3] == Point( 1, 2, 0 ) );
+    CHECK( pth.points[2] == Point( 2, 2, 0 ) );
+    CHECK( pth.points[1] == Point( 2, 1, 0 ) );
+    CHECK( pth.points[0] == Point( 2, 0, 0 ) );
+}
+
+TEST_CASE( "omt_travel_graph_bridge", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    const Point start( 0, 0, 0 );
+    const Point finish( 2, 0, 0 );
+    const inclusive_cuboid<Point> bounds( start, Point( 2, 2, 1 ) );
+    // Same as find_overmap_path_bridge
+
+    const pf::omt_scoring_fn estimate = [&]( Point cur ) {
+        if( !bounds.contains( cur ) || ( cur.x() == 1 && cur.z() == 0 ) ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( 10, ( cur.y() == 1 && cur.x() != 1 ) );
+    };
+
+    const uint64_t revision = 1;
+    pf::omt_travel_graph graph = make_travel_graph( estimate, revision );
+    const pf::simple_path<Point> pth = graph.find_path( start, finish, 2, noop_fn );
+    REQUIRE( pth.points.size() == 7 );
+    CHECK( pth.points[6] == Point( 0, 0, 0 ) );
+    CHECK( pth.points[5] == Point( 0, 1, 0 ) );
+    CHECK( pth.points[4] == Point( 0, 1, 1 ) );
+    CHECK( pth.points[3] == Point( 1, 1, 1 ) );
+    CHECK( pth.points[2] == Point( 2, 1, 1 ) );
+    CHECK( pth.points[1] == Point( 2, 1, 0 ) );
+    CHECK( pth.points[0] == Point( 2, 0, 0 ) );
+}
+
+TEST_CASE( "omt_travel_graph_cuts_corners", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    const Point start( 0, 0, 0 );
+    const Point finish( 4, 4, 0 );
+    const inclusive_cuboid<Point> bounds( start, finish );
+    // Turning in an OMT costs less than going straight through it, as in find_overmap_path, so
+    // the cheapest path across an open field is a staircase
+
+    const pf::omt_scoring_fn estimate = [&]( Point cur ) {
+        return bounds.contains( cur ) ? pf::omt_score( 10 ) : pf::omt_score::rejected;
+    };
+
+    const uint64_t revision = 1;
+    pf::omt_travel_graph graph = make_travel_graph( estimate, revision );
+    const pf::simple_path<Point> pth = graph.find_path( start, finish, 8, noop_fn );
+    REQUIRE( pth.points.size() == 9 );
+    for( size_t i = 1; i + 1 < pth.points.size(); i++ ) {
+        CHECK( pth.points[i - 1] - pth.points[i] != pth.points[i] - pth.points[i + 1] );
+    }
+}
+
+TEST_CASE( "omt_travel_graph_follows_revisions", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    // A wall along x = 30, across several sectors, with a single gap that moves
+    int gap_y = 5;
+    const pf::omt_scoring_fn estimate = [&]( Point cur ) {
+        if( cur.z() != 0 || cur.x() < 0 || cur.y() < 0 || cur.x() >= 60 || cur.y() >= 60 ||
+            ( cur.x() == 30 && cur.y() != gap_y ) ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( 10, false );
+    };
+    const Point start( 10, 30, 0 );
+    const Point finish( 50, 30, 0 );
+
+    uint64_t revision = 1;
+    pf::omt_travel_graph graph = make_travel_graph( estimate, revision );
+    const auto through_gap = [&]( const pf::simple_path<Point> &pth ) {
+        return std::find( pth.points.begin(), pth.points.end(), Point( 30, gap_y, 0 ) ) !=
+               pth.points.end();
+    };
+    const pf::simple_path<Point> before = graph.find_path( start, finish, OMAPX, noop_fn );
+    REQUIRE( !before.points.empty() );
+    CHECK( before.points.front() == finish );
+    CHECK( before.points.back() == start );
+    CHECK( through_gap( before ) );
+
+    // Same revision, the graph doesn't look at the terrain again
+    gap_y = 55;
+    CHECK( graph.find_path( start, finish, OMAPX, noop_fn ).points == before.points );
+
+    revision++;
+    const pf::simple_path<Point> after = graph.find_path( start, finish, OMAPX, noop_fn );
+    REQUIRE( !after.points.empty() );
+    CHECK( through_gap( after ) );
+    for( size_t i = 1; i < after.points.size(); i++ ) {
+        CHECK( manhattan_dist( after.points[i - 1].xy(), after.points[i].xy() ) == 1 );
+    }
+
+    gap_y = -1;
+    revision++;
+    CHECK( graph.find_path( start, finish, OMAPX, noop_fn ).points.empty() );
+}
+
+// Fields and forests crossed by roads every 12 OMTs, with a few impassable OMTs.
+static pf::omt_score synthetic_terrain( const tripoint_abs_omt &p )
+{
+    if( p.z() != 0 ) {
+        return pf::omt_score::rejected;
+    }
+    if( p.x() % 12 == 0 || p.y() % 12 == 0 ) {
+        return pf::omt_score( 10 );
+    }
+    const uint32_t hash = static_cast<uint32_t>( p.x() ) * 73856093u ^
+                          static_cast<uint32_t>( p.y() ) * 19349663u;
+    const uint32_t kind = ( hash >> 8 ) % 10;
+    return kind < 2 ? pf::omt_score::rejected : pf::omt_score( kind < 6 ? 15 : 30 );
+}
+
+TEST_CASE( "overmap_travel_benchmark", "[.][pathfinding][benchmark]" )
+{
+    // From a road of one overmap to a road of one 10 overmaps away, as auto-travel would
+    const tripoint_abs_omt start( 96, 96, 0 );
+    const tripoint_abs_omt finish( 10 * OMAPX + 96, 2 * OMAPY + 96, 0 );
+    const pf::omt_scoring_fn estimate = synthetic_terrain;
+    const int radius = 12 * OMAPX;
+    const uint64_t revision = 1;
+    pf::omt_travel_graph warm = make_travel_graph( estimate, revision );
+    WARN( warm.find_path( start, finish, radius, noop_fn ).points.size() << " OMTs of path" );
+
+    BENCHMARK( "find_overmap_path" ) {
+        return pf::find_overmap_path( start, finish, radius, estimate, noop_fn ).points.size();
+    };
+    BENCHMARK( "travel graph, built for the search" ) {
+        pf::omt_travel_graph cold = make_travel_graph( estimate, revision );
+        return cold.find_path( start, finish, radius, noop_fn ).points.size();
+    };
+    BENCHMARK( "travel graph, built before" ) {
+        return warm.find_path( start, finish, radius, noop_fn ).points.size();
+    };
+}
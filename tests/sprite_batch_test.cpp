@@ -0,0 +1,122 @@
+#if defined(TILES)
+
+#include <array>
+#include <vector>
+
+#include "cata_catch.h"
+#include "point.h"
+#include "rng.h"
+#include "sdl_geometry.h"
+#include "sdl_wrappers.h"
+
+namespace
+{
+
+// The software renderer draws into a surface, no window or video driver is needed.
+struct software_target {
+    SDL_Surface_Ptr surface;
+    SDL_Renderer_Ptr renderer;
+    SDL_Texture_Ptr atlas;
+
+    explicit software_target( const int size ) {
+        surface.reset( SDL_CreateRGBSurfaceWithFormat( 0, size, size, 32,
+                       SDL_PIXELFORMAT_ARGB8888 ) );
+        REQUIRE( surface );
+        renderer.reset( SDL_CreateSoftwareRenderer( surface.get() ) );
+        REQUIRE( renderer );
+        // A 16x16 sprite with a color in each quadrant, the rest of the 256x256 atlas is gray
+        SDL_Surface_Ptr sprites( SDL_CreateRGBSurfaceWithFormat( 0, 256, 256, 32,
+                                 SDL_PIXELFORMAT_ARGB8888 ) );
+        REQUIRE( sprites );
+        const SDL_PixelFormat *fmt = sprites->format;
+        FillRect( sprites, nullptr, SDL_MapRGB( fmt, 128, 128, 128 ) );
+        const std::array<SDL_Rect, 4> quadrants = {{
+                { 0, 0, 8, 8 }, { 8, 0, 8, 8 }, { 0, 8, 8, 8 }, { 8, 8, 8, 8 }
+            }
+        };
+        FillRect( sprites, &quadrants[0], SDL_MapRGB( fmt, 255, 0, 0 ) );
+        FillRect( sprites, &quadrants[1], SDL_MapRGB( fmt, 0, 255, 0 ) );
+        FillRect( sprites, &quadrants[2], SDL_MapRGB( fmt, 0, 0, 255 ) );
+        FillRect( sprites, &quadrants[3], SDL_MapRGB( fmt, 255, 255, 255 ) );
+        atlas = CreateTextureFromSurface( renderer, sprites );
+        REQUIRE( atlas );
+    }
+
+    Uint32 pixel( const point &p ) const {
+        Uint32 value = 0;
+        const SDL_Rect rect = { p.x, p.y, 1, 1 };
+        REQUIRE( SDL_RenderReadPixels( renderer.get(), &rect, SDL_PIXELFORMAT_ARGB8888, &value,
+                                       sizeof( value ) ) == 0 );
+        return value;
+    }
+
+    // Colors at the middle of the quadrants of a 64x64 sprite drawn at the origin
+    std::array<Uint32, 4> quadrant_colors() const {
+        return {{
+                pixel( point( 16, 16 ) ), pixel( point( 48, 16 ) ),
+                pixel( point( 16, 48 ) ), pixel( point( 48, 48 ) )
+            }
+        };
+    }
+};
+
+} // namespace
+
+TEST_CASE( "sprite_batch_draws_like_render_copy", "[tiles]" )
+{
+    software_target copied( 64 );
+    software_target batched( 64 );
+    const SDL_Rect src = { 0, 0, 16, 16 };
+    const SDL_Rect dest = { 0, 0, 64, 64 };
+    const double angle = GENERATE( 0.0, 90.0, -90.0 );
+    const SDL_RendererFlip flip = GENERATE( SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL,
+                                            static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL |
+                                                    SDL_FLIP_VERTICAL ) );
+    CAPTURE( angle, static_cast<int>( flip ) );
+
+    REQUIRE( SDL_RenderCopyEx( copied.renderer.get(), copied.atlas.get(), &src, &dest, angle,
+                               nullptr, flip ) == 0 );
+    SpriteBatch batch;
+    batch.add( batched.renderer, batched.atlas.get(), src, dest, angle, flip );
+    batch.flush( batched.renderer );
+
+    CHECK( batched.quadrant_colors() == copied.quadrant_colors() );
+}
+
+TEST_CASE( "sprite_batch_benchmark", "[.][tiles][benchmark]" )
+{
+    // A zoomed out view of a dense city: a few layers of 8x8 sprites over a 1024x1024 screen
+    software_target target( 1024 );
+    struct sprite {
+        SDL_Rect src;
+        SDL_Rect dest;
+    };
+    std::vector<sprite> frame;
+    for( int layer = 0; layer < 3; layer++ ) {
+        for( int y = 0; y < 1024; y += 8 ) {
+            for( int x = 0; x < 1024; x += 8 ) {
+                const SDL_Rect src = { rng( 0, 15 ) * 16, rng( 0, 15 ) * 16, 16, 16 };
+                frame.push_back( { src, { x, y, 8, 8 } } );
+            }
+        }
+    }
+    WARN( frame.size() << " sprites per frame" );
+
+    BENCHMARK( "render copy" ) {
+        for( const sprite &s : frame ) {
+            SDL_RenderCopyEx( target.renderer.get(), target.atlas.get(), &s.src, &s.dest, 0,
+                              nullptr, SDL_FLIP_NONE );
+        }
+        return SDL_RenderFlush( target.renderer.get() );
+    };
+    SpriteBatch batch;
+    BENCHMARK( "sprite batch" ) {
+        for( const sprite &s : frame ) {
+            batch.add( target.renderer, target.atlas.get(), s.src, s.dest, 0, SDL_FLIP_NONE );
+        }
+        batch.flush( target.renderer );
+        return SDL_RenderFlush( target.renderer.get() );
+    };
+}
+
+#endif // TILES
@@ -0,0 +1,108 @@
+#if defined(TILES)
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_tiles.h"
+#include "item.h"
+#include "mapdata.h"
+#include "type_id.h"
+
+static std::optional<tile_lookup_res> find_terrain_tile( const tileset &ts, const std::string &id,
+        const season_type season, const int jumps )
+{
+    if( id.empty() || jumps <= 0 ) {
+        return std::nullopt;
+    }
+    std::optional<tile_lookup_res> res = ts.find_tile_type_by_season( id, season );
+    if( res ) {
+        return res;
+    }
+    const ter_str_id tid( id );
+    if( !tid.is_valid() ) {
+        return std::nullopt;
+    }
+    return find_terrain_tile( ts, tid->looks_like, season, jumps - 1 );
+}
+
+TEST_CASE( "tile_lookup_table_maps_ids_to_handles", "[tiles]" )
+{
+    tileset ts;
+    ts.create_tile_type( "t_dirt", tile_type() );
+    ts.create_tile_type( "t_dirt_season_winter", tile_type() );
+
+    tile_lookup_table table;
+    const tile_lookup_table::handle dirt = table.add( "t_dirt" );
+    const tile_lookup_table::handle grass = table.add( "t_grass" );
+    CHECK( dirt != grass );
+    CHECK( table.add( "t_dirt" ) == dirt );
+    CHECK( table.find( "t_grass" ) == grass );
+    CHECK( table.find( "t_floor" ) == tile_lookup_table::no_handle );
+    CHECK( table.size() == 2 );
+
+    for( int i = 0; i < NUM_SEASONS; i++ ) {
+        const season_type season = static_cast<season_type>( i );
+        table.set( dirt, season, ts.find_tile_type_by_season( "t_dirt", season ) );
+    }
+    std::optional<tile_lookup_res> spring = table.get( dirt, SPRING );
+    std::optional<tile_lookup_res> winter = table.get( dirt, WINTER );
+    REQUIRE( spring );
+    REQUIRE( winter );
+    CHECK( spring->id() == "t_dirt" );
+    CHECK( winter->id() == "t_dirt_season_winter" );
+    CHECK_FALSE( table.get( grass, SPRING ) );
+
+    table.clear();
+    CHECK( table.find( "t_dirt" ) == tile_lookup_table::no_handle );
+}
+
+TEST_CASE( "tile_lookup_benchmark", "[.][tiles][benchmark]" )
+{
+    // A tileset with sprites for half of the terrain, the rest is drawn through looks_like
+    // or not at all.
+    tileset ts;
+    std::vector<std::string> ids;
+    for( size_t i = 0; i < ter_t::count(); i++ ) {
+        const std::string &id = ter_id( i ).id().str();
+        ids.push_back( id );
+        if( i % 2 == 0 ) {
+            ts.create_tile_type( id, tile_type() );
+        }
+    }
+    tile_lookup_table table;
+    for( const std::string &id : ids ) {
+        const tile_lookup_table::handle h = table.add( id );
+        for( int i = 0; i < NUM_SEASONS; i++ ) {
+            const season_type season = static_cast<season_type>( i );
+            table.set( h, season, find_terrain_tile( ts, id, season, 10 ) );
+        }
+    }
+
+    BENCHMARK( "looks_like chain" ) {
+        int found = 0;
+        for( const std::string &id : ids ) {
+            found += find_terrain_tile( ts, id, SUMMER, 10 ) ? 1 : 0;
+        }
+        return found;
+    };
+    BENCHMARK( "resolved handles" ) {
+        int found = 0;
+        for( const std::string &id : ids ) {
+            found += table.get( table.find( id ), SUMMER ) ? 1 : 0;
+        }
+        return found;
+    };
+    // How the map is drawn: the terrain was added in the order of its int ids
+    BENCHMARK( "int ids" ) {
+        int found = 0;
+        for( size_t i = 0; i < ids.size(); i++ ) {
+            found += table.get( static_cast<tile_lookup_table::handle>( i ), SUMMER ) ? 1 : 0;
+        }
+        return found;
+    };
+}
+
+#endif // TILES
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "map.h"
+#include "point.h"
+#include "type_id.h"
+#include "veh_type.h"
+#include "vehicle.h"
+#include "vehicle_mount_index.h"
+
+TEST_CASE( "vehicle_mount_index_basics", "[vehicle][mount_index]" )
+{
+    vehicle_mount_index index;
+    CHECK_FALSE( index.contains( point_zero ) );
+    CHECK( index.at( point_zero ).empty() );
+
+    index[point( 2, -1 )].push_back( 3 );
+    index[point( -5, 4 )].push_back( 1 );
+    index[point( 2, -3 )].push_back( 7 );
+    index[point( 2, -3 )].push_back( 8 );
+
+    CHECK( index.contains( point( 2, -1 ) ) );
+    CHECK( index.contains( point( -5, 4 ) ) );
+    CHECK_FALSE( index.contains( point( 2, -2 ) ) );
+    CHECK_FALSE( index.contains( point( 100, 100 ) ) );
+    REQUIRE( index.find( point( 2, -3 ) ) != nullptr );
+    CHECK( *index.find( point( 2, -3 ) ) == std::vector<int> { 7, 8 } );
+
+    // mounts are visited in the same order as by a std::map<point, ...>
+    const std::vector<point> expected { point( -5, 4 ), point( 2, -3 ), point( 2, -1 ) };
+    CHECK( index.mounts() == expected );
+
+    index.clear();
+    CHECK( index.mounts().empty() );
+    CHECK_FALSE( index.contains( point( 2, -1 ) ) );
+}
+
+// returns the prototypes with the most parts, biggest first
+static std::vector<vproto_id> biggest_vehicle_prototypes( size_t count )
+{
+    std::vector<std::pair<int, vproto_id>> sized;
+    for( const vproto_id &id : vehicle_prototype::get_all() ) {
+        if( id->blueprint ) {
+            sized.emplace_back( id->blueprint->part_count(), id );
+        }
+    }
+    std::sort( sized.begin(), sized.end(), []( const std::pair<int, vproto_id> &lhs,
+    const std::pair<int, vproto_id> &rhs ) {
+        return lhs.first > rhs.first;
+    } );
+    std::vector<vproto_id> ret;
+    for( size_t i = 0; i < std::min( count, sized.size() ); i++ ) {
+        ret.push_back( sized[i].second );
+    }
+    return ret;
+}
+
+TEST_CASE( "vehicle_mount_index_matches_parts", "[vehicle][mount_index]" )
+{
+    for( const vproto_id &id : biggest_vehicle_prototypes( 5 ) ) {
+        CAPTURE( id.str() );
+        vehicle veh( get_map(), id );
+        std::map<point, std::vector<int>> expected;
+        for( const vpart_reference &vp : veh.get_all_parts() ) {
+            expected[vp.mount()].push_back( static_cast<int>( vp.part_index() ) );
+        }
+        for( const std::pair<const point, std::vector<int>> &mount : expected ) {
+            std::vector<int> cached = veh.parts_at_relative( mount.first, true );
+            std::sort( cached.begin(), cached.end() );
+            CHECK( cached == mount.second );
+        }
+    }
+}
+
+TEST_CASE( "vehicle_mount_index_benchmark", "[.][vehicle][mount_index][benchmark]" )
+{
+    for( const vproto_id &id : biggest_vehicle_prototypes( 3 ) ) {
+        vehicle veh( get_map(), id );
+        std::vector<point> mounts;
+        for( const vpart_reference &vp : veh.get_all_parts() ) {
+            mounts.push_back( vp.mount() );
+        }
+        // include lookups that miss
+        mounts.emplace_back( 1000, 1000 );
+        size_t i = 0;
+
+        BENCHMARK( "parts_at_relative " + id.str() ) {
+            return veh.parts_at_relative( mounts[i++ % mounts.size()], true ).size();
+        };
+        BENCHMARK( "part_with_feature " + id.str() ) {
+            return veh.part_with_feature( static_cast<int>( i++ % veh.part_count() ),
+                                          VPFLAG_ENGINE, false );
+        };
+        BENCHMARK( "refresh " + id.str() ) {
+            veh.refresh();
+            return veh.part_count();
+        };
+    }
+}
@@ -1,4 +1,6 @@
 #include <cstdlib>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -76,52 +78,88 @@ TEST_CASE( "vehicle power with reactor", "[vehicle][power]" )
     }
 }
 
-TEST_CASE( "power loss to cables", "[vehicle][power]" )
+static void connect_debug_cord( const tripoint &source, const tripoint &target )
 {
-    clear_vehicles();
-    reset_player();
-    build_test_map( ter_id( "t_pavement" ) );
     map &here = get_map();
+    const optional_vpart_position target_vp = here.veh_at( target );
+    const optional_vpart_position source_vp = here.veh_at( source );
+
+    item cord( "test_power_cord_25_loss" );
+    cord.set_var( "source_x", source.x );
+    cord.set_var( "source_y", source.y );
+    cord.set_var( "source_z", source.z );
+    cord.set_var( "state", "pay_out_cable" );
+    cord.active = true;
+
+    if( !target_vp ) {
+        debugmsg( "missing target at %s", target.to_string() );
+    }
+    vehicle *const target_veh = &target_vp->vehicle();
+    vehicle *const source_veh = &source_vp->vehicle();
+    if( source_veh == target_veh ) {
+        debugmsg( "source same as target" );
+    }
 
-    const auto connect_debug_cord = [&here]( const tripoint & source,
-    const tripoint & target ) {
-        const optional_vpart_position target_vp = here.veh_at( target );
-        const optional_vpart_position source_vp = here.veh_at( source );
+    tripoint target_global = here.getabs( target );
+    const vpart_id vpid( cord.typeId().str() );
+
+    point vcoords = source_vp->mount();
+    vehicle_part source_part( vpid, "", vcoords, item( cord ) );
+    source_part.target.first = target_global;
+    source_part.target.second = target_veh->global_square_location().raw();
+    source_veh->install_part( vcoords, source_part );
+
+    vcoords = target_vp->mount();
+    vehicle_part target_part( vpid, "", vcoords, item( cord ) );
+    tripoint source_global( cord.get_var( "source_x", 0 ),
+                            cord.get_var( "source_y", 0 ),
+                            cord.get_var( "source_z", 0 ) );
+    target_part.target.first = here.getabs( source_global );
+    target_part.target.second = source_veh->global_square_location().raw();
+    target_veh->install_part( vcoords, target_part );
+}
 
-        item cord( "test_power_cord_25_loss" );
-        cord.set_var( "source_x", source.x );
-        cord.set_var( "source_y", source.y );
-        cord.set_var( "source_z", source.z );
-        cord.set_var( "state", "pay_out_cable" );
-        cord.active = true;
+// places a battery "appliance" at each of the placements and chains them with power cords
+static std::vector<vehicle *> place_battery_chain( const std::vector<tripoint> &placements )
+{
+    map &here = get_map();
+    std::vector<vehicle *> vehicles;
+    for( const tripoint &p : placements ) {
+        REQUIRE( !here.veh_at( p ).has_value() );
+        vehicle *veh = here.add_vehicle( vehicle_prototype_none, p, 0_degrees, 0, 0 );
+        REQUIRE( veh != nullptr );
+        const int frame_part_idx = veh->install_part( point_zero, vpart_frame );
+        REQUIRE( frame_part_idx != -1 );
+        const int bat_part_idx = veh->install_part( point_zero, vpart_small_storage_battery );
+        REQUIRE( bat_part_idx != -1 );
+        veh->refresh();
+        here.add_vehicle_to_cache( veh );
+        vehicles.push_back( veh );
+    }
+    for( size_t i = 0; i + 1 < placements.size(); i++ ) {
+        connect_debug_cord( placements[i], placements[i + 1] );
+    }
+    return vehicles;
+}
 
-        if( !target_vp ) {
-            debugmsg( "missing target at %s", target.to_string() );
-        }
-        vehicle *const target_veh = &target_vp->vehicle();
-        vehicle *const source_veh = &source_vp->vehicle();
-        if( source_veh == target_veh ) {
-            debugmsg( "source same as target" );
-        }
+// snakes rows of 50 appliances across the map so consecutive placements stay close
+static std::vector<tripoint> battery_chain_placements( int count )
+{
+    std::vector<tripoint> placements;
+    for( int i = 0; i < count; i++ ) {
+        const int row = i / 50;
+        const int col = row % 2 == 0 ? i % 50 : 49 - i % 50;
+        placements.emplace_back( 4 + 2 * col, 10 + 4 * row, 0 );
+    }
+    return placements;
+}
 
-        tripoint target_global = here.getabs( target );
-        const vpart_id vpid( cord.typeId().str() );
-
-        point vcoords = source_vp->mount();
-        vehicle_part source_part( vpid, "", vcoords, item( cord ) );
-        source_part.target.first = target_global;
-        source_part.target.second = target_veh->global_square_location().raw();
-        source_veh->install_part( vcoords, source_part );
-
-        vcoords = target_vp->mount();
-        vehicle_part target_part( vpid, "", vcoords, item( cord ) );
-        tripoint source_global( cord.get_var( "source_x", 0 ),
-                                cord.get_var( "source_y", 0 ),
-                                cord.get_var( "source_z", 0 ) );
-        target_part.target.first = here.getabs( source_global );
-        target_part.target.second = source_veh->global_square_location().raw();
-        target_veh->install_part( vcoords, target_part );
-    };
+TEST_CASE( "power loss to cables", "[vehicle][power]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    map &here = get_map();
 
     const std::vector<tripoint> placements { { 4, 10, 0 }, { 6, 10, 0 }, { 8, 10, 0 } };
     std::vector<vpart_reference> batteries;
@@ -170,6 +208,91 @@ TEST_CASE( "power loss to cables", "[vehicle][power]" )
     }
 }
 
+TEST_CASE( "power grid cache of linked appliances", "[vehicle][power]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    map &here = get_map();
+
+    const int num_appliances = 55;
+    const std::vector<vehicle *> vehicles =
+        place_battery_chain( battery_chain_placements( num_appliances ) );
+    vehicle &first = *vehicles.front();
+
+    const vehicle_power_grid &grid = first.power_grid();
+    REQUIRE( grid.vehicles.size() == static_cast<size_t>( num_appliances ) );
+    REQUIRE( grid.batteries.size() == static_cast<size_t>( num_appliances ) );
+    CHECK( grid.total_capacity == first.fuel_capacity( fuel_type_battery ) );
+    CHECK( grid.total_capacity > 0 );
+
+    const std::map<vehicle *, float> searched = first.search_connected_vehicles();
+    for( const std::pair<vehicle *, float> &pair : grid.vehicles ) {
+        CAPTURE( pair.second );
+        REQUIRE( searched.count( pair.first ) == 1 );
+        CHECK( searched.at( pair.first ) == Approx( pair.second ) );
+    }
+
+    SECTION( "the grid is reused until a vehicle in it changes" ) {
+        CHECK( first.has_cached_power_grid() );
+        first.charge_battery( 1000, false );
+        CHECK( first.battery_left( false ) == 1000 );
+        CHECK( first.has_cached_power_grid() );
+        vehicles[30]->refresh();
+        CHECK_FALSE( first.has_cached_power_grid() );
+        CHECK( first.power_grid().vehicles.size() == static_cast<size_t>( num_appliances ) );
+        CHECK( first.has_cached_power_grid() );
+    }
+
+    SECTION( "changes to other grids keep the grid" ) {
+        const std::vector<vehicle *> others =
+            place_battery_chain( { tripoint( 4, 100, 0 ), tripoint( 6, 100, 0 ) } );
+        CHECK( others.front()->power_grid().vehicles.size() == 2 );
+        // placing them already refreshed vehicles, but none of the first grid
+        CHECK( first.has_cached_power_grid() );
+        others.back()->refresh();
+        CHECK_FALSE( others.front()->has_cached_power_grid() );
+        CHECK( first.has_cached_power_grid() );
+        here.destroy_vehicle( others.back() );
+        CHECK( others.front()->power_grid().vehicles.size() == 1 );
+        CHECK( first.has_cached_power_grid() );
+    }
+
+    SECTION( "destroying an appliance splits the grid" ) {
+        here.destroy_vehicle( vehicles[10] );
+        CHECK( first.power_grid().vehicles.size() == 10 );
+        CHECK( first.power_grid().batteries.size() == 10 );
+    }
+}
+
+TEST_CASE( "power_grid_benchmark", "[.][vehicle][power][benchmark]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+
+    const std::vector<vehicle *> vehicles = place_battery_chain( battery_chain_placements( 120 ) );
+    vehicle &first = *vehicles.front();
+    first.charge_battery( 10000 );
+
+    BENCHMARK( "uncached search_connected_vehicles" ) {
+        return first.search_connected_vehicles().size();
+    };
+    BENCHMARK( "cached connected_battery_power_level" ) {
+        return first.connected_battery_power_level().first;
+    };
+    BENCHMARK( "charge and discharge" ) {
+        first.charge_battery( 100 );
+        return first.discharge_battery( 100 );
+    };
+    BENCHMARK( "power_parts of all appliances" ) {
+        for( vehicle *veh : vehicles ) {
+            veh->power_parts();
+        }
+        return first.battery_left();
+    };
+}
+
 TEST_CASE( "Solar power", "[vehicle][power]" )
 {
     clear_vehicles();
@@ -1,9 +1,13 @@
 #include <optional>
+#include <set>
 #include <vector>
 
 #include "avatar.h"
 #include "cata_catch.h"
 #include "character.h"
+#include "coordinates.h"
+#include "creature_tracker.h"
+#include "cuboid_rectangle.h"
 #include "damage.h"
 #include "enums.h"
 #include "item.h"
@@ -732,3 +736,68 @@ TEST_CASE( "Racking and unracking tests", "[vehicle][bikerack]" )
 
     clear_vehicles( &get_map() );
 }
+
+static vehicle *spawn_moving_car( const tripoint &pos, int velocity )
+{
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_car, pos, 0_degrees, 100, 0 );
+    REQUIRE( veh != nullptr );
+    veh->tags.insert( "IN_CONTROL_OVERRIDE" );
+    veh->engine_on = velocity != 0;
+    veh->cruise_velocity = velocity;
+    veh->velocity = velocity;
+    return veh;
+}
+
+TEST_CASE( "vehicle_collision_broad_phase", "[vehicle][collision]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+
+    vehicle *moving = spawn_moving_car( tripoint( 30, 60, 0 ), 10 * 100 );
+    vehicle *parked = spawn_moving_car( tripoint( 50, 60, 0 ), 0 );
+    const inclusive_cuboid<tripoint> &parked_bounds = parked->get_points_bounds();
+
+    for( const tripoint &p : parked->get_points() ) {
+        CHECK( parked_bounds.contains( p ) );
+    }
+    CHECK( here.other_vehicle_within( *moving, parked_bounds ) );
+    CHECK_FALSE( here.other_vehicle_within( *parked, parked_bounds ) );
+    CHECK_FALSE( here.other_vehicle_within( *moving, inclusive_cuboid<tripoint>(
+                     tripoint( 90, 90, 0 ), tripoint( 100, 100, 0 ) ) ) );
+    CHECK_FALSE( get_creature_tracker().character_within( inclusive_cuboid<tripoint_abs_ms>(
+                     here.getglobal( parked_bounds.p_min ), here.getglobal( parked_bounds.p_max ) ),
+                 false ) );
+
+    // driving into the parked car must still collide instead of passing through it
+    for( int turn = 0; turn < 10 && moving->velocity > 0; turn++ ) {
+        here.vehmove();
+    }
+    const std::set<tripoint> &moving_points = moving->get_points( true );
+    for( const tripoint &p : parked->get_points( true ) ) {
+        CHECK( moving_points.count( p ) == 0 );
+    }
+}
+
+TEST_CASE( "vehicle_convoy_benchmark", "[.][vehicle][collision][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+
+    // two lanes of cars driving east in a column, none of them ever meet
+    const auto spawn_convoy = [&here]() {
+        clear_vehicles( &here );
+        for( int lane = 0; lane < 2; lane++ ) {
+            for( int i = 0; i < 6; i++ ) {
+                spawn_moving_car( tripoint( 10 + 10 * i, 40 + 20 * lane, 0 ), 10 * 100 );
+            }
+        }
+    };
+
+    BENCHMARK_ADVANCED( "convoy vehmove" )( Catch::Benchmark::Chronometer meter ) {
+        spawn_convoy();
+        meter.measure( [&here] {
+            here.vehmove();
+        } );
+    };
+}
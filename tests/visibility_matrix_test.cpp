@@ -0,0 +1,84 @@
+#include "avatar.h"
+#include "cata_catch.h"
+#include "creature_tracker.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "visibility_matrix.h"
+
+static const efftype_id effect_no_sight( "no_sight" );
+
+TEST_CASE( "visibility_matrix_matches_sees", "[vision][monster]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    map &here = get_map();
+    avatar &you = get_avatar();
+    creature_tracker &creatures = get_creature_tracker();
+    here.build_map_cache( you.posz() );
+
+    monster &near = spawn_test_monster( "mon_zombie", you.pos() + tripoint( 3, 0, 0 ) );
+    monster &behind_wall = spawn_test_monster( "mon_zombie", you.pos() + tripoint( 0, 6, 0 ) );
+    for( int x = -2; x <= 2; x++ ) {
+        here.ter_set( you.pos() + tripoint( x, 3, 0 ), ter_id( "t_wall" ) );
+    }
+    here.build_map_cache( you.posz() );
+    creatures.reset_visibility();
+    visibility_matrix &visibility = creatures.visibility();
+
+    CHECK( visibility.sees( near, you ) == near.sees( you ) );
+    CHECK( visibility.sees( behind_wall, you ) == behind_wall.sees( you ) );
+    CHECK( visibility.sees( near, behind_wall ) == near.sees( behind_wall ) );
+    CHECK( visibility.turn_counters().computed == 3 );
+
+    // asking again is answered from the matrix
+    CHECK( visibility.sees( near, you ) == near.sees( you ) );
+    CHECK( visibility.sees( behind_wall, you ) == behind_wall.sees( you ) );
+    CHECK( visibility.turn_counters().reused == 2 );
+
+    // creatures that moved are checked directly
+    near.setpos( near.pos() + tripoint_east );
+    CHECK( visibility.sees( near, you ) == near.sees( you ) );
+    CHECK( visibility.turn_counters().untracked == 1 );
+
+    creatures.reset_visibility();
+    CHECK( visibility.turn_counters().reused == 0 );
+}
+
+TEST_CASE( "visibility_matrix_follows_changes_within_the_turn", "[vision][monster]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    map &here = get_map();
+    avatar &you = get_avatar();
+    creature_tracker &creatures = get_creature_tracker();
+
+    monster &near = spawn_test_monster( "mon_zombie", you.pos() + tripoint( 3, 0, 0 ) );
+    here.build_map_cache( you.posz() );
+    creatures.reset_visibility();
+    visibility_matrix &visibility = creatures.visibility();
+    REQUIRE( visibility.sees( near, you ) );
+
+    SECTION( "effects gained during the turn" ) {
+        near.add_effect( effect_no_sight, 1_hours );
+        CHECK_FALSE( visibility.sees( near, you ) );
+        CHECK( visibility.turn_counters().computed == 2 );
+        near.remove_effect( effect_no_sight );
+        CHECK( visibility.sees( near, you ) );
+        CHECK( visibility.turn_counters().computed == 3 );
+    }
+
+    SECTION( "another creature in the same place in memory" ) {
+        const monster other( near );
+        CHECK( other.get_serial() != near.get_serial() );
+        const int64_t serial = near.get_serial();
+        near = other;
+        CHECK( near.get_serial() != serial );
+        CHECK( visibility.sees( near, you ) );
+        CHECK( visibility.turn_counters().untracked == 1 );
+    }
+}